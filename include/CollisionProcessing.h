@@ -31,6 +31,7 @@
 #define MCK_COLL_PROC_H
 
 #include"CollisionEvent.h"
+#include"GameEngProfiler.h"
 #include"CollisionNode.h"
 #include"QuadTree.h"
 #include"SpriteCollisionBase.h"
@@ -256,6 +257,10 @@ class CollisionProcessing
             std::vector<MCK::CollisionEvent> &collisions
         )
         {
+#if defined MCK_PROFILE
+            MCK::GameEngProfiler::Zone zone( "CollisionProcessing::process" );
+#endif
+
             collisions.clear();
 
             // DEBUG OPTION
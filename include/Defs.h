@@ -64,6 +64,9 @@ namespace MCK
     //! Ceiling/invalid value for local palette ids
     const MCK_IMG_ID_TYPE INVALID_PAL_ID = 0xFFFFFFFF;
 
+    //! Local palette id used in texture ids of palette-indexed textures
+    const MCK_PAL_ID_TYPE INDEXED_PAL_ID = 0xFFFFFFFE;
+
     //! Ceiling/invalid value for texture ids
     const MCK_TEX_ID_TYPE INVALID_TEX_ID = 0xFFFFFFFFFFFFFFFF;
 
@@ -237,7 +240,8 @@ namespace MCK
     {
         BASE,
         INFO,
-        BLOCK
+        BLOCK,
+        TILE_MAP
     };
 
     //! Provides reflection to Bezier curve instances
@@ -47,16 +47,27 @@
 #include <iostream> // For std::cout
 #endif
 
+#include <algorithm>  // For fill
 #include <cmath>  // For ceil
+#include <cstring>  // For memcpy
 #include <stdexcept>  // For exceptions
 #include <limits>  // For numeric_limits, size of data type in bits
 #include <list>  // For list
 #include <map>  // For map
 #include <memory>  // For shared_ptr
+#include <utility>  // For swap
 
 #include "Defs.h"
 #include "GameEngRenderBlock.h"
 #include "GameEngRenderInfo.h"
+#include "GameEngTileMap.h"
+#include "GameEngProfiler.h"
+#include "GameEngRenderList.h"
+#include "GameEngTextureAtlas.h"
+#include "GameEngTextureTable.h"
+#include "GameEngTripleBuffer.h"
+#include "GameEngPool.h"
+#include "GameEngPixelDecoder.h"
 #include "KeyEvent.h"
 #include "Version.h"
 
@@ -100,12 +111,51 @@ class GameEng
             uint16_t _window_height_in_pixels
         );
 
+        //! Initialize game engine without a window
+        /*! @param _frame_width_in_pixels: Frame width
+         *  @param _frame_height_in_pixels: Frame height
+         *  Frames are drawn by SDL2's software renderer onto
+         *  a surface held in memory, so no display (or GPU)
+         *  is needed, and 'show' does not wait for vsync.
+         *  This is intended for automated tests and
+         *  benchmarks. Each frame can be read back, once
+         *  shown, with 'get_frame_surface' or 'read_frame_pixels'.
+         */
+        void init_headless(
+            uint16_t _frame_width_in_pixels,
+            uint16_t _frame_height_in_pixels
+        );
+
         //! Returns true if game engine is initialized
         bool is_initialized( void ) const noexcept
         {
             return this->initialized;
         }
 
+        //! Returns true if game engine was initialized without a window
+        bool is_headless( void ) const noexcept
+        {
+            return this->headless;
+        }
+
+        //! Get surface holding most recently shown frame (headless only)
+        /*! @returns Surface (pixel format ARGB8888), or NULL if not headless
+         *  Note: Surface is owned by game engine
+         */
+        const SDL_Surface* get_frame_surface( void ) const noexcept
+        {
+            return this->frame_surface;
+        }
+
+        //! Read pixels of current frame
+        /*! @param pixels: Resulting pixels (ARGB8888), row by row
+         *  Works with or without a window, but is slow
+         *  for a window, as pixels are read back from the GPU.
+         *  Note: Call after 'show', as retained frame is
+         *        not composited until then.
+         */
+        void read_frame_pixels( std::vector<uint32_t> &pixels ) const;
+
         // //! Create texture
         // /*! @param image_id: Arbitrary ID associated with image data
         //  *  @param local_palette_id: Arbitrary ID associated with palette
@@ -138,6 +188,10 @@ class GameEng
          *  @param local_palette: Vector of colo(u)r IDs
          *  @param tex_id: Resulting texture id
          *  @param height_in_pixels: Resulting image height (for quality checks)
+         *  @param throw_if_exists: If true, throw if texture already exists
+         *  @param streaming: If true, texture can be changed
+         *      later with 'update_texture' (it is never held in
+         *      the texture atlas)
          */
         void create_texture(
             MCK_IMG_ID_TYPE image_id,
@@ -148,13 +202,128 @@ class GameEng
             const std::vector<uint8_t> &local_palette,
             MCK_TEX_ID_TYPE &tex_id,
             uint16_t &height_in_pixels,
-            bool throw_if_exists = false
+            bool throw_if_exists = false,
+            bool streaming = false
+        );
+
+        //! Decode image into 32bit pixels, for 'create_texture_from_pixels'
+        /*! @param bits_per_pixel: Number of bits in palette ID
+         *  @param pitch in pixels: Width of image in pixels 
+         *  @param pixel_data: Pixel bits, packed sequentially into bytes
+         *  @param local_palette: Vector of colo(u)r IDs
+         *  @param pixels: Resulting pixels, in texture format
+         *  @param height_in_pixels: Resulting image height
+         *  Unlike the rest of GameEng, this may be called from
+         *  any thread (once initialized), so that images can be
+         *  decoded in parallel before their textures are needed.
+         */
+        void decode_image(
+            uint8_t bits_per_pixel,
+            uint16_t pitch_in_pixels,
+            const std::vector<uint8_t> &pixel_data,
+            const std::vector<uint8_t> &local_palette,
+            std::vector<uint32_t> &pixels,
+            uint16_t &height_in_pixels
+        ) const;
+
+        //! Create texture from pixels already decoded by 'decode_image'
+        /*! @param image_id: Arbitrary ID associated with image data
+         *  @param local_palette_id: Arbitrary ID associated with palette
+         *  @param pitch in pixels: Width of image in pixels 
+         *  @param height_in_pixels: Height of image in pixels 
+         *  @param pixels: Pixels from 'decode_image'
+         *  @param tex_id: Resulting texture id
+         *  @param streaming: If true, texture can be overwritten by 'update_texture'
+         *  If texture already exists, nothing is done.
+         */
+        void create_texture_from_pixels(
+            MCK_IMG_ID_TYPE image_id,
+            MCK_PAL_ID_TYPE local_palette_id,
+            uint16_t pitch_in_pixels,
+            uint16_t height_in_pixels,
+            const std::vector<uint32_t> &pixels,
+            MCK_TEX_ID_TYPE &tex_id,
+            bool streaming = false
+        );
+
+        //! Overwrite streaming texture with new image data and/or palette
+        /*! @param tex_id: ID of texture (created with 'streaming' true)
+         *  @param bits_per_pixel: Number of bits in palette ID
+         *  @param pitch in pixels: Width of image in pixels (must match texture)
+         *  @param pixel_data: Pixel bits, packed sequentially into bytes
+         *  @param local_palette: Vector of colo(u)r IDs
+         *  Image size must match that of the texture. This is
+         *  intended for images that are re-palettised often,
+         *  as no texture is created or destroyed.
+         *  Note: Texture ID is unchanged, so still refers to
+         *        the original local palette ID.
+         */
+        void update_texture(
+            MCK_TEX_ID_TYPE tex_id,
+            uint8_t bits_per_pixel,
+            uint16_t pitch_in_pixels,
+            const std::vector<uint8_t> &pixel_data,
+            const std::vector<uint8_t> &local_palette
+        );
+
+        //! Create palette-indexed texture, for palette swapping
+        /*! @param image_id: Arbitrary ID associated with image data
+         *  @param bits_per_pixel: Number of bits in palette ID
+         *  @param pitch in pixels: Width of image in pixels 
+         *  @param pixel_data: Pixel bits, packed sequentially into bytes
+         *  @param tex_id: Resulting texture id
+         *  @param height_in_pixels: Resulting image height
+         *  The texture holds one white mask (layer) for each
+         *  palette index used by the image, stacked vertically,
+         *  so it is created once per image, whatever palettes
+         *  are used. Palettes are applied when rendered, by
+         *  colo(u)r modulation (see 'create_indexed_render_block').
+         *  Each layer is drawn separately, so this is best
+         *  suited to images using only a few colo(u)rs.
+         *  If texture already exists, nothing is done.
+         */
+        void create_indexed_texture(
+            MCK_IMG_ID_TYPE image_id,
+            uint8_t bits_per_pixel,
+            uint16_t pitch_in_pixels,
+            const std::vector<uint8_t> &pixel_data,
+            MCK_TEX_ID_TYPE &tex_id,
+            uint16_t &height_in_pixels
         );
 
+        //! Create render block that draws palette-indexed texture with a local palette
+        /*! @param tex_id: ID of texture created by 'create_indexed_texture'
+         *  @param local_palette: Vector of colo(u)r IDs
+         *  @param parent_block: Block to attach new block to
+         *  @param dest_rect: Window pixel coordinates
+         *  @param z: Z value of new block
+         *  The new block holds one render info per layer, and
+         *  its offsets are set to the position of 'dest_rect',
+         *  so the image is moved by changing the offsets.
+         */
+        std::shared_ptr<MCK::GameEngRenderBlock> create_indexed_render_block(
+            MCK_TEX_ID_TYPE tex_id,
+            const std::vector<uint8_t> &local_palette,
+            std::shared_ptr<MCK::GameEngRenderBlock> parent_block,
+            MCK::GameEngRenderInfo::Rect dest_rect,
+            uint32_t z = MCK::DEFAULT_Z_VALUE
+        ) const;
+
+        //! Change local palette of block created by 'create_indexed_render_block'
+        /*! @param block: Block created by 'create_indexed_render_block'
+         *  @param local_palette: Vector of colo(u)r IDs
+         *  No textures are created, so this is cheap enough
+         *  to call every frame (e.g. for flashing images).
+         */
+        void change_indexed_render_block_palette(
+            std::shared_ptr<MCK::GameEngRenderBlock> block,
+            const std::vector<uint8_t> &local_palette
+        ) const;
+
         //! Returns true if texture with this ID already exists
         bool texture_exists( MCK_TEX_ID_TYPE tex_id ) const
         {
-            return textures.find( tex_id ) != textures.end();
+            return this->textures.contains( tex_id );
         }
         
         //! Create empty render block
@@ -203,6 +372,45 @@ class GameEng
             uint32_t z = MCK::DEFAULT_Z_VALUE
         ) const;
 
+        //! Create tile map, with all cells empty
+        /*! @param parent_block: Block to which map is to be attached
+         *  @param x: Position of left edge of map, in game window pixels
+         *  @param y: Position of top edge of map, in game window pixels
+         *  @param width_in_cells: Width of map, in cells
+         *  @param height_in_cells: Height of map, in cells
+         *  @param cell_width: Width of each cell, in pixels
+         *  @param cell_height: Height of each cell, in pixels
+         *  Use 'set_tile_map_tile' to give the map its tile
+         *  set, then GameEngTileMap::set_cell to fill it in.
+         *  Only cells within the game window are drawn.
+         */
+        std::shared_ptr<MCK::GameEngTileMap> create_tile_map(
+            std::shared_ptr<MCK::GameEngRenderBlock> parent_block,
+            int x,
+            int y,
+            uint16_t width_in_cells,
+            uint16_t height_in_cells,
+            uint16_t cell_width,
+            uint16_t cell_height,
+            uint32_t z = MCK::DEFAULT_Z_VALUE
+        ) const;
+
+        //! Set texture of a tile number in tile map's tile set
+        /*! @param tile_map: Pointer to tile map
+         *  @param tile: Tile number (the tile set grows to include it)
+         *  @param tex_id: ID of (an existing) texture
+         *  The map holds a reference to the texture, so the
+         *  texture is not evicted while the map uses it.
+         *  Note: ImageMan::change_render_info_tex (with a NULL
+         *        info) can be used to create the texture of
+         *        an image and palette beforehand.
+         */
+        void set_tile_map_tile(
+            std::shared_ptr<MCK::GameEngTileMap> tile_map,
+            uint16_t tile,
+            MCK_TEX_ID_TYPE tex_id
+        ) const;
+
         //! Change texture of render info object
         /*! @param info: Pointer to render info object
          *  @param new_tex_id: ID of the new texture
@@ -212,6 +420,73 @@ class GameEng
             MCK_TEX_ID_TYPE new_tex_id
         ) const;
 
+        //! Resolve texture in advance, for fast texture changes
+        /*! @param tex_id: ID of (an existing) texture
+         *  @param handle: Handle to be set (any texture it holds is released first)
+         *  The handle holds a reference to the texture, so the
+         *  texture is not evicted until 'release_tex_handle'
+         *  is called. Meanwhile, 'set_render_info_tex_handle'
+         *  can change a render info's texture without any look up.
+         */
+        void acquire_tex_handle(
+            MCK_TEX_ID_TYPE tex_id,
+            MCK::GameEngRenderInfo::TexHandle &handle
+        ) const;
+
+        //! Release reference held by texture handle
+        /*! Static, so it is safe to call after GameEng has
+         *  been destroyed (e.g. during exit), in which case
+         *  it does nothing.
+         */
+        static void release_tex_handle(
+            MCK::GameEngRenderInfo::TexHandle &handle
+        ) noexcept
+        {
+            MCK::GameEngRenderInfo::TexReleaseFunc const RELEASE
+                = MCK::GameEngRenderInfo::tex_release_func();
+            if( handle.tex_id != MCK::INVALID_TEX_ID && RELEASE != NULL )
+            {
+                RELEASE( handle.tex_id );
+            }
+            handle = MCK::GameEngRenderInfo::TexHandle();
+        }
+
+        //! Change texture of render info to one resolved in advance
+        /*! @param info: Render info object
+         *  @param handle: Texture handle (see 'acquire_tex_handle')
+         *  This is just a pointer swap, as the texture needs no
+         *  look up, and the render info does not count itself as
+         *  a user of the texture. So the caller must keep the
+         *  handle until the render info has another texture,
+         *  or until 'hold_render_info_tex' has been called.
+         */
+        void set_render_info_tex_handle(
+            MCK::GameEngRenderInfo &info,
+            const MCK::GameEngRenderInfo::TexHandle &handle
+        ) const noexcept
+        {
+            // Handle's reference stands in for info's own
+            if( info.tex_ref )
+            {
+                this->release_tex( info.tex_id );
+                info.tex_ref = false;
+            }
+
+            info.tex = handle.tex;
+            info.tex_id = handle.tex_id;
+            info.in_atlas = handle.in_atlas;
+            info.atlas_rect = handle.atlas_rect;
+            info.content_changed();
+        }
+
+        //! Make render info count itself as a user of its texture again
+        /*! @param info: Render info object
+         *  Call this before releasing the handle of the render
+         *  info's current texture (see 'set_render_info_tex_handle'),
+         *  so that the texture is not evicted while in use.
+         */
+        void hold_render_info_tex( MCK::GameEngRenderInfo &info ) const;
+
         //! Render specified render block (and all sub blocks)
         /*! @param render_block: Highest block to be rendered, e.g. prime_render_block
          *  @param hoz_offset: Horizonal offset, in pixels
@@ -228,6 +503,318 @@ class GameEng
             int16_t vert_offset = 0
         ) const;
 
+        //! Publish snapshot of render block (and all sub blocks), for rendering by another thread
+        /*! @param render_block: Highest block to be rendered, e.g. prime_render_block
+         *  @param hoz_offset: Horizonal offset, in pixels
+         *  @param hoz_offset: Vertical offset, in pixels
+         *  The block tree is compiled (as per 'set_compiled_render_list')
+         *  into a list of draw commands, which is handed to
+         *  'render_snapshot' through a lock-free triple buffer.
+         *  This allows game logic for the next frame to run on
+         *  one thread, while another renders the previous frame
+         *  (and waits for vsync in 'show').
+         *  As SDL requires, the thread that initialized GameEng
+         *  should handle events and call 'clear', 'render_snapshot'
+         *  and 'show', while another thread (see SDL_CreateThread)
+         *  runs game logic and then calls this method in place
+         *  of 'render_all'.
+         *  Note: Only one thread may publish snapshots.
+         *  Note: Snapshots hold textures by pointer, so whilst
+         *        they are in use no texture may be created,
+         *        updated or evicted, except by the rendering thread
+         *        while the publishing thread is paused. Create all
+         *        textures in advance (e.g. with ImageMan::prewarm,
+         *        and sprite frames with SpriteAnimTime::set_frames).
+         *  Note: Throws if the retained frame is enabled (see
+         *        'set_retained_frame'), as 'show' would copy it
+         *        over the snapshot.
+         */
+        void publish_render_snapshot(
+            std::shared_ptr<MCK::GameEngRenderBlock> render_block, 
+            int16_t hoz_offset = 0,
+            int16_t vert_offset = 0
+        ) const;
+
+        //! Render most recently published snapshot (see 'publish_render_snapshot')
+        /*! @returns True if snapshot is new, false if the previous snapshot was rendered again
+         *  Called in place of 'render_all', by the thread that
+         *  initialized GameEng. This never waits for a snapshot,
+         *  so frames are repeated (or skipped) if game logic is
+         *  slower (or faster) than rendering.
+         *  Note: Throws if the retained frame is enabled.
+         */
+        bool render_snapshot( void ) const;
+
+        //! Enable or disable the compiled render list
+        /*! @param val: If true, 'render_all' uses a compiled render list
+         *  When enabled, 'render_all' flattens the render block
+         *  tree into contiguous arrays and renders them in a
+         *  single linear pass. Blocks are only re-compiled when
+         *  their contents change (i.e. when render instances are
+         *  added, removed, moved or have their 'z' changed),
+         *  whilst block offsets and 'active' flags are re-read
+         *  every frame.
+         *  Each draw command is kept until its block's contents,
+         *  offsets or visibility change, so the draw commands
+         *  of unchanged blocks are not regenerated, and a frame
+         *  in which nothing has changed costs one check per
+         *  block. Render infos and tile maps notify their block
+         *  of changes, except for direct changes to a render
+         *  info's public 'clip' and 'color_mod' (use 'set_clip'
+         *  and 'set_color_mod' instead).
+         *  Note: Only one tree is compiled at a time. Calling
+         *        'render_all' with a different top-level block
+         *        from the previous call discards the compiled
+         *        list and compiles the new tree from scratch, so
+         *        rendering several trees per frame (rather than
+         *        placing them in one parent block) re-compiles
+         *        every tree every frame.
+         *  Note: Batched rendering, sub-pixel rendering and the
+         *        retained frame all work on the compiled render
+         *        list, so disabling it disables them too (and
+         *        releases the retained frame's texture).
+         */
+        void set_compiled_render_list( bool val ) noexcept
+        {
+            this->use_compiled_render_list = val;
+            if( !val )
+            {
+                this->render_list.clear();
+                this->use_batched_render = false;
+                this->release_retained_frame();
+                this->use_sub_pixel_render = false;
+            }
+        }
+
+        //! Returns true if 'render_all' uses a compiled render list
+        bool get_compiled_render_list( void ) const noexcept
+        {
+            return this->use_compiled_render_list;
+        }
+
+        //! Enable or disable batched rendering
+        /*! @param val: If true, consecutive draws from the same texture are batched
+         *  When enabled, each run of consecutive render infos
+         *  sharing a texture is submitted to SDL as a single
+         *  SDL_RenderGeometry call, with rotation and flip
+         *  encoded in the texture co-ordinates.
+         *  Note: Batching works on the compiled render list,
+         *        so enabling it also enables the compiled
+         *        render list.
+         *  Note: Requires SDL 2.0.18 or later, otherwise
+         *        this has no effect.
+         */
+        void set_batched_render( bool val ) noexcept
+        {
+            this->use_batched_render = val;
+            if( val )
+            {
+                this->use_compiled_render_list = true;
+            }
+        }
+
+        //! Returns true if 'render_all' uses batched rendering
+        bool get_batched_render( void ) const noexcept
+        {
+            return this->use_batched_render;
+        }
+
+        //! Enable or disable sub-pixel rendering
+        /*! @param val: If true, block offsets may include fractions of a pixel
+         *  When enabled, the 'hoz_sub_offset' and 'vert_sub_offset'
+         *  of each render block (see GameEngRenderBlock::set_pos_f)
+         *  are added to its cumulative offset, and images are
+         *  drawn with SDL_RenderCopyF and SDL_RenderCopyExF (or
+         *  SDL_RenderGeometry, if batched). This lets slowly
+         *  scrolling layers move smoothly, rather than in steps
+         *  of a whole pixel, with renderers that filter textures
+         *  (see SDL_HINT_RENDER_SCALE_QUALITY).
+         *  When disabled (the default), fractions are ignored
+         *  and images are drawn exactly as before, with integer
+         *  co-ordinates.
+         *  Note: This works on the compiled render list, so
+         *        enabling it also enables the compiled
+         *        render list.
+         *  Note: Requires SDL 2.0.10 or later, otherwise
+         *        this has no effect.
+         */
+        void set_sub_pixel_render( bool val ) noexcept
+        {
+#if SDL_VERSION_ATLEAST(2,0,10)
+            if( val != this->use_sub_pixel_render )
+            {
+                this->render_list.invalidate_items();
+            }
+            this->use_sub_pixel_render = val;
+            if( val )
+            {
+                this->use_compiled_render_list = true;
+            }
+#endif
+        }
+
+        //! Returns true if 'render_all' uses sub-pixel rendering
+        bool get_sub_pixel_render( void ) const noexcept
+        {
+            return this->use_sub_pixel_render;
+        }
+
+        //! Enable or disable retained frame rendering
+        /*! @param val: If true, 'render_all' only redraws areas that have changed
+         *  When enabled, 'render_all' draws into a persistent
+         *  texture the size of the game window, which 'show'
+         *  then copies to the window. Each frame, the draw
+         *  commands of the compiled render list are compared
+         *  with those of the previous frame, so only areas
+         *  where an image has moved, changed texture, changed
+         *  'z' or been added or removed are erased and redrawn.
+         *  Only blocks whose contents, offsets or visibility
+         *  have changed are compared, so a frame in which
+         *  nothing has changed costs one check per block, plus
+         *  the copy of the retained frame in 'show'.
+         *  This suits mostly static scenes (e.g. consoles and
+         *  HUD overlays).
+         *  Note: Retained frames work on the compiled render
+         *        list, so enabling this also enables the
+         *        compiled render list.
+         *  Note: Only one block tree may be rendered per frame,
+         *        and 'clear' has no effect.
+         *  Note: Render snapshots cannot be used while this is
+         *        enabled (see 'publish_render_snapshot').
+         *  Note: Re-compiling a block redraws the area of all
+         *        its images (and those of its sub-blocks), so
+         *        instances that are frequently created or
+         *        destroyed are best kept in their own block.
+         *  Note: Changes to the *contents* of textures are not
+         *        detected, see 'invalidate_retained_frame'.
+         *  Note: Disabling this (or the compiled render list)
+         *        releases the retained frame's texture.
+         */
+        void set_retained_frame( bool val );
+
+        //! Returns true if 'render_all' uses a retained frame
+        bool get_retained_frame( void ) const noexcept
+        {
+            return this->use_retained_frame;
+        }
+
+        //! Redraw whole retained frame when 'render_all' is next called
+        /*! Call this after changing the contents of a texture
+         *  in use, or after changing the clearing colo(u)r.
+         */
+        void invalidate_retained_frame( void ) const noexcept
+        {
+            this->render_list.full_redraw = true;
+        }
+
+        //! Enable or disable culling of off-screen images
+        /*! @param val: If true, images outside the game window are not submitted to SDL
+         *  When enabled (disabled by default), 'render_all' skips any
+         *  render block whose images all lie outside the game
+         *  window, using a bounding rectangle that each block
+         *  recalculates only after its contents have changed.
+         *  Remaining images are tested individually.
+         *  Note: Every active sub-block is still visited, and
+         *        tested against its own bounding rectangle,
+         *        even when its parent is off screen. Block
+         *        offsets ('hoz_offset' and 'vert_offset') are
+         *        public, so may change without the block's
+         *        parent being told, and a bounding rectangle
+         *        for a whole sub-tree could not be kept up to
+         *        date. Culling therefore saves the cost of
+         *        each off-screen image, but not the (much
+         *        smaller) cost of visiting each block.
+         */
+        void set_culling( bool val ) noexcept
+        {
+            if( val != this->use_culling )
+            {
+                this->render_list.invalidate_items();
+            }
+            this->use_culling = val;
+        }
+
+        //! Returns true if 'render_all' culls off-screen images
+        bool get_culling( void ) const noexcept
+        {
+            return this->use_culling;
+        }
+
+        //! Enable (or disable) texture atlas for small images
+        /*! @param page_size_in_pixels: Width and height of each atlas texture (zero to disable)
+         *  @param max_pages: Maximum number of atlas textures
+         *  @param max_image_size_in_pixels: Larger images are given their own texture
+         *  Once enabled, 'create_texture' packs small images
+         *  into a few large atlas textures, so that render
+         *  infos using them share a texture (allowing them to
+         *  be batched, see 'set_batched_render').
+         *  When all pages are full, any page holding no image
+         *  used by a render info is evicted and re-used.
+         *  If no page can be evicted, the image is given its
+         *  own texture instead.
+         *  Note: Only affects textures created after this call.
+         */
+        void set_texture_atlas(
+            uint16_t page_size_in_pixels,
+            uint16_t max_pages = 4,
+            uint16_t max_image_size_in_pixels = 64
+        ) noexcept
+        {
+            this->atlas.init( page_size_in_pixels, max_pages );
+            this->atlas_max_image_size = max_image_size_in_pixels;
+        }
+
+        //! Get texture atlas (read only)
+        const MCK::GameEngTextureAtlas& get_texture_atlas( void ) const noexcept
+        {
+            return this->atlas;
+        }
+
+        //! Set budget for textures (excluding atlas pages)
+        /*! @param max_bytes: Maximum memory used by textures (zero for no limit)
+         *  @param max_textures: Maximum number of textures (zero for no limit)
+         *  GameEng counts the render infos using each texture.
+         *  When creating a texture would exceed the budget,
+         *  textures used by no render info are destroyed,
+         *  least recently used first, until there is room.
+         *  Evicted textures no longer exist (see 'texture_exists'),
+         *  so ImageMan re-creates them when they are next needed.
+         *  The budget may still be exceeded if every texture
+         *  is in use.
+         *  Note: Memory is estimated as 4 bytes per pixel.
+         *  Note: Textures created but not yet used by any
+         *        render info (e.g. by ImageMan::prewarm) may be
+         *        evicted, so prewarm no more than fits the budget.
+         */
+        void set_texture_budget(
+            size_t max_bytes,
+            size_t max_textures = 0
+        );
+
+        //! Get memory used by textures (excluding atlas pages), in bytes
+        size_t get_texture_bytes( void ) const noexcept
+        {
+            return this->texture_bytes;
+        }
+
+        //! Get number of textures (excluding atlas pages)
+        size_t get_num_textures( void ) const noexcept
+        {
+            return this->num_separate_textures;
+        }
+
+        //! Get number of textures evicted to keep within budget, since init
+        size_t get_num_evicted_textures( void ) const noexcept
+        {
+            return this->num_evicted_textures;
+        }
+
+        //! Get compiled render list (read only)
+        const MCK::GameEngRenderList& get_render_list( void ) const noexcept
+        {
+            return this->render_list;
+        }
+
         //! Set render clearing colo(u)r
         /*! @param global_col_id: Core colo(u)r ID (i.e. MCK::COL_....)
          */
@@ -337,7 +924,15 @@ class GameEng
         /*! @param render_instance: Instance being changed
          *  @param parent_block: Parent block
          *  @param new_z: New value of 'z'
-         *  @param use_current_z_as_hint: Set to true if 'z' not changing my much
+         *  @param use_current_z_as_hint: No longer used, retained for compatibility
+         *  Note: The instance is moved to its new position in
+         *        the block's render order when the block is
+         *        next rendered, so changing the 'z' of many
+         *        instances costs a single (lazy) re-sort.
+         *        However, each call also checks the instances
+         *        already changed since the block was last
+         *        rendered, so 'change_z_bulk' is preferable
+         *        for changing very many instances at once.
          */
         static void change_z(
             std::shared_ptr<MCK::GameEngRenderBase> render_instance,
@@ -346,11 +941,52 @@ class GameEng
             bool use_current_z_as_hint = true
         );
 
+        //! New 'z' value for a render instance, used by 'change_z_bulk'
+        struct ZChange
+        {
+            //! Instance being changed
+            std::shared_ptr<MCK::GameEngRenderBase> instance;
+
+            //! New value of 'z'
+            uint32_t new_z;
+        };
+
+        //! Change the 'z' values of many render instances in the same block
+        /*! @param parent_block: Parent block (of all instances)
+         *  @param changes: Pointer to first of array of changes
+         *  @param num_changes: Number of changes
+         *  All instances are located before any is changed, so
+         *  if an exception is thrown, nothing has been changed.
+         *  The block is then re-sorted once, when next rendered,
+         *  which suits depth-sorting many instances every frame.
+         */
+        static void change_z_bulk(
+            std::shared_ptr<MCK::GameEngRenderBlock> parent_block,
+            const MCK::GameEng::ZChange* changes,
+            size_t num_changes
+        );
+
+        //! Change the 'z' values of many render instances in the same block
+        /*! @param parent_block: Parent block (of all instances)
+         *  @param changes: Changes
+         */
+        static void change_z_bulk(
+            std::shared_ptr<MCK::GameEngRenderBlock> parent_block,
+            const std::vector<MCK::GameEng::ZChange> &changes
+        )
+        {
+            MCK::GameEng::change_z_bulk(
+                parent_block,
+                changes.data(),
+                changes.size()
+            );
+        }
+
         //! Change the 'z' value of a render instance
         /*! @param render_instance: Instance being changed
          *  @param parent_block: Parent block
          *  @param new_z: New value of 'z' RELATIVE to DEFAULT_Z_VALUE
-         *  @param use_current_z_as_hint: Set to true if 'z' not changing my much
+         *  @param use_current_z_as_hint: No longer used, retained for compatibility
          */
         static void change_z_rel_to_default(
             std::shared_ptr<MCK::GameEngRenderBase> render_instance,
@@ -393,6 +1029,41 @@ class GameEng
 
     private:
 
+        //! Texture, and its usage, for reference counting and eviction
+        struct TextureRecord
+        {
+            //! SDL texture (atlas page, if held in atlas)
+            SDL_Texture* tex;
+
+            //! Flag to indicate texture is held in atlas
+            bool in_atlas;
+
+            //! Position of texture in atlas (only valid if 'in_atlas' is true)
+            MCK::GameEngTextureAtlas::Region atlas_region;
+
+            //! Memory used by texture (zero if held in atlas)
+            size_t num_bytes;
+
+            //! Number of render infos using texture
+            uint32_t ref_count;
+
+            //! Position in 'unused_textures' (only valid if 'ref_count' is zero and not in atlas)
+            std::list<MCK_TEX_ID_TYPE>::iterator unused_pos;
+
+            TextureRecord( void )
+            {
+                this->tex = NULL;
+                this->in_atlas = false;
+                this->atlas_region.page = 0;
+                this->atlas_region.rect.x = 0;
+                this->atlas_region.rect.y = 0;
+                this->atlas_region.rect.w = 0;
+                this->atlas_region.rect.h = 0;
+                this->num_bytes = 0;
+                this->ref_count = 0;
+            }
+        };
+
         //! Assign MuckyVision key code to SDL scancode, assuming scancode has no current assignment
         /*! Note: if a scancode has already been assigned to the key,
          *  this call will be ignored.
@@ -412,6 +1083,133 @@ class GameEng
             );
         }
 
+        //! Add image to texture atlas, only used internally
+        /*! @param tex_id: ID of texture
+         *  @param width_in_pixels: Width of image
+         *  @param height_in_pixels: Height of image
+         *  @param pixels: Decoded image (see 'basic_decode_image')
+         *  @returns True if added, false if atlas has no room
+         */
+        bool add_to_atlas(
+            MCK_TEX_ID_TYPE tex_id,
+            uint16_t width_in_pixels,
+            uint16_t height_in_pixels,
+            const uint32_t* pixels
+        );
+
+        //! Evict all atlas pages holding no texture used by a render info, only used internally
+        void evict_atlas_pages( void );
+
+        //! Add record of new texture, only used internally
+        /*! @param tex_id: ID of texture
+         *  @param record: Texture (with atlas position, if in atlas)
+         *  Textures outside the atlas are counted against the
+         *  texture budget, and are unused until acquired.
+         */
+        void add_texture_record(
+            MCK_TEX_ID_TYPE tex_id,
+            TextureRecord record
+        );
+
+        //! Evict unused textures until there is room for another, only used internally
+        /*! @param num_bytes: Memory needed by new texture
+         */
+        void evict_textures( size_t num_bytes );
+
+        //! Add reference to texture, only used internally
+        void acquire_tex( TextureRecord &record ) const;
+
+        //! Remove reference to texture, only used internally
+        void release_tex( MCK_TEX_ID_TYPE tex_id ) const noexcept;
+
+        //! Remove reference to texture of destroyed render info, only used internally
+        /*! See GameEngRenderInfo::tex_release_func */
+        static void release_render_info_tex( MCK_TEX_ID_TYPE tex_id ) noexcept
+        {
+            MCK::GameEng::get_singleton().release_tex( tex_id );
+        }
+
+        //! Discard compiled render list if its top-level block is destroyed, only used internally
+        /*! See GameEngRenderBlock::destroy_func.
+         *  Blocks below the top level need no check, as
+         *  a block can only be destroyed once removed
+         *  from its parent, which changes the parent's
+         *  revision, so its slot is discarded before it
+         *  is reached (see update_render_list_items).
+         */
+        static void render_block_destroyed(
+            const MCK::GameEngRenderBlock* block
+        ) noexcept
+        {
+            MCK::GameEngRenderList &rl
+                = MCK::GameEng::get_singleton().render_list;
+            if( rl.root == block )
+            {
+                rl.clear();
+            }
+        }
+
+        //! Set texture of render info, including atlas position, only used internally
+        void set_render_info_tex(
+            MCK::GameEngRenderInfo &info,
+            MCK_TEX_ID_TYPE tex_id,
+            TextureRecord &record
+        ) const
+        {
+            // Acquire new reference before releasing old,
+            // in case texture is unchanged
+            this->acquire_tex( record );
+            if( info.tex_ref )
+            {
+                this->release_tex( info.tex_id );
+            }
+            info.tex_ref = true;
+
+            info.tex = record.tex;
+            info.tex_id = tex_id;
+            info.in_atlas = record.in_atlas;
+            if( record.in_atlas )
+            {
+                info.atlas_rect = record.atlas_region.rect;
+            }
+            info.content_changed();
+        }
+
+        //! Decode image into 32bit pixels of texture format, only used internally
+        /*! @param pixels: Resulting pixels (room for pitch x height, no padding) */
+        void basic_decode_image(
+            uint8_t bits_per_pixel,
+            uint16_t pitch_in_pixels,
+            uint16_t height_in_pixels,
+            const std::vector<uint8_t> &pixel_data,
+            const std::vector<uint8_t> &local_palette,
+            uint32_t* pixels
+        ) const;
+
+        //! Get buffer for decoded images, only used internally
+        /*! @param num_pixels: Minimum size of buffer, in pixels
+         *  There is one buffer per thread, which is re-used.
+         */
+        static std::vector<uint32_t>& get_scratch_pixels( size_t num_pixels );
+
+        //! Add texture of decoded image (to atlas, if possible), only used internally
+        void add_texture(
+            MCK_TEX_ID_TYPE tex_id,
+            uint16_t pitch_in_pixels,
+            uint16_t height_in_pixels,
+            const uint32_t* pixels,
+            bool streaming
+        );
+
+        //! Create texture holding decoded image, only used internally
+        void basic_upload_texture(
+            uint16_t pitch_in_pixels,
+            uint16_t height_in_pixels,
+            const uint32_t* pixels,
+            SDL_Texture* &texture,
+            bool streaming
+        );
+
         //! Abstraction of image creation process, only used internally
         void basic_create_texture(
             uint8_t bits_per_pixel,
@@ -419,9 +1217,303 @@ class GameEng
             uint16_t height_in_pixels,
             const std::vector<uint8_t> &pixel_data,
             const std::vector<uint8_t> &local_palette,
-            SDL_Texture* &texture
+            SDL_Texture* &texture,
+            bool streaming = false
         );
 
+        //! Set colo(u)r modulation of palette-indexed layers, only used internally
+        /*! @param block: Block created by 'create_indexed_render_block'
+         *  @param local_palette: Vector of colo(u)r IDs
+         */
+        void set_indexed_layer_colors(
+            MCK::GameEngRenderBlock* block,
+            const std::vector<uint8_t> &local_palette
+        ) const;
+
+        //! Decode image into existing streaming texture, only used internally
+        void basic_update_texture(
+            uint8_t bits_per_pixel,
+            uint16_t pitch_in_pixels,
+            uint16_t height_in_pixels,
+            const std::vector<uint8_t> &pixel_data,
+            const std::vector<uint8_t> &local_palette,
+            SDL_Texture* texture
+        );
+
+        //! Find entry of render instance in block, only used internally
+        /*! @returns Iterator to entry, or end of block's render instances if not found */
+        static MCK::GameEngRenderInstanceVec::iterator find_render_instance(
+            MCK::GameEngRenderBlock* block,
+            const MCK::GameEngRenderBase* instance
+        );
+
+        //! Render block and its sub-blocks recursively, only used internally
+        /*! @param render_block: Block to render (must not be NULL)
+         *  @param hoz_offset: Cumulative offset of parent blocks
+         *  @param vert_offset: Cumulative offset of parent blocks
+         *  @param depth: Depth of block below top-level block (names profiler zones)
+         *  Note: Unlike 'render_all', this uses raw pointers,
+         *        so no shared pointers are copied during render.
+         */
+        void render_sub_tree(
+            const MCK::GameEngRenderBlock* render_block,
+            int16_t hoz_offset,
+            int16_t vert_offset,
+            unsigned depth
+        ) const;
+
+        //! Generate draw commands for cells of tile map within game window, only used internally
+        /*! @param tile_map: Tile map
+         *  @param hoz_offset: Cumulative offset of parent blocks
+         *  @param vert_offset: Cumulative offset of parent blocks
+         *  @param hoz_sub_offset: Cumulative fraction of a pixel, in 256ths (sub-pixel rendering only)
+         *  @param vert_sub_offset: Cumulative fraction of a pixel, in 256ths (sub-pixel rendering only)
+         *  @param items: Draw commands are appended to this
+         */
+        void add_tile_map_items(
+            const MCK::GameEngTileMap* tile_map,
+            int hoz_offset,
+            int vert_offset,
+            uint8_t hoz_sub_offset,
+            uint8_t vert_sub_offset,
+            std::vector<MCK::GameEngRenderList::Item> &items
+        ) const;
+
+        //! Render from compiled render list, only used internally
+        void render_compiled(
+            const MCK::GameEngRenderBlock* render_block,
+            int16_t hoz_offset,
+            int16_t vert_offset
+        ) const;
+
+        //! Update compiled render list and collect its draw commands, only used internally
+        /*! @param track_changes: If true, changes since each image was
+         *                        drawn into retained frame are recorded
+         *  Draw commands are only regenerated for blocks whose
+         *  contents, offsets or visibility have changed, and
+         *  are not collected at all if nothing has changed.
+         */
+        void update_render_list_items(
+            const MCK::GameEngRenderBlock* render_block,
+            int16_t hoz_offset,
+            int16_t vert_offset,
+            bool track_changes
+        ) const;
+
+        //! Collect draw commands of render list, only used internally
+        /*! @param track_changes: If true, changes since each image was
+         *                        drawn into retained frame are recorded
+         */
+        void generate_render_list_items( bool track_changes ) const;
+
+        //! Regenerate draw command of a render list entry, only used internally
+        /*! @param entry: Entry of a block that has changed
+         *  @param slot: Entry's block
+         *  @param track_changes: If true, areas needing redraw are recorded
+         */
+        void update_render_list_entry(
+            MCK::GameEngRenderList::Entry &entry,
+            const MCK::GameEngRenderList::BlockSlot &slot,
+            bool track_changes
+        ) const;
+
+        //! Compile block (and sub-blocks) into render list's scratch space, only used internally
+        /*! @param block: Block to compile
+         *  @param parent_slot: Slot index of parent block
+         *  @param base_slot: Slot index of first scratch slot
+         *  @param base_entry: Entry index of first scratch entry
+         */
+        void compile_render_block(
+            const MCK::GameEngRenderBlock* block,
+            uint32_t parent_slot,
+            uint32_t base_slot,
+            uint32_t base_entry
+        ) const;
+
+        //! Re-compile a block (and sub-blocks) within render list, only used internally
+        void recompile_render_list_slot( uint32_t slot ) const;
+
+        //! Redraw changed areas of retained frame, only used internally
+        void render_retained_frame( void ) const;
+
+        //! Disable retained frame and destroy its texture, only used internally
+        void release_retained_frame( void ) noexcept;
+
+        //! Render draw commands, only used internally
+        void render_items(
+            const std::vector<MCK::GameEngRenderList::Item> &items
+        ) const;
+
+        //! Render draw commands as batches, only used internally
+        void render_items_batched(
+            const std::vector<MCK::GameEngRenderList::Item> &items
+        ) const;
+
+#if defined MCK_PROFILE
+        //! Count draw call for profiler, only used internally
+        void profile_draw_call( const SDL_Texture* tex ) const noexcept
+        {
+            this->profile_counts.num_draw_calls++;
+            if( tex != this->profile_prev_tex )
+            {
+                this->profile_counts.num_texture_switches++;
+                this->profile_prev_tex = tex;
+            }
+        }
+#endif
+
+        //! Test rectangle against game window, only used internally
+        /*! @param rect: Rectangle, excluding offsets
+         *  @param hoz_offset: Horizontal offset to apply to 'rect'
+         *  @param vert_offset: Vertical offset to apply to 'rect'
+         *  @returns False only if culling enabled and rectangle is wholly outside window
+         */
+        bool is_on_screen(
+            const SDL_Rect &rect,
+            int hoz_offset,
+            int vert_offset
+        ) const noexcept
+        {
+            if( !this->use_culling )
+            {
+                return true;
+            }
+
+            const int X = rect.x + hoz_offset;
+            const int Y = rect.y + vert_offset;
+            // Note: Rectangles ending exactly at the left or top
+            //       edge are kept, as fractions of a pixel
+            //       (see 'set_sub_pixel_render') may reveal them
+            return rect.w > 0 && rect.h > 0
+                   && X < int( this->window_width_in_pixels )
+                   && Y < int( this->window_height_in_pixels )
+                   && X + rect.w >= 0
+                   && Y + rect.h >= 0;
+        }
+
+        //! Render single draw command, only used internally
+        void render_item( const MCK::GameEngRenderList::Item &item ) const
+        {
+#if defined MCK_PROFILE
+            this->profile_draw_call( item.tex );
+#endif
+
+            const bool COLOR_MOD
+                = MCK::GameEngRenderInfo::set_tex_color_mod(
+                    item.tex,
+                    item.color_mod
+                );
+
+            // If no flags, use simpler command
+            if( item.flags == 0 )
+            {
+                SDL_RenderCopy(
+                    this->renderer,
+                    item.tex,
+                    item.clip ? &item.clip_rect : NULL,
+                    &item.dest_rect
+                );
+            }
+            else
+            {
+                // Get rotation angle (in degrees) and flip
+                double angle;
+                SDL_RendererFlip flip;
+                MCK::GameEngRenderInfo::calc_angle_and_flip(
+                    item.flags,
+                    angle,
+                    flip
+                );
+
+                SDL_RenderCopyEx(
+                    this->renderer,
+                    item.tex,
+                    item.clip ? &item.clip_rect : NULL,
+                    &item.dest_rect,
+                    angle,
+                    NULL,  // Rotate about centre
+                    flip
+                );
+            }
+
+            if( COLOR_MOD )
+            {
+                MCK::GameEngRenderInfo::clear_tex_color_mod( item.tex );
+            }
+        }
+
+#if SDL_VERSION_ATLEAST(2,0,10)
+        //! Render single draw command, including fractions of a pixel, only used internally
+        /*! Draw commands with no fraction of a pixel are
+         *  passed to 'render_item', avoiding float conversion.
+         */
+        void render_item_sub_pixel(
+            const MCK::GameEngRenderList::Item &item
+        ) const
+        {
+            if( ( item.hoz_sub_offset | item.vert_sub_offset ) == 0 )
+            {
+                this->render_item( item );
+                return;
+            }
+
+#if defined MCK_PROFILE
+            this->profile_draw_call( item.tex );
+#endif
+
+            const bool COLOR_MOD
+                = MCK::GameEngRenderInfo::set_tex_color_mod(
+                    item.tex,
+                    item.color_mod
+                );
+
+            SDL_FRect dest;
+            dest.x = float( item.dest_rect.x )
+                         + float( item.hoz_sub_offset ) / 256.0f;
+            dest.y = float( item.dest_rect.y )
+                         + float( item.vert_sub_offset ) / 256.0f;
+            dest.w = float( item.dest_rect.w );
+            dest.h = float( item.dest_rect.h );
+
+            // If no flags, use simpler command
+            if( item.flags == 0 )
+            {
+                SDL_RenderCopyF(
+                    this->renderer,
+                    item.tex,
+                    item.clip ? &item.clip_rect : NULL,
+                    &dest
+                );
+            }
+            else
+            {
+                // Get rotation angle (in degrees) and flip
+                double angle;
+                SDL_RendererFlip flip;
+                MCK::GameEngRenderInfo::calc_angle_and_flip(
+                    item.flags,
+                    angle,
+                    flip
+                );
+
+                SDL_RenderCopyExF(
+                    this->renderer,
+                    item.tex,
+                    item.clip ? &item.clip_rect : NULL,
+                    &dest,
+                    angle,
+                    NULL,  // Rotate about centre
+                    flip
+                );
+            }
+
+            if( COLOR_MOD )
+            {
+                MCK::GameEngRenderInfo::clear_tex_color_mod( item.tex );
+            }
+        }
+#endif
+
         //! Get RGBA values for a given colo(u)r ID, only used internally
         static void get_RGBA(
             uint8_t col_id,
@@ -463,8 +1555,11 @@ class GameEng
         static const std::vector<uint8_t> CORE_PALETTE_BLUES;
         static const std::vector<uint8_t> CORE_PALETTE_ALPHAS;
         
-        //! Map linking texture ids to texture pointers
-        std::map<MCK_TEX_ID_TYPE,SDL_Texture*> textures;
+        //! Table of all textures, by texture ID
+        /*! This is mutable as references are acquired and
+         *  released by const methods (and destructors).
+         */
+        mutable MCK::GameEngTextureTable<TextureRecord> textures;
 
         //! Vector of blank textures (one for each colo(u)r)
         std::vector<SDL_Texture*> blank_textures;
@@ -472,11 +1567,88 @@ class GameEng
         //! Top level render block
         std::shared_ptr<MCK::GameEngRenderBlock> prime_render_block;
 
+        //! Flag to indicate compiled render list is used by 'render_all'
+        bool use_compiled_render_list;
+
+        //! Texture atlas
+        MCK::GameEngTextureAtlas atlas;
+
+        //! Images wider or taller than this are not added to atlas
+        uint16_t atlas_max_image_size;
+
+        //! Palette index of each layer of palette-indexed textures, by texture ID
+        std::map<MCK_TEX_ID_TYPE,std::vector<uint8_t>> indexed_tex_layers;
+
+        //! IDs of textures (excluding atlas) not used by any render info
+        /*! Least recently used first */
+        mutable std::list<MCK_TEX_ID_TYPE> unused_textures;
+
+        //! Memory budget for textures (excluding atlas), zero for no limit
+        size_t max_texture_bytes;
+
+        //! Count budget for textures (excluding atlas), zero for no limit
+        size_t max_textures;
+
+        //! Memory used by textures (excluding atlas)
+        size_t texture_bytes;
+
+        //! Number of textures (excluding atlas)
+        size_t num_separate_textures;
+
+        //! Number of textures evicted to keep within budget
+        size_t num_evicted_textures;
+
+        //! Flag to indicate batched rendering is used by 'render_all'
+        bool use_batched_render;
+
+        //! Flag to indicate 'render_all' uses fractions of a pixel in block offsets
+        bool use_sub_pixel_render;
+
+        //! Flag to indicate off-screen images are culled by 'render_all'
+        bool use_culling;
+
+        //! Flag to indicate 'render_all' draws into retained frame
+        bool use_retained_frame;
+
+        //! Persistent texture that 'render_all' draws into, when retained frame used
+        SDL_Texture* retained_frame_tex;
+
+        //! Compiled render list
+        /*! This is mutable as it is a cache of the render
+         *  block tree, maintained by (const) 'render_all'.
+         */
+        mutable MCK::GameEngRenderList render_list;
+
+#if defined MCK_PROFILE
+        //! Counts gathered by rendering thread, handed to profiler by 'show'
+        mutable MCK::GameEngProfiler::Counts profile_counts;
+
+        //! Texture of most recent draw call, for profiler
+        mutable const SDL_Texture* profile_prev_tex;
+#endif
+
+        //! Draw commands handed from 'publish_render_snapshot' to 'render_snapshot'
+        mutable MCK::GameEngTripleBuffer<
+            std::vector<MCK::GameEngRenderList::Item>
+        > render_snapshots;
+
         //! SDL2 renderer instance
         SDL_Renderer* renderer;
 
         //! SDL2 window instance
         SDL_Window* window;
+
+        //! Flag to indicate game engine initialized without a window
+        bool headless;
+
+        //! Surface drawn onto by renderer, if headless (otherwise NULL)
+        SDL_Surface* frame_surface;
+
+        //! Pixel format of textures (renderer's preferred 32bit format)
+        Uint32 texture_format;
+
+        //! Details of 'texture_format', used when decoding images
+        SDL_PixelFormat* texture_pixel_format;
             
         //! Game window width
         /*! Width of game window in pixels.*/
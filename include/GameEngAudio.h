@@ -62,6 +62,7 @@
 #include <vector>  // For vector
 
 #include "Defs.h"
+#include "GameEngProfiler.h"
 #include "VoiceBase.h"
 #include "VoiceSynth.h"
 
@@ -0,0 +1,255 @@
+////////////////////////////////////////////
+//  ------------------------------------
+//  ---MUCKY VISION 3 (BASIC ENGINE) ---
+//  ------------------------------------
+//
+//  GameEngPixelDecoder.h
+//
+//  Expands packed palette indices (1 to 8
+//  bits per pixel) into 32bit pixels, using
+//  a lookup table of colo(u)rs built once
+//  per local palette
+//
+//  This file has no corresponding .cpp file
+//
+//  Copyright (c) Muckytaters 2023
+//
+//  This program is free software: you can
+//  redistribute it and/or modify it under
+//  the terms of the GNU General Public License
+//  as published by the Free Software Foundation,
+//  either version 3 of the License, or (at your
+//  option) any later version.
+//
+//  This program is distributed in the hope it
+//  will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY
+//  or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU
+//  General Public License along with this
+//  program. If not, see http://www.gnu.org/license
+////////////////////////////////////////////
+
+#ifndef MCK_GAME_ENG_PIX_DEC_H
+#define MCK_GAME_ENG_PIX_DEC_H
+
+#include <cstddef>  // For size_t
+#include <cstdint>  // For uint32_t et al.
+#include <cstring>  // For memcpy
+
+// 128bit vector copies, where available
+#if defined __SSE2__
+#include <emmintrin.h>
+#define MCK_PIX_DEC_SSE2
+#elif defined __ARM_NEON
+#include <arm_neon.h>
+#define MCK_PIX_DEC_NEON
+#endif
+
+namespace MCK
+{
+
+class GameEngPixelDecoder
+{
+    public:
+
+        //! Maximum number of entries in a lookup table (i.e. 8 bits per pixel)
+        static const size_t MAX_LUT_SIZE = 256;
+
+        //! Get palette index of a single pixel
+        /*! @param bits_per_pixel: Bits per palette index (1 to 8)
+         *  @param pixel_data: Palette indices, packed most significant bit first
+         *  @param pixel_pos: Position of pixel within data
+         */
+        static uint8_t get_index(
+            uint8_t bits_per_pixel,
+            const uint8_t* pixel_data,
+            size_t pixel_pos
+        ) noexcept
+        {
+            uint8_t index = 0x00;
+            size_t bit_pos = pixel_pos * bits_per_pixel;
+            for( uint8_t i = 0; i < bits_per_pixel; i++, bit_pos++ )
+            {
+                index = ( index << 1 )
+                        | ( ( pixel_data[ bit_pos / 8 ] >> ( 7 - bit_pos % 8 ) )
+                            & 0x01 );
+            }
+            return index;
+        }
+
+        //! Expand palette indices into 32bit pixels
+        /*! @param bits_per_pixel: Bits per palette index (1 to 8)
+         *  @param pixel_data: Palette indices, packed most significant bit first
+         *  @param num_pixels: Number of pixels to expand
+         *  @param lut: Lookup table of 2^bits_per_pixel 32bit colo(u)rs
+         *  @param dest: Resulting pixels (room for 'num_pixels')
+         *  1, 2, 4 and 8 bits per pixel are expanded a whole byte
+         *  at a time, other bit depths one pixel at a time.
+         *  Note: No bounds checks are made, so caller must
+         *        check sizes (and that every index used has
+         *        a valid colo(u)r).
+         */
+        static void decode(
+            uint8_t bits_per_pixel,
+            const uint8_t* pixel_data,
+            size_t num_pixels,
+            const uint32_t* lut,
+            uint32_t* dest
+        ) noexcept
+        {
+            switch( bits_per_pixel )
+            {
+                case 1:
+                    MCK::GameEngPixelDecoder::decode_bytes<1>(
+                        pixel_data,
+                        num_pixels,
+                        lut,
+                        dest
+                    );
+                    break;
+
+                case 2:
+                    MCK::GameEngPixelDecoder::decode_bytes<2>(
+                        pixel_data,
+                        num_pixels,
+                        lut,
+                        dest
+                    );
+                    break;
+
+                case 4:
+                    MCK::GameEngPixelDecoder::decode_bytes<4>(
+                        pixel_data,
+                        num_pixels,
+                        lut,
+                        dest
+                    );
+                    break;
+
+                case 8:
+                    for( size_t i = 0; i < num_pixels; i++ )
+                    {
+                        dest[ i ] = lut[ pixel_data[ i ] ];
+                    }
+                    break;
+
+                default:
+                    for( size_t i = 0; i < num_pixels; i++ )
+                    {
+                        dest[ i ] = lut[
+                            MCK::GameEngPixelDecoder::get_index(
+                                bits_per_pixel,
+                                pixel_data,
+                                i
+                            )
+                        ];
+                    }
+            }
+        }
+
+
+    protected:
+
+        //! Number of bytes of pixel data above which an expansion table is built
+        /*! Building the table costs about as much
+         *  as decoding this many bytes directly.
+         */
+        static const size_t MIN_BYTES_FOR_EXPANSION_TABLE = 256;
+
+        //! Copy the pixels expanded from one byte
+        template<int BITS_PER_PIXEL>
+        static void copy_byte_pixels( const uint32_t* src, uint32_t* dest ) noexcept
+        {
+            const int PIXELS_PER_BYTE = 8 / BITS_PER_PIXEL;
+            if( PIXELS_PER_BYTE >= 4 )
+            {
+                for( int i = 0; i < PIXELS_PER_BYTE; i += 4 )
+                {
+#if defined MCK_PIX_DEC_SSE2
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i*>( dest + i ),
+                        _mm_loadu_si128(
+                            reinterpret_cast<const __m128i*>( src + i )
+                        )
+                    );
+#elif defined MCK_PIX_DEC_NEON
+                    vst1q_u32( dest + i, vld1q_u32( src + i ) );
+#else
+                    std::memcpy( dest + i, src + i, 4 * sizeof( uint32_t ) );
+#endif
+                }
+            }
+            else
+            {
+                std::memcpy( dest, src, PIXELS_PER_BYTE * sizeof( uint32_t ) );
+            }
+        }
+
+        //! Expand palette indices a byte at a time
+        /*! For large images, a table holding the pixels
+         *  expanded from every possible byte value is built
+         *  first, so that each byte of pixel data becomes a
+         *  single (vector) copy. Otherwise, the pixels of
+         *  each byte are looked up individually.
+         */
+        template<int BITS_PER_PIXEL>
+        static void decode_bytes(
+            const uint8_t* pixel_data,
+            size_t num_pixels,
+            const uint32_t* lut,
+            uint32_t* dest
+        ) noexcept
+        {
+            const int PIXELS_PER_BYTE = 8 / BITS_PER_PIXEL;
+            const uint8_t MASK = ( 0x01 << BITS_PER_PIXEL ) - 1;
+            const size_t NUM_WHOLE_BYTES = num_pixels / PIXELS_PER_BYTE;
+
+            if( NUM_WHOLE_BYTES >= MCK::GameEngPixelDecoder::MIN_BYTES_FOR_EXPANSION_TABLE )
+            {
+                uint32_t table[ 256 * PIXELS_PER_BYTE ];
+                for( int b = 0; b < 256; b++ )
+                {
+                    for( int i = 0; i < PIXELS_PER_BYTE; i++ )
+                    {
+                        table[ b * PIXELS_PER_BYTE + i ]
+                            = lut[ ( b >> ( 8 - ( i + 1 ) * BITS_PER_PIXEL ) ) & MASK ];
+                    }
+                }
+
+                for( size_t n = 0; n < NUM_WHOLE_BYTES; n++ )
+                {
+                    MCK::GameEngPixelDecoder::copy_byte_pixels<BITS_PER_PIXEL>(
+                        table + pixel_data[ n ] * PIXELS_PER_BYTE,
+                        dest
+                    );
+                    dest += PIXELS_PER_BYTE;
+                }
+            }
+            else
+            {
+                for( size_t n = 0; n < NUM_WHOLE_BYTES; n++ )
+                {
+                    const uint8_t BYTE = pixel_data[ n ];
+                    for( int i = 0; i < PIXELS_PER_BYTE; i++ )
+                    {
+                        *dest++ = lut[ ( BYTE >> ( 8 - ( i + 1 ) * BITS_PER_PIXEL ) ) & MASK ];
+                    }
+                }
+            }
+
+            // Any remaining pixels (part of a byte)
+            const uint8_t LAST_BYTE
+                = num_pixels % PIXELS_PER_BYTE > 0 ? pixel_data[ NUM_WHOLE_BYTES ] : 0;
+            for( size_t i = 0; i < num_pixels % PIXELS_PER_BYTE; i++ )
+            {
+                *dest++ = lut[ ( LAST_BYTE >> ( 8 - ( i + 1 ) * BITS_PER_PIXEL ) ) & MASK ];
+            }
+        }
+};
+
+}  // End of namespace MCK
+
+#endif
@@ -0,0 +1,259 @@
+////////////////////////////////////////////
+//  ------------------------------------
+//  ---MUCKY VISION 3 (BASIC ENGINE) ---
+//  ------------------------------------
+//
+//  GameEngPool.h
+//
+//  Pooled allocation of render instances,
+//  for use with std::allocate_shared, so
+//  that instances created and destroyed
+//  every frame (bullets, particles, text)
+//  do not churn the heap
+//
+//  This file has no corresponding .cpp file
+//
+//  Copyright (c) Muckytaters 2023
+//
+//  This program is free software: you can
+//  redistribute it and/or modify it under
+//  the terms of the GNU General Public License
+//  as published by the Free Software Foundation,
+//  either version 3 of the License, or (at your
+//  option) any later version.
+//
+//  This program is distributed in the hope it
+//  will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY
+//  or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU
+//  General Public License along with this
+//  program. If not, see http://www.gnu.org/license
+////////////////////////////////////////////
+
+#ifndef MCK_GAME_ENG_POOL_H
+#define MCK_GAME_ENG_POOL_H
+
+#include <cstddef>  // For size_t, max_align_t
+#include <new>  // For operator new
+#include <type_traits>  // For aligned_storage
+#include <vector>
+
+namespace MCK
+{
+
+//! Statistics shared by all pools
+class GameEngPoolStats
+{
+    public:
+
+        //! Get number of slabs allocated from the heap, by all pools
+        /*! Once a program reaches a steady state (i.e. it
+         *  destroys instances as fast as it creates them),
+         *  this should stop increasing.
+         */
+        static size_t get_num_slab_allocations( void ) noexcept
+        {
+            return MCK::GameEngPoolStats::num_slab_allocations();
+        }
+
+        //! Get number of blocks currently in use, across all pools
+        static size_t get_num_blocks_in_use( void ) noexcept
+        {
+            return MCK::GameEngPoolStats::num_blocks_in_use();
+        }
+
+    protected:
+
+        template<size_t BLOCK_SIZE, size_t BLOCK_ALIGN>
+        friend class GameEngSlab;
+
+        // Counters are function-local statics, so that
+        // this header needs no corresponding .cpp file
+        static size_t& num_slab_allocations( void ) noexcept
+        {
+            static size_t count = 0;
+            return count;
+        }
+
+        static size_t& num_blocks_in_use( void ) noexcept
+        {
+            static size_t count = 0;
+            return count;
+        }
+};
+
+//! Free list of fixed size blocks, carved from larger slabs
+/*! There is one free list per block size (and alignment),
+ *  shared by all types of that size.
+ *  Blocks are never returned to the heap, so once enough
+ *  slabs exist, allocation and deallocation are a few
+ *  pointer operations each.
+ *  Note: Like the render block tree, this is not
+ *        thread-safe, so instances must be created and
+ *        destroyed on one thread only.
+ */
+template<size_t BLOCK_SIZE, size_t BLOCK_ALIGN>
+class GameEngSlab
+{
+    public:
+
+        //! Number of blocks in each slab
+        static const size_t BLOCKS_PER_SLAB = 64;
+
+        //! Get a block, allocating a new slab if none free
+        static void* allocate( void )
+        {
+            Slabs &slabs = MCK::GameEngSlab<BLOCK_SIZE,BLOCK_ALIGN>::get_slabs();
+
+            if( slabs.free_list == NULL )
+            {
+                slabs.add_slab();
+            }
+
+            Node* const NODE = slabs.free_list;
+            slabs.free_list = NODE->next;
+            slabs.num_in_use++;
+            MCK::GameEngPoolStats::num_blocks_in_use()++;
+            return NODE;
+        }
+
+        //! Return a block to the free list
+        static void deallocate( void* block ) noexcept
+        {
+            Slabs &slabs = MCK::GameEngSlab<BLOCK_SIZE,BLOCK_ALIGN>::get_slabs();
+
+            Node* const NODE = static_cast<Node*>( block );
+            NODE->next = slabs.free_list;
+            slabs.free_list = NODE;
+            slabs.num_in_use--;
+            MCK::GameEngPoolStats::num_blocks_in_use()--;
+        }
+
+    protected:
+
+        static_assert(
+            BLOCK_ALIGN <= alignof( std::max_align_t ),
+            "Over-aligned types cannot be pooled"
+        );
+
+        //! Block, which holds either an object or a link to the next free block
+        union Node
+        {
+            Node* next;
+            typename std::aligned_storage<BLOCK_SIZE,BLOCK_ALIGN>::type storage;
+        };
+
+        //! All slabs of this block size
+        struct Slabs
+        {
+            Node* free_list;
+            size_t num_in_use;
+            std::vector<Node*> slabs;
+
+            Slabs( void )
+            {
+                this->free_list = NULL;
+                this->num_in_use = 0;
+            }
+
+            void add_slab( void )
+            {
+                Node* const SLAB = static_cast<Node*>(
+                    ::operator new(
+                        sizeof( Node )
+                            * MCK::GameEngSlab<BLOCK_SIZE,BLOCK_ALIGN>::BLOCKS_PER_SLAB
+                    )
+                );
+                this->slabs.push_back( SLAB );
+                MCK::GameEngPoolStats::num_slab_allocations()++;
+
+                // Chain blocks together, in address order
+                for( size_t i = MCK::GameEngSlab<BLOCK_SIZE,BLOCK_ALIGN>::BLOCKS_PER_SLAB;
+                     i > 0;
+                     i--
+                )
+                {
+                    SLAB[ i - 1 ].next = this->free_list;
+                    this->free_list = &SLAB[ i - 1 ];
+                }
+            }
+        };
+
+        //! Get slabs of this block size
+        /*! These are never destroyed, as objects may be
+         *  owned by other static objects (e.g. the GameEng
+         *  singleton) that are destroyed at exit, in any
+         *  order. The operating system reclaims the memory.
+         */
+        static Slabs& get_slabs( void )
+        {
+            static Slabs* slabs = new Slabs;
+            return *slabs;
+        }
+};
+
+//! Standard allocator that takes single objects from a GameEngSlab
+/*! Intended for std::allocate_shared, which makes a single
+ *  allocation holding both object and reference counts
+ *  (so the reference counts are, in effect, intrusive).
+ *  Arrays fall back on the heap.
+ */
+template<class T>
+class GameEngPoolAllocator
+{
+    public:
+
+        typedef T value_type;
+
+        GameEngPoolAllocator( void ) noexcept {}
+
+        template<class U>
+        GameEngPoolAllocator( const MCK::GameEngPoolAllocator<U> & /* other */ ) noexcept {}
+
+        T* allocate( size_t n )
+        {
+            if( n == 1 )
+            {
+                return static_cast<T*>(
+                    MCK::GameEngSlab<sizeof( T ),alignof( T )>::allocate()
+                );
+            }
+            return static_cast<T*>( ::operator new( n * sizeof( T ) ) );
+        }
+
+        void deallocate( T* p, size_t n ) noexcept
+        {
+            if( n == 1 )
+            {
+                MCK::GameEngSlab<sizeof( T ),alignof( T )>::deallocate( p );
+                return;
+            }
+            ::operator delete( p );
+        }
+};
+
+//! All pool allocators are interchangeable
+template<class T, class U>
+bool operator==(
+    const MCK::GameEngPoolAllocator<T> &a,
+    const MCK::GameEngPoolAllocator<U> &b
+) noexcept
+{
+    return true;
+}
+
+template<class T, class U>
+bool operator!=(
+    const MCK::GameEngPoolAllocator<T> &a,
+    const MCK::GameEngPoolAllocator<U> &b
+) noexcept
+{
+    return false;
+}
+
+}  // End of namespace MCK
+
+#endif
@@ -0,0 +1,502 @@
+////////////////////////////////////////////
+//  ------------------------------------
+//  ---MUCKY VISION 3 (BASIC ENGINE) ---
+//  ------------------------------------
+//
+//  GameEngProfiler.h
+//
+//  Lightweight frame-time profiler, recording
+//  timed zones and per-frame counts, which
+//  can be queried or saved as a Chrome trace
+//
+//  The engine only records zones and counts
+//  if MCK_PROFILE is defined (see Version.h)
+//
+//  This file has no corresponding .cpp file
+//
+//  Copyright (c) Muckytaters 2023
+//
+//  This program is free software: you can
+//  redistribute it and/or modify it under
+//  the terms of the GNU General Public License
+//  as published by the Free Software Foundation,
+//  either version 3 of the License, or (at your
+//  option) any later version.
+//
+//  This program is distributed in the hope it
+//  will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY
+//  or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU
+//  General Public License along with this
+//  program. If not, see http://www.gnu.org/license
+////////////////////////////////////////////
+
+#ifndef MCK_GAME_ENG_PROFILER_H
+#define MCK_GAME_ENG_PROFILER_H
+
+// This include must come first
+#include "Version.h"
+
+// SDL includes (Linux/Windows specific)
+// This is required if cross-compiling for Windows *on Linux*
+#ifdef MCK_MINGW
+#include <SDL.h>
+#endif
+#ifndef MCK_MINGW
+// This is required if compiling on Linux or Windows (MinGW)
+#include <SDL2/SDL.h>
+#endif
+
+#include <cstdint>
+#include <fstream>  // For ofstream
+#include <iomanip>  // For setprecision
+#include <ostream>
+#include <stdexcept>  // For exceptions
+#include <string>  // For string
+#include <vector>
+
+namespace MCK
+{
+
+//! Frame-time profiler (singleton)
+/*! Timed zones (see Zone) may be recorded by any thread.
+ *  Each is written to a lock-free ring of events, by
+ *  claiming a slot with an atomic increment, so zones
+ *  never wait for one another. Once the ring is full,
+ *  the oldest events are overwritten.
+ *  GameEng::show ends each frame (see 'end_frame'), at
+ *  which point the frame's counts (draw calls, texture
+ *  switches and render instances visited) and the range
+ *  of events recorded during it are written to a ring
+ *  of frame records.
+ *  Note: Frame records should only be queried by the
+ *        thread that calls GameEng::show.
+ */
+class GameEngProfiler
+{
+    public:
+
+        //! Maximum number of events held (must be a power of 2)
+        static const uint32_t MAX_EVENTS = 0x20000;
+
+        //! Maximum number of frames held
+        static const uint32_t MAX_FRAMES = 256;
+
+        //! Timed zone, as recorded
+        struct Event
+        {
+            //! Zone name (must be a string literal)
+            const char* name;
+
+            //! Performance counter at start of zone
+            uint64_t start_count;
+
+            //! Performance counter at end of zone
+            uint64_t end_count;
+
+            //! Thread on which zone was recorded
+            SDL_threadID thread_id;
+        };
+
+        //! Counts gathered during a frame
+        struct Counts
+        {
+            //! Number of SDL draw calls made
+            uint32_t num_draw_calls;
+
+            //! Number of draw calls using a different texture to the previous one
+            uint32_t num_texture_switches;
+
+            //! Number of render instances visited while rendering
+            uint32_t num_instances_visited;
+
+            Counts( void )
+            {
+                this->num_draw_calls = 0;
+                this->num_texture_switches = 0;
+                this->num_instances_visited = 0;
+            }
+        };
+
+        //! Record of a single frame
+        struct Frame
+        {
+            //! Frame number (counted from zero)
+            uint32_t frame_num;
+
+            //! Performance counter at start of frame (end of previous frame)
+            uint64_t start_count;
+
+            //! Performance counter at end of frame
+            uint64_t end_count;
+
+            //! Event number of first event recorded during frame
+            uint32_t first_event;
+
+            //! Event number after last event recorded during frame
+            uint32_t end_event;
+
+            //! Counts gathered during frame
+            MCK::GameEngProfiler::Counts counts;
+        };
+
+        //! Scoped timed zone
+        /*! Construct one of these at the start of a block
+         *  of code, and the time until it is destroyed
+         *  (or 'end' is called) is recorded as an event.
+         */
+        class Zone
+        {
+            public:
+
+                //! Constructor
+                /*! @param _name: Zone name (must be a string literal) */
+                Zone( const char* _name ) noexcept
+                {
+                    this->name = _name;
+                    this->start_count = SDL_GetPerformanceCounter();
+                    this->ended = false;
+                }
+
+                //! Destructor, ends zone if not already ended
+                ~Zone( void )
+                {
+                    this->end();
+                }
+
+                //! End zone early
+                void end( void ) noexcept
+                {
+                    if( !this->ended )
+                    {
+                        MCK::GameEngProfiler::get_singleton().add_event(
+                            this->name,
+                            this->start_count,
+                            SDL_GetPerformanceCounter()
+                        );
+                        this->ended = true;
+                    }
+                }
+
+            protected:
+
+                // Disabled to prevent copying,
+                // as this would cause chaos
+                Zone(Zone const&) = delete;
+                void operator=(Zone const&)  = delete;
+
+                const char* name;
+                uint64_t start_count;
+                bool ended;
+        };
+
+        //! Get singleton instance
+        static MCK::GameEngProfiler& get_singleton( void )
+        {
+            static MCK::GameEngProfiler instance;
+            return instance;
+        }
+
+        //! Get name of zone covering render blocks at given depth
+        /*! @param depth: Depth of render block (zero for top-level block) */
+        static const char* get_block_depth_zone_name( unsigned depth ) noexcept
+        {
+            static const char* const NAMES[] =
+            {
+                "render_all depth 0",
+                "render_all depth 1",
+                "render_all depth 2",
+                "render_all depth 3",
+                "render_all depth 4",
+                "render_all depth 5",
+                "render_all depth 6",
+                "render_all depth 7+"
+            };
+            return NAMES[ depth < 7 ? depth : 7 ];
+        }
+
+        //! Record event (any thread)
+        /*! @param name: Zone name (must be a string literal)
+         *  @param start_count: Performance counter at start of zone
+         *  @param end_count: Performance counter at end of zone
+         */
+        void add_event(
+            const char* name,
+            uint64_t start_count,
+            uint64_t end_count
+        ) noexcept
+        {
+            const uint32_t NUM = uint32_t(
+                SDL_AtomicAdd( &this->next_event, 1 )
+            );
+            MCK::GameEngProfiler::EventSlot &slot
+                = this->events[ NUM & ( MCK::GameEngProfiler::MAX_EVENTS - 1 ) ];
+
+            // Sequence number is cleared while event
+            // is written, so readers can detect it
+            SDL_AtomicSet( &slot.seq, 0 );
+            slot.event.name = name;
+            slot.event.start_count = start_count;
+            slot.event.end_count = end_count;
+            slot.event.thread_id = SDL_ThreadID();
+            SDL_AtomicSet( &slot.seq, int( NUM + 1 ) );
+        }
+
+        //! Add to counts of current frame (any thread)
+        void add_counts( const MCK::GameEngProfiler::Counts &counts ) noexcept
+        {
+            SDL_AtomicAdd( &this->num_draw_calls, int( counts.num_draw_calls ) );
+            SDL_AtomicAdd(
+                &this->num_texture_switches,
+                int( counts.num_texture_switches )
+            );
+            SDL_AtomicAdd(
+                &this->num_instances_visited,
+                int( counts.num_instances_visited )
+            );
+        }
+
+        //! End current frame (called by GameEng::show)
+        void end_frame( void ) noexcept
+        {
+            MCK::GameEngProfiler::Frame &frame
+                = this->frames[ this->num_frames % MCK::GameEngProfiler::MAX_FRAMES ];
+            frame.frame_num = this->num_frames;
+            frame.start_count = this->frame_start_count;
+            frame.end_count = SDL_GetPerformanceCounter();
+            frame.first_event = this->frame_first_event;
+            frame.end_event = uint32_t( SDL_AtomicGet( &this->next_event ) );
+            frame.counts.num_draw_calls
+                = uint32_t( SDL_AtomicSet( &this->num_draw_calls, 0 ) );
+            frame.counts.num_texture_switches
+                = uint32_t( SDL_AtomicSet( &this->num_texture_switches, 0 ) );
+            frame.counts.num_instances_visited
+                = uint32_t( SDL_AtomicSet( &this->num_instances_visited, 0 ) );
+
+            this->frame_start_count = frame.end_count;
+            this->frame_first_event = frame.end_event;
+            this->num_frames++;
+        }
+
+        //! Get number of frame records held
+        uint32_t get_num_frames( void ) const noexcept
+        {
+            return this->num_frames < MCK::GameEngProfiler::MAX_FRAMES
+                       ? this->num_frames
+                       : MCK::GameEngProfiler::MAX_FRAMES;
+        }
+
+        //! Get frame record
+        /*! @param age: Zero for most recent frame, one for the frame before, etc
+         *  @param frame: Frame record is written to this
+         *  @returns False if frame record no longer (or not yet) held
+         */
+        bool get_frame( uint32_t age, MCK::GameEngProfiler::Frame &frame ) const noexcept
+        {
+            if( age >= this->get_num_frames() )
+            {
+                return false;
+            }
+            frame = this->frames[
+                ( this->num_frames - 1 - age ) % MCK::GameEngProfiler::MAX_FRAMES
+            ];
+            return true;
+        }
+
+        //! Get events recorded during a frame
+        /*! @param frame: Frame record
+         *  @param frame_events: Events are appended to this
+         *  Events since overwritten (or still being written)
+         *  are left out.
+         */
+        void get_frame_events(
+            const MCK::GameEngProfiler::Frame &frame,
+            std::vector<MCK::GameEngProfiler::Event> &frame_events
+        ) const
+        {
+            // Only the most recent MAX_EVENTS events can be held
+            uint32_t first = frame.first_event;
+            const uint32_t LATEST = uint32_t( SDL_AtomicGet(
+                const_cast<SDL_atomic_t*>( &this->next_event )
+            ) );
+            if( LATEST - first > MCK::GameEngProfiler::MAX_EVENTS )
+            {
+                first = LATEST - MCK::GameEngProfiler::MAX_EVENTS;
+            }
+
+            for( uint32_t num = first; num != frame.end_event; num++ )
+            {
+                const MCK::GameEngProfiler::EventSlot &SLOT
+                    = this->events[ num & ( MCK::GameEngProfiler::MAX_EVENTS - 1 ) ];
+                SDL_atomic_t* const SEQ = const_cast<SDL_atomic_t*>( &SLOT.seq );
+                if( SDL_AtomicGet( SEQ ) != int( num + 1 ) )
+                {
+                    continue;
+                }
+                const MCK::GameEngProfiler::Event EVENT = SLOT.event;
+
+                // Check event was not overwritten while read
+                if( SDL_AtomicGet( SEQ ) == int( num + 1 ) )
+                {
+                    frame_events.push_back( EVENT );
+                }
+            }
+        }
+
+        //! Convert performance counter difference to microseconds
+        static double counts_to_microseconds( uint64_t counts ) noexcept
+        {
+            return double( counts ) * 1000000.0
+                       / double( SDL_GetPerformanceFrequency() );
+        }
+
+        //! Write frame records held (and their events) as Chrome trace JSON
+        /*! @param os: Output stream
+         *  The output can be loaded into chrome://tracing or
+         *  https://ui.perfetto.dev. Each frame's counts are
+         *  written as counter events at the end of the frame.
+         */
+        void write_chrome_trace( std::ostream &os ) const
+        {
+            os << "{\"traceEvents\":[" << std::endl
+               << std::fixed << std::setprecision( 3 );
+            bool first = true;
+
+            std::vector<MCK::GameEngProfiler::Event> frame_events;
+            for( uint32_t age = this->get_num_frames(); age-- > 0; )
+            {
+                MCK::GameEngProfiler::Frame frame;
+                this->get_frame( age, frame );
+
+                frame_events.clear();
+                this->get_frame_events( frame, frame_events );
+                for( const auto &EVENT : frame_events )
+                {
+                    // Thread IDs may be pointers, too large
+                    // for JSON numbers, so fold to 32 bits
+                    const uint64_t THREAD_ID = uint64_t( EVENT.thread_id );
+                    os << ( first ? "" : ",\n" )
+                       << "{\"name\":\"" << EVENT.name
+                       << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                       << uint32_t( THREAD_ID ^ ( THREAD_ID >> 32 ) )
+                       << ",\"ts\":" << this->get_timestamp( EVENT.start_count )
+                       << ",\"dur\":"
+                       << MCK::GameEngProfiler::counts_to_microseconds(
+                              EVENT.end_count - EVENT.start_count
+                          )
+                       << "}";
+                    first = false;
+                }
+
+                os << ( first ? "" : ",\n" )
+                   << "{\"name\":\"frame\",\"ph\":\"C\",\"pid\":1"
+                   << ",\"ts\":" << this->get_timestamp( frame.end_count )
+                   << ",\"args\":{\"draw_calls\":"
+                   << frame.counts.num_draw_calls
+                   << ",\"texture_switches\":"
+                   << frame.counts.num_texture_switches
+                   << ",\"instances_visited\":"
+                   << frame.counts.num_instances_visited
+                   << "}}";
+                first = false;
+            }
+
+            os << std::endl << "]}" << std::endl;
+        }
+
+        //! Save frame records held (and their events) as Chrome trace JSON file
+        /*! @param filename: Name of file to write */
+        void save_chrome_trace( const std::string &filename ) const
+        {
+            std::ofstream file( filename );
+            if( !file )
+            {
+                throw( std::runtime_error(
+#if defined MCK_STD_OUT
+                    std::string( "Cannot save profile, as failed to open " )
+                    + filename
+#else
+                    ""
+#endif
+                ) );
+            }
+            this->write_chrome_trace( file );
+        }
+
+    protected:
+
+        //! Constructor, private as singleton
+        GameEngProfiler( void )
+            : events( MCK::GameEngProfiler::MAX_EVENTS ),
+              frames( MCK::GameEngProfiler::MAX_FRAMES )
+        {
+            SDL_AtomicSet( &this->next_event, 0 );
+            SDL_AtomicSet( &this->num_draw_calls, 0 );
+            SDL_AtomicSet( &this->num_texture_switches, 0 );
+            SDL_AtomicSet( &this->num_instances_visited, 0 );
+            this->start_count = SDL_GetPerformanceCounter();
+            this->frame_start_count = this->start_count;
+            this->frame_first_event = 0;
+            this->num_frames = 0;
+        }
+
+        // Disabled to prevent copying,
+        // as this would cause chaos
+        GameEngProfiler(GameEngProfiler const&) = delete;
+        void operator=(GameEngProfiler const&)  = delete;
+
+        //! Slot in ring of events
+        struct EventSlot
+        {
+            MCK::GameEngProfiler::Event event;
+
+            //! Event number plus one, or zero while event written
+            SDL_atomic_t seq;
+
+            EventSlot( void )
+            {
+                SDL_AtomicSet( &this->seq, 0 );
+            }
+        };
+
+        //! Get microseconds since profiler created
+        double get_timestamp( uint64_t count ) const noexcept
+        {
+            return MCK::GameEngProfiler::counts_to_microseconds(
+                count - this->start_count
+            );
+        }
+
+        //! Ring of events
+        std::vector<MCK::GameEngProfiler::EventSlot> events;
+
+        //! Number of next event to be recorded
+        SDL_atomic_t next_event;
+
+        //! Ring of frame records
+        std::vector<MCK::GameEngProfiler::Frame> frames;
+
+        //! Number of frames ended
+        uint32_t num_frames;
+
+        //! Counts of current frame
+        SDL_atomic_t num_draw_calls;
+        SDL_atomic_t num_texture_switches;
+        SDL_atomic_t num_instances_visited;
+
+        //! Performance counter when profiler created
+        uint64_t start_count;
+
+        //! Performance counter at start of current frame
+        uint64_t frame_start_count;
+
+        //! Event number of first event of current frame
+        uint32_t frame_first_event;
+};
+
+}  // End of namespace MCK
+
+#endif
@@ -180,11 +180,44 @@ class GameEngRenderBase
         //! This variable indicates that more than 2^32 IDs exist
         static bool duplicate_ids_exist;
 
+        //! This variable keeps record of next available block revision
+        /*! 64 bits wide, so that it never wraps around */
+        static uint64_t next_revision;
+
+        //! Mark bounds of block as out of date
+        /*! This is defined in GameEngRenderBase.cpp, as
+         *  GameEngRenderBlock is incomplete here.
+         */
+        static void invalidate_bounds(
+            const MCK::GameEngRenderBlock* block
+        ) noexcept;
+
+        //! Mark draw commands of block's own render instances as out of date
+        /*! This is defined in GameEngRenderBase.cpp, as
+         *  GameEngRenderBlock is incomplete here.
+         */
+        static void content_changed(
+            const MCK::GameEngRenderBlock* block
+        ) noexcept;
+
+        //! Detach instance from its parent block
+        /*! Called by a block's destructor, so that its
+         *  render instances never hold a dangling pointer.
+         */
+        static void orphan( MCK::GameEngRenderBase* instance ) noexcept
+        {
+            instance->parent_block = NULL;
+        }
+
         // Pointer to parent block, only accessible through
         // friend access (GameEng). This pointer should only
         // be used to ensure parent is correct, not to access
         // the parent (for safety it is best not to actually
-        // dereference this pointer)
+        // dereference this pointer). The exceptions are
+        // 'invalidate_bounds' and 'content_changed', which
+        // are safe because the pointer is cleared when the
+        // instance is removed from its parent, or its
+        // parent is destroyed.
         const MCK::GameEngRenderBlock* parent_block;
 
         // Dummy method to make this class abstract
@@ -36,9 +36,15 @@
 
 #include <vector>
 #include <stdexcept>
+#include <algorithm>  // For min, max
+#include <cmath>  // For floor
+#include <limits>  // For numeric_limits
+#include <memory>  // For shared_ptr
 
 #include "GameEngRenderBase.h"
 #include "GameEngRenderInfo.h"
+#include "GameEngTileMap.h"
+#include "GameEngRenderInstanceVec.h"
 
 namespace MCK
 {
@@ -53,6 +59,7 @@ class GameEngRenderBlock : public GameEngRenderBase
 {
     //! Friendship so GameEng can access protected/private members
     friend class GameEng;
+    friend class GameEngRenderBase;
 
     /*
     template<class MOTION, class ANIM, class COLL, class RENDER>
@@ -71,6 +78,16 @@ class GameEngRenderBlock : public GameEngRenderBase
         //! Optional vertical offset (in screen pixels)
         int16_t vert_offset;
 
+        //! Optional fraction of a pixel, added to 'hoz_offset'
+        /*! Only used by sub-pixel rendering
+         *  (see GameEng::set_sub_pixel_render) */
+        float hoz_sub_offset;
+
+        //! Optional fraction of a pixel, added to 'vert_offset'
+        /*! Only used by sub-pixel rendering
+         *  (see GameEng::set_sub_pixel_render) */
+        float vert_sub_offset;
+
         //! Default constructor
         GameEngRenderBlock( uint32_t z = MCK::DEFAULT_Z_VALUE )
             : GameEngRenderBase( z )
@@ -78,9 +95,41 @@ class GameEngRenderBlock : public GameEngRenderBase
             this->active = true;
             this->hoz_offset = 0;
             this->vert_offset = 0;
+            this->hoz_sub_offset = 0.0f;
+            this->vert_sub_offset = 0.0f;
 
             this->type = MCK::RenderInstanceType::BLOCK;
 
+            this->bounds.x = 0;
+            this->bounds.y = 0;
+            this->bounds.w = 0;
+            this->bounds.h = 0;
+
+            this->mark_changed();
+            this->content_changed();
+        }
+
+        //! Destructor
+        virtual ~GameEngRenderBlock( void )
+        {
+            // Detach render instances, which may outlive
+            // this block
+            for( auto &ri : this->render_instances )
+            {
+                if( ri.second.get() != NULL )
+                {
+                    MCK::GameEngRenderBase::orphan( ri.second.get() );
+                }
+            }
+
+            // Stop any compiled render list referring
+            // to this block
+            MCK::GameEngRenderBlock::DestroyFunc const DESTROY
+                = MCK::GameEngRenderBlock::destroy_func();
+            if( DESTROY != NULL )
+            {
+                DESTROY( this );
+            }
         }
 
         //! Returns true if block contains no render instances, i.e. images or other blocks
@@ -89,16 +138,18 @@ class GameEngRenderBlock : public GameEngRenderBase
             return render_instances.size() == 0;
         }
 
-        //! Set x position
+        //! Set x position (clearing any fraction of a pixel)
         virtual void set_x( int x ) noexcept
         {
             hoz_offset = x;
+            hoz_sub_offset = 0.0f;
         }
 
-        //! Set y position
+        //! Set y position (clearing any fraction of a pixel)
         virtual void set_y( int y ) noexcept
         {
             vert_offset = y;
+            vert_sub_offset = 0.0f;
         }
 
         //! Get x position
@@ -141,20 +192,63 @@ class GameEngRenderBlock : public GameEngRenderBase
             return 0;
         };
         
-        //! Set position
+        //! Set position (clearing any fraction of a pixel)
         virtual void set_pos( int x, int y ) noexcept
         {
             hoz_offset = x;
             vert_offset = y;
+            hoz_sub_offset = 0.0f;
+            vert_sub_offset = 0.0f;
         }
 
         //! Adjust position
+        /*! Any fraction of a pixel (see 'set_pos_f') is kept,
+         *  as the block moves by whole pixels.
+         */
         virtual void adj_pos( int dx, int dy ) noexcept
         {
             hoz_offset += dx;
             vert_offset += dy;
         }
 
+        //! Set position, to a fraction of a pixel
+        /*! Sets 'hoz_offset' and 'vert_offset' to the whole
+         *  pixels (rounded down), and 'hoz_sub_offset' and
+         *  'vert_sub_offset' to the remaining fractions.
+         *  Positions beyond the range of 'hoz_offset' and
+         *  'vert_offset' are clamped (with no fraction), and
+         *  NaN is treated as zero.
+         */
+        void set_pos_f( float x, float y ) noexcept
+        {
+            const float X_FLOOR = MCK::GameEngRenderBlock::floor_offset( x );
+            const float Y_FLOOR = MCK::GameEngRenderBlock::floor_offset( y );
+            hoz_offset = int16_t( X_FLOOR );
+            vert_offset = int16_t( Y_FLOOR );
+            hoz_sub_offset
+                = ( x >= X_FLOOR && x < X_FLOOR + 1.0f ) ? x - X_FLOOR : 0.0f;
+            vert_sub_offset
+                = ( y >= Y_FLOOR && y < Y_FLOOR + 1.0f ) ? y - Y_FLOOR : 0.0f;
+        }
+
+        //! Adjust position, by a fraction of a pixel
+        void adj_pos_f( float dx, float dy ) noexcept
+        {
+            this->set_pos_f( this->get_x_f() + dx, this->get_y_f() + dy );
+        }
+
+        //! Get x position, including fraction of a pixel
+        float get_x_f( void ) const noexcept
+        {
+            return float( hoz_offset ) + hoz_sub_offset;
+        }
+
+        //! Get y position, including fraction of a pixel
+        float get_y_f( void ) const noexcept
+        {
+            return float( vert_offset ) + vert_sub_offset;
+        }
+
         virtual void render( SDL_Renderer* renderer ) const
         {
             // TODO
@@ -163,16 +257,179 @@ class GameEngRenderBlock : public GameEngRenderBase
 
     protected :
 
-        //! Map of render instances subserviant to this block
+        //! Round offset down, clamped to range of int16_t (NaN gives zero)
+        static float floor_offset( float val ) noexcept
+        {
+            // Note: Comparisons with NaN are false
+            if( !( val >= float( std::numeric_limits<int16_t>::min() ) ) )
+            {
+                return val < 0.0f
+                           ? float( std::numeric_limits<int16_t>::min() )
+                           : 0.0f;
+            }
+            if( val >= float( std::numeric_limits<int16_t>::max() ) )
+            {
+                return float( std::numeric_limits<int16_t>::max() );
+            }
+            return std::floor( val );
+        }
+
+        //! Render instances subserviant to this block
         /*! The key is the 'render_order' of the associated
          *  render instance, comprised of 'z' value (32 most
          *  significant bits) and render instance ID (32 least
          *  significant bits).
-         *  This is a 'multimap' to account for the possibility
-         *  of duplicate IDs if more than 2^32 instances are 
-         *  created.
+         *  Duplicate keys are allowed, to account for the
+         *  possibility of duplicate IDs if more than 2^32
+         *  instances are created.
+         */
+        MCK::GameEngRenderInstanceVec render_instances;
+
+        //! Revision number, changes whenever 'render_instances' changes
+        /*! Used by GameEngRenderList to detect which parts of
+         *  a compiled render list need re-compiling.
+         *  Revision numbers are unique across all blocks,
+         *  so a new block never shares the revision of an
+         *  old one.
          */
-        std::multimap<uint64_t,std::shared_ptr<MCK::GameEngRenderBase>> render_instances;
+        uint64_t revision;
+
+        //! Record that 'render_instances' has changed
+        void mark_changed( void ) noexcept
+        {
+            this->revision = ++MCK::GameEngRenderBase::next_revision;
+            this->bounds_dirty = true;
+        }
+
+        //! Flag to indicate 'bounds' and 'sub_blocks' are out of date
+        mutable bool bounds_dirty;
+
+        //! Bounding rectangle of this block's own render infos
+        /*! This is in block coordinates, i.e. it excludes
+         *  the offsets of this block and its ancestors.
+         *  Sub-blocks are *not* included, as their offsets
+         *  may change at any time (they are public), so
+         *  they are tested individually.
+         *  A width of zero indicates no render infos.
+         */
+        mutable SDL_Rect bounds;
+
+        //! Sub-blocks of this block, in render order
+        /*! Allows off-screen blocks to skip their render
+         *  infos without iterating 'render_instances'.
+         */
+        mutable std::vector<const MCK::GameEngRenderBlock*> sub_blocks;
+
+        //! Content revision, changes whenever anything drawn by this block's own render instances changes
+        /*! Used by GameEngRenderList to detect which draw
+         *  commands of a compiled render list need
+         *  regenerating. Like 'revision', this is unique
+         *  across all blocks.
+         */
+        mutable uint64_t content_revision;
+
+        //! Record that something drawn by this block's own render instances has changed
+        /*! Called when a render info in this block changes
+         *  texture, clipping or colo(u)r, or when a tile map
+         *  in this block changes its cells.
+         */
+        void content_changed( void ) const noexcept
+        {
+            this->content_revision = ++MCK::GameEngRenderBase::next_revision;
+        }
+
+        //! Mark 'bounds' (and draw commands) as out of date
+        /*! Called when a render info in this block moves */
+        void invalidate_bounds( void ) const noexcept
+        {
+            this->bounds_dirty = true;
+            this->content_changed();
+        }
+
+        //! Recalculate 'bounds' and 'sub_blocks', if out of date
+        void update_bounds( void ) const
+        {
+            if( !this->bounds_dirty )
+            {
+                return;
+            }
+
+            this->sub_blocks.clear();
+            int x_min = 0;
+            int y_min = 0;
+            int x_max = 0;
+            int y_max = 0;
+            bool empty = true;
+            SDL_Rect info_bounds;
+
+            for( const auto &ri : this->render_instances )
+            {
+                const MCK::GameEngRenderBase* const INSTANCE = ri.second.get();
+                if( INSTANCE == NULL )
+                {
+                    continue;
+                }
+
+                if( INSTANCE->get_type() == MCK::RenderInstanceType::BLOCK )
+                {
+                    this->sub_blocks.push_back(
+                        static_cast<const MCK::GameEngRenderBlock*>( INSTANCE )
+                    );
+                    continue;
+                }
+
+                if( INSTANCE->get_type() == MCK::RenderInstanceType::TILE_MAP )
+                {
+                    static_cast<const MCK::GameEngTileMap*>(
+                        INSTANCE
+                    )->get_bounds( info_bounds );
+                }
+                else
+                {
+                    static_cast<const MCK::GameEngRenderInfo*>(
+                        INSTANCE
+                    )->get_bounds( info_bounds );
+                }
+
+                if( empty )
+                {
+                    x_min = info_bounds.x;
+                    y_min = info_bounds.y;
+                    x_max = info_bounds.x + info_bounds.w;
+                    y_max = info_bounds.y + info_bounds.h;
+                    empty = false;
+                }
+                else
+                {
+                    x_min = std::min( x_min, info_bounds.x );
+                    y_min = std::min( y_min, info_bounds.y );
+                    x_max = std::max( x_max, info_bounds.x + info_bounds.w );
+                    y_max = std::max( y_max, info_bounds.y + info_bounds.h );
+                }
+            }
+
+            this->bounds.x = x_min;
+            this->bounds.y = y_min;
+            this->bounds.w = x_max - x_min;
+            this->bounds.h = y_max - y_min;
+            this->bounds_dirty = false;
+        }
+
+        //! Function called when a block is destroyed
+        typedef void (*DestroyFunc)( const MCK::GameEngRenderBlock* block );
+
+        //! Get function called when a block is destroyed
+        /*! This is set by GameEng, and is NULL when no
+         *  GameEng exists. It allows a compiled render list
+         *  to be discarded when its top-level block is
+         *  destroyed, so the list never refers to a new
+         *  block allocated at the same address.
+         */
+        static DestroyFunc& destroy_func( void ) noexcept
+        {
+            static DestroyFunc func = NULL;
+            return func;
+        }
 
         // Dummy method to this class non-abstract
         void dummy( void ) {}
@@ -35,6 +35,8 @@
 #ifndef MCK_GAME_ENG_RI_H
 #define MCK_GAME_ENG_RI_H
 
+#include <utility>  // For swap
+
 #include "GameEngRenderBase.h"
 
 namespace MCK
@@ -44,6 +46,7 @@ namespace MCK
 class GameEngRenderBlock;
 class SpriteAnimTime;
 class SpriteAnimDist;
+class GameEngTileMap;
 
 class GameEngRenderInfo : public GameEngRenderBase
 {
@@ -51,6 +54,7 @@ class GameEngRenderInfo : public GameEngRenderBase
     friend class GameEng;
     friend class SpriteAnimTime;
     friend class SpriteAnimDist;
+    friend class GameEngTileMap;
 
     public:
 
@@ -86,21 +90,38 @@ class GameEngRenderInfo : public GameEngRenderBase
             }
     
             //! Set left position of rectangle
-            void set_x( int val ) noexcept { this->r.x = val; }
+            void set_x( int val ) noexcept
+            {
+                this->r.x = val;
+                this->changed();
+            }
             
             //! Set top position of rectangle
-            void set_y( int val ) noexcept { this->r.y = val; }
+            void set_y( int val ) noexcept
+            {
+                this->r.y = val;
+                this->changed();
+            }
 
             //! Set width of rectangle
-            void set_w( int val ) noexcept { this->r.w = val; }
+            void set_w( int val ) noexcept
+            {
+                this->r.w = val;
+                this->changed();
+            }
 
             //! Set height of rectangle
-            void set_h( int val ) noexcept { this->r.h = val; }
+            void set_h( int val ) noexcept
+            {
+                this->r.h = val;
+                this->changed();
+            }
 
             void set_pos( int x, int y ) noexcept
             {
                 this->r.x = x;
                 this->r.y = y;
+                this->changed();
             }
 
             void set_all( int x, int y, int w, int h ) noexcept
@@ -110,12 +131,14 @@ class GameEngRenderInfo : public GameEngRenderBase
                 rct.y = y;
                 rct.w = w;
                 rct.h = h;
+                this->changed();
             }
 
             void adj_pos( int dx, int dy ) noexcept
             {
                 this->r.x += dx;
                 this->r.y += dy;
+                this->changed();
             }
 
             //! Default constructor
@@ -125,6 +148,22 @@ class GameEngRenderInfo : public GameEngRenderBase
                 this->r.y = 0;
                 this->r.w = 0;
                 this->r.h = 0;
+                this->owner = NULL;
+            }
+
+            //! Copy constructor (owner is not copied)
+            Rect( const Rect &other )
+            {
+                this->r = other.r;
+                this->owner = NULL;
+            }
+
+            //! Assignment (owner is retained, and notified of change)
+            Rect& operator=( const Rect &other ) noexcept
+            {
+                this->r = other.r;
+                this->changed();
+                return *this;
             }
 
             //! Constructor
@@ -139,12 +178,65 @@ class GameEngRenderInfo : public GameEngRenderBase
                 this->r.y = _y;
                 this->r.w = _w;
                 this->r.h = _h;
+                this->owner = NULL;
             }
             
             private:
 
                 //! SDL rectangle is private so direct use is only by GameEng
                 SDL_Rect r;
+
+                //! Render info to notify when rectangle changes (NULL if none)
+                MCK::GameEngRenderInfo* owner;
+
+                //! Notify owner (if any) of change
+                void changed( void ) noexcept
+                {
+                    if( this->owner != NULL )
+                    {
+                        this->owner->rect_changed();
+                    }
+                }
+        };
+
+        //! Texture resolved in advance, so it can be used without look up
+        /*! Obtained from GameEng::acquire_tex_handle, and passed
+         *  to GameEng::set_render_info_tex_handle.
+         *  Note: A handle holds a reference to its texture
+         *        (so the texture cannot be evicted) until
+         *        released, which is *not* done automatically,
+         *        as handles are copyable.
+         */
+        struct TexHandle
+        {
+            //! Friendship to access protected/private members
+            friend class GameEng;
+            friend class GameEngTileMap;
+
+            //! Get ID of texture, MCK::INVALID_TEX_ID if not acquired
+            MCK_TEX_ID_TYPE get_tex_id( void ) const noexcept
+            {
+                return this->tex_id;
+            }
+
+            //! Default constructor
+            TexHandle( void )
+            {
+                this->tex_id = MCK::INVALID_TEX_ID;
+                this->tex = NULL;
+                this->in_atlas = false;
+                this->atlas_rect.x = 0;
+                this->atlas_rect.y = 0;
+                this->atlas_rect.w = 0;
+                this->atlas_rect.h = 0;
+            }
+
+            private:
+
+                MCK_TEX_ID_TYPE tex_id;
+                SDL_Texture* tex;
+                bool in_atlas;
+                SDL_Rect atlas_rect;
         };
 
         //! Texture ID
@@ -220,6 +312,10 @@ class GameEngRenderInfo : public GameEngRenderBase
         }
 
         //! Flag to indicate whether clipping rectangle used
+        /*! Note: If changed directly, rather than by 'set_clip',
+         *        the compiled render list will not notice
+         *        (see GameEng::set_compiled_render_list).
+         */
         bool clip;
 
         //! Clipping rectangle for source texture
@@ -228,6 +324,75 @@ class GameEngRenderInfo : public GameEngRenderBase
          */
         MCK::GameEngRenderInfo::Rect clip_rect;
 
+        //! Colo(u)r modulation, applied when rendered
+        /*! White (the default) leaves the texture unchanged.
+         *  Used to apply a local palette to palette-indexed
+         *  images (see GameEng::create_indexed_render_block).
+         *  Images with zero alpha here are not rendered.
+         *  Note: If changed directly, rather than by
+         *        'set_color_mod', the compiled render list
+         *        will not notice (see
+         *        GameEng::set_compiled_render_list).
+         */
+        SDL_Color color_mod;
+
+        //! Set flag to indicate whether clipping rectangle used
+        void set_clip( bool val ) noexcept
+        {
+            this->clip = val;
+            this->content_changed();
+        }
+
+        //! Set colo(u)r modulation
+        void set_color_mod( const SDL_Color &col ) noexcept
+        {
+            this->color_mod = col;
+            this->content_changed();
+        }
+
+        //! Returns true if colo(u)r modulation is not white
+        bool has_color_mod( void ) const noexcept
+        {
+            return MCK::GameEngRenderInfo::is_color_mod(
+                this->color_mod
+            );
+        }
+
+        //! Returns true if colo(u)r would modulate a texture (i.e. is not white)
+        static bool is_color_mod( const SDL_Color &col ) noexcept
+        {
+            return ( col.r & col.g & col.b & col.a ) != 0xFF;
+        }
+
+        //! Set colo(u)r modulation of texture (if not white)
+        /*! @param tex: Texture
+         *  @param col: Colo(u)r modulation
+         *  @returns True if modulation applied, in which
+         *           case 'clear_tex_color_mod' should be
+         *           called after rendering (as textures
+         *           may be shared).
+         */
+        static bool set_tex_color_mod(
+            SDL_Texture* tex,
+            const SDL_Color &col
+        ) noexcept
+        {
+            if( !MCK::GameEngRenderInfo::is_color_mod( col ) )
+            {
+                return false;
+            }
+            SDL_SetTextureColorMod( tex, col.r, col.g, col.b );
+            SDL_SetTextureAlphaMod( tex, col.a );
+            return true;
+        }
+
+        //! Remove colo(u)r modulation from texture
+        static void clear_tex_color_mod( SDL_Texture* tex ) noexcept
+        {
+            SDL_SetTextureColorMod( tex, 0xFF, 0xFF, 0xFF );
+            SDL_SetTextureAlphaMod( tex, 0xFF );
+        }
+
         //! Get rotation, as multiple of 90 degrees
         int get_rotation( void ) const noexcept
         {
@@ -247,6 +412,105 @@ class GameEngRenderInfo : public GameEngRenderBase
             return ( this->flags & MCK::GameEngRenderInfo::FLIP_Y_MASK ) > 0;
         }
 
+        //! Get area of game window covered when rendered
+        /*! @param rect: Bounding rectangle, in screen pixels
+         *  This is 'dest_rect', unless rotated by 90 or 270
+         *  degrees, in which case the (conservative) bounds of
+         *  the rotated rectangle are given.
+         */
+        void get_bounds( SDL_Rect &rect ) const noexcept
+        {
+            MCK::GameEngRenderInfo::calc_bounds(
+                this->dest_rect.r,
+                this->flags,
+                rect
+            );
+        }
+
+        //! Calculate area covered by a destination rectangle and flags
+        /*! @param dest: Destination rectangle
+         *  @param _flags: Rotation and flip flags (see 'calc_flags')
+         *  @param rect: Bounding rectangle
+         */
+        static void calc_bounds(
+            const SDL_Rect &dest,
+            uint8_t _flags,
+            SDL_Rect &rect
+        ) noexcept
+        {
+            rect = dest;
+
+            // Rotated about centre, so width and height swap
+            if( ( ( ( _flags & MCK::GameEngRenderInfo::ROTATION_MASK )
+                        >> MCK::GameEngRenderInfo::ROTATION_RSHIFT ) & 1
+                )
+                && rect.w != rect.h
+            )
+            {
+                const int HALF_DIFF = ( rect.w - rect.h ) / 2;
+                rect.x += HALF_DIFF - 1;
+                rect.y -= HALF_DIFF + 1;
+                std::swap( rect.w, rect.h );
+                rect.w += 2;
+                rect.h += 2;
+            }
+        }
+
+        //! Calculate rotation angle and flip of flags, as used by SDL_RenderCopyEx
+        /*! @param _flags: Rotation and flip flags (see 'calc_flags')
+         *  @param angle: Rotation angle (in degrees)
+         *  @param flip: Flip
+         */
+        static void calc_angle_and_flip(
+            uint8_t _flags,
+            double &angle,
+            SDL_RendererFlip &flip
+        ) noexcept
+        {
+            angle = (
+                        ( _flags & MCK::GameEngRenderInfo::ROTATION_MASK )
+                            >> MCK::GameEngRenderInfo::ROTATION_RSHIFT
+                    ) * 90.0;
+
+            flip = SDL_FLIP_NONE;
+            if( _flags & MCK::GameEngRenderInfo::FLIP_X_MASK )
+            {
+                flip = SDL_RendererFlip( flip | SDL_FLIP_HORIZONTAL );
+            }
+            if( _flags & MCK::GameEngRenderInfo::FLIP_Y_MASK )
+            {
+                flip = SDL_RendererFlip( flip | SDL_FLIP_VERTICAL );
+            }
+        }
+
+        //! Returns true if texture is held in a texture atlas
+        bool is_in_atlas( void ) const noexcept
+        {
+            return this->in_atlas;
+        }
+
+        //! Get source rectangle within texture
+        /*! @param buffer: Storage used if rectangle needs to be calculated
+         *  @returns Pointer to source rectangle, or NULL for entire texture
+         *  If the texture is held in an atlas, 'clip_rect'
+         *  is offset to the image's position in the atlas.
+         */
+        const SDL_Rect* get_src_rect( SDL_Rect &buffer ) const noexcept
+        {
+            if( !this->in_atlas )
+            {
+                return this->clip ? &this->clip_rect.r : NULL;
+            }
+            if( !this->clip )
+            {
+                return &this->atlas_rect;
+            }
+            buffer = this->clip_rect.r;
+            buffer.x += this->atlas_rect.x;
+            buffer.y += this->atlas_rect.y;
+            return &buffer;
+        }
+
         //! Default constructor
         GameEngRenderInfo( uint32_t z = MCK::DEFAULT_Z_VALUE )
             : GameEngRenderBase( z )
@@ -255,56 +519,94 @@ class GameEngRenderInfo : public GameEngRenderBase
             this->flags = 0x00;
             this->tex_id = 0;
             this->tex = NULL;
+            this->dest_rect.owner = this;
+            this->clip_rect.owner = this;
+            this->in_atlas = false;
+            this->atlas_rect.x = 0;
+            this->atlas_rect.y = 0;
+            this->atlas_rect.w = 0;
+            this->atlas_rect.h = 0;
+            this->color_mod.r = 0xFF;
+            this->color_mod.g = 0xFF;
+            this->color_mod.b = 0xFF;
+            this->color_mod.a = 0xFF;
+            this->tex_ref = false;
             
             this->type = MCK::RenderInstanceType::INFO;
         }
 
+        //! Destructor
+        /*! Releases this info's reference to its texture,
+         *  so that GameEng may evict the texture once no
+         *  render info uses it (see 'set_texture_budget').
+         */
+        virtual ~GameEngRenderInfo( void )
+        {
+            MCK::GameEngRenderInfo::TexReleaseFunc const RELEASE
+                = MCK::GameEngRenderInfo::tex_release_func();
+            if( this->tex_ref && RELEASE != NULL )
+            {
+                RELEASE( this->tex_id );
+            }
+        }
+
         //! Render
         virtual void render( SDL_Renderer* renderer ) const
         {
             // Let calling method catch any exceptions
 
+            // Ignore images made invisible by colo(u)r modulation
+            if( this->color_mod.a == 0 )
+            {
+                return;
+            }
+
+            // Get source rectangle
+            SDL_Rect src_buffer;
+            const SDL_Rect* const SRC_RECT = this->get_src_rect( src_buffer );
+
+            const bool COLOR_MOD
+                = MCK::GameEngRenderInfo::set_tex_color_mod(
+                    this->tex,
+                    this->color_mod
+                );
+
             // If no flags, use simpler command
             if( this->flags == 0 )
             {
                 SDL_RenderCopy(
                     renderer,
                     this->tex,
-                    this->clip ? &this->clip_rect.r : NULL,
+                    SRC_RECT,
                     &this->dest_rect.r
                 );
             }
             else
             {
-                // Get rotation angle (in degrees)
-                const double ANGLE
-                    = ( 
-                        ( this->flags & MCK::GameEngRenderInfo::ROTATION_MASK )
-                            >> MCK::GameEngRenderInfo::ROTATION_RSHIFT
-                    ) * 90.0f;
-            
-                // Get flip
-                // TODO: Make this more efficient
-                SDL_RendererFlip flip = SDL_FLIP_NONE;
-                if( this->get_flip_x() )
-                {
-                    flip = SDL_RendererFlip( flip | SDL_FLIP_HORIZONTAL );
-                }
-                if( this->get_flip_y() )
-                {
-                    flip = SDL_RendererFlip( flip | SDL_FLIP_VERTICAL );
-                }
+                // Get rotation angle (in degrees) and flip
+                double angle;
+                SDL_RendererFlip flip;
+                MCK::GameEngRenderInfo::calc_angle_and_flip(
+                    this->flags,
+                    angle,
+                    flip
+                );
                 
                 SDL_RenderCopyEx(
                     renderer,
                     this->tex,  // Convert from shared_ptr
-                    this->clip ? &this->clip_rect.r : NULL,
+                    SRC_RECT,
                     &this->dest_rect.r,
-                    ANGLE,
+                    angle,
                     NULL,  // Rotate about centre
                     flip
                 );
             }
+
+            if( COLOR_MOD )
+            {
+                MCK::GameEngRenderInfo::clear_tex_color_mod( this->tex );
+            }
         } 
             
         //! Calculate flag byte
@@ -327,6 +629,30 @@ class GameEngRenderInfo : public GameEngRenderBase
         void set_flags( uint8_t _flags ) noexcept
         {
             this->flags = _flags;
+            this->rect_changed();  // Rotation affects bounds
+        }
+
+        //! Called whenever 'dest_rect' or 'clip_rect' changes
+        /*! Invalidates bounds of parent block, for culling */
+        void rect_changed( void ) noexcept
+        {
+            if( this->parent_block != NULL )
+            {
+                MCK::GameEngRenderBase::invalidate_bounds( this->parent_block );
+            }
+        }
+
+        //! Called whenever texture, clipping or colo(u)r modulation changes
+        /*! Marks draw commands of parent block as out of date,
+         *  for the compiled render list (see
+         *  GameEng::set_compiled_render_list)
+         */
+        void content_changed( void ) noexcept
+        {
+            if( this->parent_block != NULL )
+            {
+                MCK::GameEngRenderBase::content_changed( this->parent_block );
+            }
         }
 
         // Disabled to prevent copying,
@@ -346,6 +672,34 @@ class GameEngRenderInfo : public GameEngRenderBase
         //! Flags to indicate rotation and flipping
         /*! See flag masks */
         uint8_t flags;
+
+        //! Flag to indicate texture is held in a texture atlas
+        bool in_atlas;
+
+        //! Position of image within texture atlas
+        /*! Only used if 'in_atlas' is true */
+        SDL_Rect atlas_rect;
+
+        //! Flag to indicate this info holds a reference to texture 'tex_id'
+        /*! Set by GameEng, which counts references so that
+         *  textures in use are never evicted.
+         */
+        bool tex_ref;
+
+        //! Function that releases a texture reference
+        typedef void (*TexReleaseFunc)( MCK_TEX_ID_TYPE tex_id );
+
+        //! Get function that releases a texture reference
+        /*! This is set by GameEng, and is NULL when no
+         *  GameEng exists (e.g. during exit). It is a
+         *  function-local static, so that this header
+         *  needs no corresponding .cpp file.
+         */
+        static TexReleaseFunc& tex_release_func( void ) noexcept
+        {
+            static TexReleaseFunc func = NULL;
+            return func;
+        }
         
         // Dummy method to this class non-abstract
         void dummy( void ) {}
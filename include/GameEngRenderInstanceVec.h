@@ -0,0 +1,393 @@
+////////////////////////////////////////////
+//  ------------------------------------
+//  ---MUCKY VISION 3 (BASIC ENGINE) ---
+//  ------------------------------------
+//
+//  GameEngRenderInstanceVec.h
+//
+//  Contiguous container of render instances,
+//  sorted by render order, used by render
+//  blocks in place of a multimap
+//
+//  This file has no corresponding .cpp file
+//
+//  Copyright (c) Muckytaters 2023
+//
+//  This program is free software: you can
+//  redistribute it and/or modify it under
+//  the terms of the GNU General Public License
+//  as published by the Free Software Foundation,
+//  either version 3 of the License, or (at your
+//  option) any later version.
+//
+//  This program is distributed in the hope it
+//  will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY
+//  or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU
+//  General Public License along with this
+//  program. If not, see http://www.gnu.org/license
+////////////////////////////////////////////
+
+#ifndef MCK_GAME_ENG_RIV_H
+#define MCK_GAME_ENG_RIV_H
+
+#include <cstdint>  // For uint64_t et al.
+#include <vector>
+#include <memory>  // For shared_ptr
+#include <utility>  // For pair, move
+#include <algorithm>  // For remove_if, stable_sort, equal_range
+
+namespace MCK
+{
+
+class GameEngRenderBase;
+
+//! Render instances of a block, in render order
+/*! Instances are held in a single vector of
+ *  (render order, instance) pairs, so iteration
+ *  is cache-friendly. To keep changes cheap:
+ *  - Insertion appends to the vector.
+ *  - Removal leaves a 'tombstone' (NULL instance)
+ *    in place.
+ *  - Changing a key does not move the entry.
+ *  Only 'erase' and 'change_key' keep iterators
+ *  valid. As with std::vector, 'insert' may
+ *  reallocate, invalidating all iterators, and
+ *  'begin' may re-sort, so neither should be
+ *  called while iterating.
+ *  The vector is re-sorted (and tombstones removed)
+ *  lazily, the next time 'begin' is called, which
+ *  is typically once per frame during render.
+ *  Searching ('find_instance') never re-sorts, so
+ *  many changes per frame cost a single re-sort.
+ *  Iteration mimics that of std::multimap, yielding
+ *  pairs ('first' is the render order, 'second' the
+ *  instance).
+ */
+class GameEngRenderInstanceVec
+{
+    public:
+
+        typedef std::pair<
+            uint64_t,
+            std::shared_ptr<MCK::GameEngRenderBase>
+        > value_type;
+        typedef std::vector<value_type>::iterator iterator;
+        typedef std::vector<value_type>::const_iterator const_iterator;
+
+        //! Default constructor
+        GameEngRenderInstanceVec( void )
+        {
+            this->num_live = 0;
+            this->num_sorted = 0;
+            this->has_tombstones = false;
+        }
+
+        //! Get number of instances (excluding tombstones)
+        size_t size( void ) const noexcept
+        {
+            return this->num_live;
+        }
+
+        //! Returns true if no instances held (excluding tombstones)
+        bool empty( void ) const noexcept
+        {
+            return this->num_live == 0;
+        }
+
+        //! Add instance (amortized constant time)
+        void insert( const value_type &val )
+        {
+            // Sorted prefix only grows while entries
+            // are appended in order
+            if( this->num_sorted == this->entries.size()
+                && ( this->entries.empty()
+                     || val.first >= this->entries.back().first
+                   )
+            )
+            {
+                this->num_sorted++;
+            }
+            this->entries.push_back( val );
+            if( val.second.get() != NULL )
+            {
+                this->num_live++;
+            }
+            else
+            {
+                this->has_tombstones = true;
+            }
+        }
+
+        //! Remove instance (constant time)
+        /*! @param it: Iterator to instance to remove
+         *  @returns Iterator to following entry
+         *  Note: Other iterators remain valid, and iterating
+         *        continues to visit the removed entry (as
+         *        a NULL instance) until the next tidy.
+         */
+        iterator erase( iterator it ) noexcept
+        {
+            if( it->second.get() != NULL )
+            {
+                it->second.reset();
+                this->num_live--;
+            }
+            this->has_tombstones = true;
+            return it + 1;
+        }
+
+        //! Change render order of an instance (amortized constant time)
+        /*! @param it: Iterator to instance
+         *  @param key: New render order
+         *  Entry is moved to its correct position at the
+         *  next tidy, so iterators remain valid.
+         */
+        void change_key( iterator it, uint64_t key )
+        {
+            const size_t INDEX = it - this->entries.begin();
+
+            // Entries beyond sorted prefix are sorted at next
+            // tidy anyway, so can simply be changed
+            if( INDEX >= this->num_sorted )
+            {
+                it->first = key;
+                return;
+            }
+
+            // If order of sorted prefix is kept, change key now.
+            // Note: Tombstones retain their keys, so
+            //       neighbours are always comparable
+            if( ( INDEX == 0 || this->entries[ INDEX - 1 ].first <= key )
+                && ( INDEX + 1 == this->num_sorted
+                     || this->entries[ INDEX + 1 ].first >= key
+                   )
+            )
+            {
+                it->first = key;
+
+                // Entry may already have a pending key,
+                // which must not overwrite this one
+                if( !this->pending_keys.empty() )
+                {
+                    this->pending_keys.push_back(
+                        std::pair<size_t,uint64_t>( INDEX, key )
+                    );
+                }
+                return;
+            }
+
+            // Otherwise entry keeps its old key until next
+            // tidy, so sorted prefix remains searchable
+            this->pending_keys.push_back(
+                std::pair<size_t,uint64_t>( INDEX, key )
+            );
+        }
+
+        //! Remove all instances
+        void clear( void ) noexcept
+        {
+            this->entries.clear();
+            this->pending_keys.clear();
+            this->num_live = 0;
+            this->num_sorted = 0;
+            this->has_tombstones = false;
+        }
+
+        //! Get iterator to first instance (tidies container first)
+        iterator begin( void )
+        {
+            this->tidy();
+            return this->entries.begin();
+        }
+
+        //! Get const iterator to first instance (tidies container first)
+        const_iterator begin( void ) const
+        {
+            this->tidy();
+            return this->entries.cbegin();
+        }
+
+        //! Get iterator to end (does *not* tidy container)
+        iterator end( void ) noexcept
+        {
+            return this->entries.end();
+        }
+
+        //! Get const iterator to end (does *not* tidy container)
+        const_iterator end( void ) const noexcept
+        {
+            return this->entries.cend();
+        }
+
+        //! Find entry of instance (does *not* tidy container)
+        /*! @param instance: Instance to find
+         *  @param key: Render order of instance
+         *  @returns Iterator to entry, or 'end' if not found
+         *  The sorted prefix is binary searched, then any
+         *  entries changed or appended out of order since
+         *  the last tidy are checked one by one.
+         */
+        iterator find_instance(
+            const MCK::GameEngRenderBase* instance,
+            uint64_t key
+        )
+        {
+            const iterator SORTED_END = this->entries.begin() + this->num_sorted;
+
+            // Search sorted prefix. The range is checked in full,
+            // as the same key may (theoretically) be shared by
+            // more than one instance (see GameEngRenderBase)
+            const std::pair<iterator,iterator> RANGE = std::equal_range(
+                this->entries.begin(),
+                SORTED_END,
+                value_type( key, std::shared_ptr<MCK::GameEngRenderBase>() ),
+                MCK::GameEngRenderInstanceVec::compare
+            );
+            for( iterator it = RANGE.first; it != RANGE.second; it++ )
+            {
+                if( it->second.get() == instance )
+                {
+                    return it;
+                }
+            }
+
+            // Check entries whose new key is still pending
+            for( const auto &pending : this->pending_keys )
+            {
+                if( this->entries[ pending.first ].second.get() == instance )
+                {
+                    return this->entries.begin() + pending.first;
+                }
+            }
+
+            // Check entries appended out of order
+            for( iterator it = SORTED_END; it != this->entries.end(); it++ )
+            {
+                if( it->second.get() == instance )
+                {
+                    return it;
+                }
+            }
+
+            return this->entries.end();
+        }
+
+        //! Sort entries and remove tombstones, if needed
+        /*! This is const as it does not change the set
+         *  of instances held, or their render order.
+         */
+        void tidy( void ) const
+        {
+            // Apply pending keys first, as indices
+            // change when tombstones are removed
+            const size_t NUM_UNSORTED
+                = this->pending_keys.size()
+                      + ( this->entries.size() - this->num_sorted );
+            for( const auto &pending : this->pending_keys )
+            {
+                this->entries[ pending.first ].first = pending.second;
+            }
+            this->pending_keys.clear();
+
+            if( this->has_tombstones )
+            {
+                this->entries.erase(
+                    std::remove_if(
+                        this->entries.begin(),
+                        this->entries.end(),
+                        MCK::GameEngRenderInstanceVec::is_tombstone
+                    ),
+                    this->entries.end()
+                );
+                this->has_tombstones = false;
+            }
+
+            if( NUM_UNSORTED == 0 )
+            {
+                this->num_sorted = this->entries.size();
+                return;
+            }
+
+            // Insertion sort is fastest for nearly-sorted
+            // data (the usual case, as only a few keys
+            // change each frame), otherwise fall back on
+            // a general purpose sort.
+            // Both are stable, so instances with equal
+            // keys stay in order of insertion, as with
+            // std::multimap.
+            const size_t MAX_UNSORTED_FOR_INSERTION_SORT = 32;
+            if( NUM_UNSORTED > MAX_UNSORTED_FOR_INSERTION_SORT )
+            {
+                std::stable_sort(
+                    this->entries.begin(),
+                    this->entries.end(),
+                    MCK::GameEngRenderInstanceVec::compare
+                );
+            }
+            else
+            {
+                const size_t NUM_ENTRIES = this->entries.size();
+                for( size_t i = 1; i < NUM_ENTRIES; i++ )
+                {
+                    if( this->entries[ i - 1 ].first <= this->entries[ i ].first )
+                    {
+                        continue;
+                    }
+
+                    value_type temp = std::move( this->entries[ i ] );
+                    size_t j = i;
+                    while( j > 0 && this->entries[ j - 1 ].first > temp.first )
+                    {
+                        this->entries[ j ] = std::move( this->entries[ j - 1 ] );
+                        j--;
+                    }
+                    this->entries[ j ] = std::move( temp );
+                }
+            }
+            this->num_sorted = this->entries.size();
+        }
+
+
+    protected:
+
+        //! Comparison of render orders, for sorting and searching
+        static bool compare( const value_type &a, const value_type &b ) noexcept
+        {
+            return a.first < b.first;
+        }
+
+        //! Returns true if entry is a tombstone
+        static bool is_tombstone( const value_type &a ) noexcept
+        {
+            return a.second.get() == NULL;
+        }
+
+        //! Entries, sorted by render order (once tidied)
+        /*! This is mutable so that const iteration
+         *  can tidy the container.
+         */
+        mutable std::vector<value_type> entries;
+
+        //! Number of entries that are not tombstones
+        size_t num_live;
+
+        //! Number of leading entries known to be sorted
+        mutable size_t num_sorted;
+
+        //! Changes of key that would break sort order, as (index, key)
+        /*! These are applied at the next tidy, so that
+         *  the sorted prefix can still be searched.
+         */
+        mutable std::vector< std::pair<size_t,uint64_t> > pending_keys;
+
+        //! Flag to indicate tombstones exist
+        mutable bool has_tombstones;
+};
+
+}  // End of namespace MCK
+
+#endif
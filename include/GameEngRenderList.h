@@ -0,0 +1,363 @@
+////////////////////////////////////////////
+//  ------------------------------------
+//  ---MUCKY VISION 3 (BASIC ENGINE) ---
+//  ------------------------------------
+//
+//  GameEngRenderList.h
+//
+//  A flattened ('compiled') copy of a
+//  render block tree, stored in contiguous
+//  arrays so that it can be rendered in
+//  a single linear pass
+//
+//  This file has no corresponding .cpp file
+//
+//  Copyright (c) Muckytaters 2023
+//
+//  This program is free software: you can
+//  redistribute it and/or modify it under
+//  the terms of the GNU General Public License
+//  as published by the Free Software Foundation,
+//  either version 3 of the License, or (at your
+//  option) any later version.
+//
+//  This program is distributed in the hope it
+//  will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY
+//  or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU
+//  General Public License along with this
+//  program. If not, see http://www.gnu.org/license
+////////////////////////////////////////////
+
+#ifndef MCK_GAME_ENG_RL_H
+#define MCK_GAME_ENG_RL_H
+
+#include <vector>
+
+#include "GameEngRenderBase.h"
+#include "GameEngRenderBlock.h"
+#include "GameEngRenderInfo.h"
+#include "GameEngTileMap.h"
+
+namespace MCK
+{
+
+class GameEngRenderList
+{
+    //! Friendship so GameEng can access protected/private members
+    friend class GameEng;
+
+    public:
+
+        //! Single draw command, ready for submission to SDL
+        /*! 'dest_rect' includes all block offsets */
+        struct Item
+        {
+            //! Source texture
+            SDL_Texture* tex;
+
+            //! Source rectangle within texture (only used if 'clip' is true)
+            SDL_Rect clip_rect;
+
+            //! Destination rectangle, in screen pixels
+            SDL_Rect dest_rect;
+
+            //! Rotation and flip flags (see GameEngRenderInfo)
+            uint8_t flags;
+
+            //! Flag to indicate whether clipping rectangle used
+            bool clip;
+
+            //! Fractions of a pixel added to 'dest_rect' position, in 256ths
+            /*! Always zero, unless sub-pixel rendering is
+             *  enabled (see GameEng::set_sub_pixel_render).
+             *  Held as bytes, so that draw commands are no
+             *  larger than without them.
+             */
+            uint8_t hoz_sub_offset;
+            uint8_t vert_sub_offset;
+
+            //! Colo(u)r modulation (see GameEngRenderInfo)
+            SDL_Color color_mod;
+        };
+
+        //! Default constructor
+        GameEngRenderList( void )
+        {
+            this->root = NULL;
+            this->num_draw_calls = 0;
+            this->items_valid = false;
+            this->full_redraw = true;
+            this->last_full_redraw = false;
+        }
+
+        //! Returns true if list has been compiled from a render block
+        bool is_compiled( void ) const noexcept
+        {
+            return this->root != NULL;
+        }
+
+        //! Get number of render infos (and tile maps) held in compiled list
+        size_t get_num_entries( void ) const noexcept
+        {
+            return this->entries.size();
+        }
+
+        //! Get number of render blocks held in compiled list
+        size_t get_num_blocks( void ) const noexcept
+        {
+            return this->slots.size();
+        }
+
+        //! Get draw commands of the most recent render
+        const std::vector<MCK::GameEngRenderList::Item>& get_items( void ) const noexcept
+        {
+            return this->items;
+        }
+
+        //! Get number of SDL draw calls made during the most recent render
+        size_t get_num_draw_calls( void ) const noexcept
+        {
+            return this->num_draw_calls;
+        }
+
+        //! Get areas redrawn during the most recent render (retained frame only)
+        /*! Empty if nothing changed, or if whole frame
+         *  was redrawn (see 'was_full_redraw').
+         */
+        const std::vector<SDL_Rect>& get_dirty_rects( void ) const noexcept
+        {
+            return this->dirty_rects;
+        }
+
+        //! Returns true if whole frame was redrawn during the most recent render (retained frame only)
+        bool was_full_redraw( void ) const noexcept
+        {
+            return this->last_full_redraw;
+        }
+
+        //! Discard compiled list (it will be re-compiled when next rendered)
+        /*! Note: 'num_draw_calls' is left alone, as it is only
+         *        written by submission, which may run on another
+         *        thread (see GameEng::publish_render_snapshot).
+         */
+        void clear( void ) noexcept
+        {
+            this->root = NULL;
+            this->slots.clear();
+            this->entries.clear();
+            this->items.clear();
+            this->items_valid = false;
+            this->full_redraw = true;
+        }
+
+        //! Regenerate every draw command when next rendered
+        /*! Needed when draw commands change without any
+         *  render block or render info changing, e.g. when
+         *  culling is enabled or disabled.
+         */
+        void invalidate_items( void ) noexcept
+        {
+            for( auto &s : this->slots )
+            {
+                s.cached = false;
+            }
+        }
+
+
+    protected:
+
+        //! Value used to indicate a slot has no parent
+        static const uint32_t NO_PARENT = 0xFFFFFFFF;
+
+        //! Record of a single render block in the compiled list
+        /*! Slots are stored in depth-first order, so
+         *  the descendants of slot 'n' occupy slots
+         *  n + 1 to 'slot_end' - 1, and the render infos
+         *  of the block and all its descendants occupy
+         *  entries 'entry_begin' to 'entry_end' - 1.
+         */
+        struct BlockSlot
+        {
+            const MCK::GameEngRenderBlock* block;
+            uint32_t parent_slot;
+            uint32_t slot_end;
+            uint32_t entry_begin;
+            uint32_t entry_end;
+
+            //! Block revision at time of compilation
+            uint64_t revision;
+
+            //! Block content revision when draw commands of its entries were generated
+            uint64_t content_revision;
+
+            //! Cumulative offsets, recalculated every render
+            int16_t hoz_offset;
+            int16_t vert_offset;
+
+            //! Cumulative fractions of a pixel, in 256ths (sub-pixel rendering only)
+            uint8_t hoz_sub_offset;
+            uint8_t vert_sub_offset;
+
+            //! True if block and all its ancestors are active
+            bool visible;
+
+            //! True if visible and any of block's own images are on screen
+            bool on_screen;
+
+            //! True if draw commands of block's own entries are up to date
+            /*! Only valid while 'content_revision', offsets,
+             *  'visible' and 'on_screen' are unchanged.
+             */
+            bool cached;
+
+            //! True if block's own entries need regenerating this render
+            bool changed;
+        };
+
+        //! Record of a single render info (or tile map) in the compiled list
+        /*! Exactly one of 'info' and 'tile_map' is non-NULL */
+        struct Entry
+        {
+            const MCK::GameEngRenderInfo* info;
+            const MCK::GameEngTileMap* tile_map;
+            uint32_t slot;
+
+            //! True if entry is drawn
+            bool drawn;
+
+            //! Draw command, kept until the entry's block changes
+            /*! For a tile map, only 'dest_rect' is used, and
+             *  this is the area of the window covered by
+             *  the map's draw commands (which are generated
+             *  afresh every time the list is collected).
+             */
+            MCK::GameEngRenderList::Item item;
+
+            //! Tile map revision when 'item' was generated
+            uint32_t revision;
+        };
+
+        //! Returns true if two draw commands give identical output
+        static bool same_item(
+            const MCK::GameEngRenderList::Item &a,
+            const MCK::GameEngRenderList::Item &b
+        ) noexcept
+        {
+            return a.tex == b.tex
+                   && a.flags == b.flags
+                   && a.clip == b.clip
+                   && a.color_mod.r == b.color_mod.r
+                   && a.color_mod.g == b.color_mod.g
+                   && a.color_mod.b == b.color_mod.b
+                   && a.color_mod.a == b.color_mod.a
+                   && a.dest_rect.x == b.dest_rect.x
+                   && a.dest_rect.y == b.dest_rect.y
+                   && a.dest_rect.w == b.dest_rect.w
+                   && a.dest_rect.h == b.dest_rect.h
+                   && a.hoz_sub_offset == b.hoz_sub_offset
+                   && a.vert_sub_offset == b.vert_sub_offset
+                   && ( !a.clip
+                        || ( a.clip_rect.x == b.clip_rect.x
+                             && a.clip_rect.y == b.clip_rect.y
+                             && a.clip_rect.w == b.clip_rect.w
+                             && a.clip_rect.h == b.clip_rect.h
+                        )
+                   );
+        }
+
+        //! Mark area of a draw command as needing redraw (retained frame only)
+        void add_dirty_item( const MCK::GameEngRenderList::Item &item )
+        {
+            SDL_Rect rect;
+            MCK::GameEngRenderList::calc_item_bounds( item, rect );
+            if( rect.w > 0 && rect.h > 0 )
+            {
+                this->dirty_rects.push_back( rect );
+            }
+        }
+
+        //! Calculate area of game window covered by a draw command
+        /*! @param item: Draw command
+         *  @param rect: Bounding rectangle
+         *  A fraction of a pixel offset may cover one more
+         *  column and row of pixels.
+         */
+        static void calc_item_bounds(
+            const MCK::GameEngRenderList::Item &item,
+            SDL_Rect &rect
+        ) noexcept
+        {
+            MCK::GameEngRenderInfo::calc_bounds(
+                item.dest_rect,
+                item.flags,
+                rect
+            );
+            if( item.hoz_sub_offset > 0 )
+            {
+                rect.w++;
+            }
+            if( item.vert_sub_offset > 0 )
+            {
+                rect.h++;
+            }
+        }
+
+        //! Root block from which list was compiled
+        const MCK::GameEngRenderBlock* root;
+
+        //! Compiled blocks, in depth-first order
+        std::vector<MCK::GameEngRenderList::BlockSlot> slots;
+
+        //! Compiled render infos, in render order
+        std::vector<MCK::GameEngRenderList::Entry> entries;
+
+        //! Draw commands of all entries, in render order
+        /*! Only refilled when an entry's draw command changes */
+        std::vector<MCK::GameEngRenderList::Item> items;
+
+        //! Flag to indicate 'items' matches the draw commands of the entries
+        bool items_valid;
+
+        //! Number of SDL draw calls made during most recent render
+        /*! Unlike the rest of the list, this (and the batch
+         *  buffers below) belongs to submission, which is on
+         *  the rendering thread when snapshots are published
+         *  by another thread.
+         */
+        size_t num_draw_calls;
+
+#if SDL_VERSION_ATLEAST(2,0,18)
+        //! Vertices of the current batch of quads
+        std::vector<SDL_Vertex> vertices;
+
+        //! Indices for batches of quads
+        /*! This is a fixed pattern (two triangles per quad),
+         *  so it is only extended, never rebuilt.
+         */
+        std::vector<int> indices;
+#endif
+
+        //! Areas of retained frame needing redraw
+        std::vector<SDL_Rect> dirty_rects;
+
+        //! Flag to indicate whole retained frame needs redrawing
+        bool full_redraw;
+
+        //! Flag to indicate whole retained frame was redrawn by most recent render
+        bool last_full_redraw;
+
+        //! Draw commands of a single tile map, when rendered without compiled list
+        std::vector<MCK::GameEngRenderList::Item> tile_map_items;
+
+        //! Scratch space used when re-compiling part of the tree
+        std::vector<MCK::GameEngRenderList::BlockSlot> scratch_slots;
+        std::vector<MCK::GameEngRenderList::Entry> scratch_entries;
+};
+
+}  // End of namespace MCK
+
+#endif
@@ -0,0 +1,251 @@
+////////////////////////////////////////////
+//  ------------------------------------
+//  ---MUCKY VISION 3 (BASIC ENGINE) ---
+//  ------------------------------------
+//
+//  GameEngTextureAtlas.h
+//
+//  Packs many small images into a few
+//  large 'page' textures, using simple
+//  shelf packing
+//
+//  This file has no corresponding .cpp file
+//
+//  Copyright (c) Muckytaters 2023
+//
+//  This program is free software: you can
+//  redistribute it and/or modify it under
+//  the terms of the GNU General Public License
+//  as published by the Free Software Foundation,
+//  either version 3 of the License, or (at your
+//  option) any later version.
+//
+//  This program is distributed in the hope it
+//  will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY
+//  or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU
+//  General Public License along with this
+//  program. If not, see http://www.gnu.org/license
+////////////////////////////////////////////
+
+#ifndef MCK_GAME_ENG_ATLAS_H
+#define MCK_GAME_ENG_ATLAS_H
+
+#include <cstdint>  // For uint16_t et al.
+#include <vector>
+
+// SDL includes (Linux/Windows specific)
+// This is required if cross-compiling for Windows *on Linux*
+#ifdef MCK_MINGW
+#include <SDL.h>
+#endif
+#ifndef MCK_MINGW
+// This is required if compiling on Linux or Windows (MinGW)
+#include <SDL2/SDL.h>
+#endif
+
+namespace MCK
+{
+
+class GameEngTextureAtlas
+{
+    public:
+
+        //! Location of a single image within the atlas
+        struct Region
+        {
+            //! Index of page holding image
+            uint16_t page;
+
+            //! Position and size of image within page
+            SDL_Rect rect;
+        };
+
+        //! Default constructor (atlas disabled)
+        GameEngTextureAtlas( void )
+        {
+            this->page_size = 0;
+            this->max_pages = 0;
+        }
+
+        //! Set page size and maximum number of pages
+        /*! @param _page_size: Width and height of each page, in pixels (zero to disable atlas)
+         *  @param _max_pages: Maximum number of pages
+         *  Note: Existing pages are not affected, this is
+         *        intended to be called before any pages
+         *        are added.
+         */
+        void init( uint16_t _page_size, uint16_t _max_pages ) noexcept
+        {
+            this->page_size = _page_size;
+            this->max_pages = _max_pages;
+        }
+
+        //! Returns true if atlas has been given a non-zero page size
+        bool is_enabled( void ) const noexcept
+        {
+            return this->page_size > 0 && this->max_pages > 0;
+        }
+
+        //! Get width and height of each page, in pixels
+        uint16_t get_page_size( void ) const noexcept
+        {
+            return this->page_size;
+        }
+
+        //! Get maximum number of pages
+        uint16_t get_max_pages( void ) const noexcept
+        {
+            return this->max_pages;
+        }
+
+        //! Get current number of pages
+        uint16_t get_num_pages( void ) const noexcept
+        {
+            return this->pages.size();
+        }
+
+        //! Returns true if another page may be added
+        bool can_add_page( void ) const noexcept
+        {
+            return this->pages.size() < this->max_pages;
+        }
+
+        //! Get texture of a given page (NULL if page does not exist)
+        SDL_Texture* get_page_tex( uint16_t page ) const noexcept
+        {
+            return page < this->pages.size() ? this->pages[ page ].tex : NULL;
+        }
+
+        //! Add (empty) page
+        /*! @param tex: Texture of page_size x page_size pixels
+         *  Note: Ownership of texture remains with caller
+         */
+        void add_page( SDL_Texture* tex )
+        {
+            MCK::GameEngTextureAtlas::Page new_page;
+            new_page.tex = tex;
+            new_page.next_shelf_y = 0;
+            this->pages.push_back( new_page );
+        }
+
+        //! Mark a page as empty, so its space can be re-used
+        /*! Note: Texture is not cleared, as all regions
+         *        are overwritten when re-allocated
+         */
+        void reset_page( uint16_t page ) noexcept
+        {
+            if( page < this->pages.size() )
+            {
+                this->pages[ page ].shelves.clear();
+                this->pages[ page ].next_shelf_y = 0;
+            }
+        }
+
+        //! Find space for an image in an existing page
+        /*! @param width: Width of image, in pixels
+         *  @param height: Height of image, in pixels
+         *  @param region: Location of space for image (if found)
+         *  @returns True if space found
+         *  Images are placed on the shortest shelf that will
+         *  hold them, starting a new shelf if none will (or
+         *  if that shelf is more than twice the image height).
+         */
+        bool allocate( uint16_t width, uint16_t height, Region &region )
+        {
+            if( width == 0 || height == 0
+                || width > this->page_size || height > this->page_size
+            )
+            {
+                return false;
+            }
+
+            for( size_t p = 0; p < this->pages.size(); p++ )
+            {
+                MCK::GameEngTextureAtlas::Page &page = this->pages[ p ];
+
+                // Find shortest existing shelf with room for image
+                MCK::GameEngTextureAtlas::Shelf* best_shelf = NULL;
+                for( auto &shelf : page.shelves )
+                {
+                    if( shelf.height >= height
+                        && this->page_size - shelf.next_x >= width
+                        && ( best_shelf == NULL
+                             || shelf.height < best_shelf->height )
+                    )
+                    {
+                        best_shelf = &shelf;
+                    }
+                }
+
+                // If none, or best shelf is much taller than
+                // image, try to start a new shelf
+                const bool ROOM_FOR_NEW_SHELF
+                    = this->page_size - page.next_shelf_y >= height;
+                if( best_shelf == NULL
+                    || ( ROOM_FOR_NEW_SHELF
+                         && best_shelf->height > height * 2 )
+                )
+                {
+                    if( !ROOM_FOR_NEW_SHELF )
+                    {
+                        continue;
+                    }
+
+                    MCK::GameEngTextureAtlas::Shelf new_shelf;
+                    new_shelf.y = page.next_shelf_y;
+                    new_shelf.height = height;
+                    new_shelf.next_x = 0;
+                    page.shelves.push_back( new_shelf );
+                    page.next_shelf_y += height;
+                    best_shelf = &page.shelves.back();
+                }
+
+                region.page = p;
+                region.rect.x = best_shelf->next_x;
+                region.rect.y = best_shelf->y;
+                region.rect.w = width;
+                region.rect.h = height;
+                best_shelf->next_x += width;
+
+                return true;
+            }
+
+            return false;
+        }
+
+
+    protected:
+
+        //! Horizontal strip of a page, filled left to right
+        struct Shelf
+        {
+            uint16_t y;
+            uint16_t height;
+            uint16_t next_x;
+        };
+
+        //! Single atlas texture
+        struct Page
+        {
+            SDL_Texture* tex;
+            std::vector<MCK::GameEngTextureAtlas::Shelf> shelves;
+            uint16_t next_shelf_y;
+        };
+
+        //! Width and height of each page, in pixels
+        uint16_t page_size;
+
+        //! Maximum number of pages
+        uint16_t max_pages;
+
+        //! Pages
+        std::vector<MCK::GameEngTextureAtlas::Page> pages;
+};
+
+}  // End of namespace MCK
+
+#endif
@@ -0,0 +1,286 @@
+////////////////////////////////////////////
+//  ------------------------------------
+//  ---MUCKY VISION 3 (BASIC ENGINE) ---
+//  ------------------------------------
+//
+//  GameEngTextureTable.h
+//
+//  Flat hash table, keyed by texture ID,
+//  using open addressing (linear probing)
+//  so that a lookup usually touches only
+//  a cache line or two
+//
+//  This file has no corresponding .cpp file
+//
+//  Copyright (c) Muckytaters 2023
+//
+//  This program is free software: you can
+//  redistribute it and/or modify it under
+//  the terms of the GNU General Public License
+//  as published by the Free Software Foundation,
+//  either version 3 of the License, or (at your
+//  option) any later version.
+//
+//  This program is distributed in the hope it
+//  will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY
+//  or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU
+//  General Public License along with this
+//  program. If not, see http://www.gnu.org/license
+////////////////////////////////////////////
+
+#ifndef MCK_GAME_ENG_TEX_TABLE_H
+#define MCK_GAME_ENG_TEX_TABLE_H
+
+#include <cstddef>  // For size_t
+#include <cstdint>  // For uint64_t et al.
+#include <stdexcept>  // For exceptions
+#include <utility>  // For swap
+#include <vector>
+
+#include "Defs.h"
+
+namespace MCK
+{
+
+//! Hash table of values of type T, keyed by texture ID
+/*! Keys are held in their own array, so probing for
+ *  a key reads consecutive keys (eight per cache line)
+ *  and only the value found is read from the value array.
+ *  The table is kept at most half full, so probes are short.
+ *  Note: Pointers to values are invalidated by 'insert'
+ *        and 'erase', as values may move.
+ *  Note: MCK::INVALID_TEX_ID cannot be used as a key,
+ *        as it marks empty slots.
+ */
+template<class T>
+class GameEngTextureTable
+{
+    public:
+
+        //! Default constructor (empty table)
+        GameEngTextureTable( void )
+        {
+            this->num_entries = 0;
+            this->shift = 64;
+        }
+
+        //! Get number of entries
+        size_t size( void ) const noexcept
+        {
+            return this->num_entries;
+        }
+
+        //! Get number of slots (for iterating, see 'get_key' and 'get_value')
+        size_t get_num_slots( void ) const noexcept
+        {
+            return this->keys.size();
+        }
+
+        //! Get key held in slot, MCK::INVALID_TEX_ID if slot empty
+        MCK_TEX_ID_TYPE get_key( size_t slot ) const noexcept
+        {
+            return this->keys[ slot ];
+        }
+
+        //! Get value held in slot (only valid if slot not empty)
+        T& get_value( size_t slot ) noexcept
+        {
+            return this->values[ slot ];
+        }
+
+        //! Get value held in slot, read only (only valid if slot not empty)
+        const T& get_value( size_t slot ) const noexcept
+        {
+            return this->values[ slot ];
+        }
+
+        //! Get pointer to value, or NULL if key not found
+        T* find( MCK_TEX_ID_TYPE key ) noexcept
+        {
+            const size_t SLOT = this->find_slot( key );
+            return SLOT < this->keys.size() ? &this->values[ SLOT ] : NULL;
+        }
+
+        //! Get pointer to value, read only, or NULL if key not found
+        const T* find( MCK_TEX_ID_TYPE key ) const noexcept
+        {
+            const size_t SLOT = this->find_slot( key );
+            return SLOT < this->keys.size() ? &this->values[ SLOT ] : NULL;
+        }
+
+        //! Returns true if key found
+        bool contains( MCK_TEX_ID_TYPE key ) const noexcept
+        {
+            return this->find_slot( key ) < this->keys.size();
+        }
+
+        //! Insert value (replacing any existing value), and return pointer to it
+        T* insert( MCK_TEX_ID_TYPE key, const T &value )
+        {
+            if( key == MCK::INVALID_TEX_ID )
+            {
+                throw( std::runtime_error(
+#if defined MCK_STD_OUT
+                    "Cannot insert invalid texture ID into texture table."
+#else
+                    ""
+#endif
+                ) );
+            }
+
+            // Keep table at most half full
+            if( ( this->num_entries + 1 ) * 2 > this->keys.size() )
+            {
+                this->grow();
+            }
+
+            const size_t MASK = this->keys.size() - 1;
+            size_t slot = this->calc_home_slot( key );
+            while( this->keys[ slot ] != MCK::INVALID_TEX_ID )
+            {
+                if( this->keys[ slot ] == key )
+                {
+                    this->values[ slot ] = value;
+                    return &this->values[ slot ];
+                }
+                slot = ( slot + 1 ) & MASK;
+            }
+
+            this->keys[ slot ] = key;
+            this->values[ slot ] = value;
+            this->num_entries++;
+            return &this->values[ slot ];
+        }
+
+        //! Remove key (and its value), returning false if key not found
+        /*! Entries after the removed one are shifted back,
+         *  so no 'tombstones' are left to lengthen probes.
+         */
+        bool erase( MCK_TEX_ID_TYPE key )
+        {
+            size_t hole = this->find_slot( key );
+            if( hole >= this->keys.size() )
+            {
+                return false;
+            }
+
+            const size_t MASK = this->keys.size() - 1;
+            size_t slot = ( hole + 1 ) & MASK;
+            while( this->keys[ slot ] != MCK::INVALID_TEX_ID )
+            {
+                // Move entry into hole, unless its home
+                // slot lies (cyclically) after the hole
+                const size_t HOME = this->calc_home_slot( this->keys[ slot ] );
+                if( ( ( slot - HOME ) & MASK ) >= ( ( slot - hole ) & MASK ) )
+                {
+                    this->keys[ hole ] = this->keys[ slot ];
+                    this->values[ hole ] = this->values[ slot ];
+                    hole = slot;
+                }
+                slot = ( slot + 1 ) & MASK;
+            }
+
+            this->keys[ hole ] = MCK::INVALID_TEX_ID;
+            this->values[ hole ] = T();
+            this->num_entries--;
+            return true;
+        }
+
+    protected:
+
+        //! Minimum number of slots, once any entry added
+        static const size_t MIN_SLOTS = 64;
+
+        //! Keys (texture IDs) of each slot
+        std::vector<MCK_TEX_ID_TYPE> keys;
+
+        //! Values of each slot
+        std::vector<T> values;
+
+        //! Number of entries
+        size_t num_entries;
+
+        //! Right shift that maps hash to slot (64 - log2 of number of slots)
+        int shift;
+
+        //! Calculate slot in which key would ideally be held
+        /*! Texture IDs hold the image ID in their lower
+         *  32 bits and palette ID in their upper 32 bits,
+         *  so both halves are folded together before
+         *  Fibonacci hashing spreads them across the table.
+         */
+        size_t calc_home_slot( MCK_TEX_ID_TYPE key ) const noexcept
+        {
+            return size_t(
+                ( ( key ^ ( key >> 29 ) ) * uint64_t( 0x9E3779B97F4A7C15 ) )
+                    >> this->shift
+            );
+        }
+
+        //! Get slot holding key, or number of slots if not found
+        size_t find_slot( MCK_TEX_ID_TYPE key ) const noexcept
+        {
+            if( this->num_entries == 0 || key == MCK::INVALID_TEX_ID )
+            {
+                return this->keys.size();
+            }
+
+            const size_t MASK = this->keys.size() - 1;
+            size_t slot = this->calc_home_slot( key );
+            while( this->keys[ slot ] != key )
+            {
+                if( this->keys[ slot ] == MCK::INVALID_TEX_ID )
+                {
+                    return this->keys.size();
+                }
+                slot = ( slot + 1 ) & MASK;
+            }
+            return slot;
+        }
+
+        //! Double number of slots, and re-insert all entries
+        void grow( void )
+        {
+            std::vector<MCK_TEX_ID_TYPE> old_keys;
+            std::vector<T> old_values;
+            std::swap( this->keys, old_keys );
+            std::swap( this->values, old_values );
+
+            const size_t NUM_SLOTS
+                = old_keys.size() > 0
+                    ? old_keys.size() * 2
+                    : MCK::GameEngTextureTable<T>::MIN_SLOTS;
+            this->keys.assign( NUM_SLOTS, MCK::INVALID_TEX_ID );
+            this->values.assign( NUM_SLOTS, T() );
+
+            this->shift = 64;
+            for( size_t n = NUM_SLOTS; n > 1; n >>= 1 )
+            {
+                this->shift--;
+            }
+
+            const size_t MASK = this->keys.size() - 1;
+            for( size_t i = 0; i < old_keys.size(); i++ )
+            {
+                if( old_keys[ i ] == MCK::INVALID_TEX_ID )
+                {
+                    continue;
+                }
+                size_t slot = this->calc_home_slot( old_keys[ i ] );
+                while( this->keys[ slot ] != MCK::INVALID_TEX_ID )
+                {
+                    slot = ( slot + 1 ) & MASK;
+                }
+                this->keys[ slot ] = old_keys[ i ];
+                this->values[ slot ] = old_values[ i ];
+            }
+        }
+};
+
+}  // End of namespace MCK
+
+#endif
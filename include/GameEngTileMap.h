@@ -0,0 +1,402 @@
+////////////////////////////////////////////
+//  ------------------------------------
+//  ---MUCKY VISION 3 (BASIC ENGINE) ---
+//  ------------------------------------
+//
+//  GameEngTileMap.h
+//
+//  Grid of equally sized cells, each showing
+//  one of a set of tile textures, rendered
+//  as a single render instance
+//
+//  This file has no corresponding .cpp file
+//
+//  Copyright (c) Muckytaters 2023
+//
+//  This program is free software: you can
+//  redistribute it and/or modify it under
+//  the terms of the GNU General Public License
+//  as published by the Free Software Foundation,
+//  either version 3 of the License, or (at your
+//  option) any later version.
+//
+//  This program is distributed in the hope it
+//  will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY
+//  or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU
+//  General Public License along with this
+//  program. If not, see http://www.gnu.org/license
+////////////////////////////////////////////
+
+#ifndef MCK_GAME_ENG_TILE_MAP_H
+#define MCK_GAME_ENG_TILE_MAP_H
+
+#include <vector>
+#include <algorithm>  // For fill
+
+#include "GameEngRenderBase.h"
+#include "GameEngRenderInfo.h"
+
+namespace MCK
+{
+
+//! Tile map, i.e. a grid of cells rendered as one instance
+/*! Each cell holds a 16bit tile number (or EMPTY_CELL),
+ *  which selects a texture from the map's tile set
+ *  (see GameEng::set_tile_map_tile). So each cell costs
+ *  two bytes, rather than the render info (and render
+ *  block entry) that would otherwise be needed.
+ *  Cell (0,0) is drawn at the map's position, less the
+ *  scroll offset, and cells are all drawn at the same
+ *  size (stretching tile textures if necessary).
+ *  GameEng only draws the cells that fall within the
+ *  game window, so very large maps are cheap to render.
+ */
+class GameEngTileMap : public GameEngRenderBase
+{
+    //! Friendship so GameEng can access protected/private members
+    friend class GameEng;
+
+    public:
+
+        //! Tile number of cells that are not drawn
+        static const uint16_t EMPTY_CELL = 0xFFFF;
+
+        //! Constructor
+        /*! @param _width_in_cells: Width of map, in cells
+         *  @param _height_in_cells: Height of map, in cells
+         *  @param _cell_width: Width of each cell, in pixels
+         *  @param _cell_height: Height of each cell, in pixels
+         *  @param z: 'z' value of map (see GameEngRenderBase)
+         *  All cells are initially empty.
+         */
+        GameEngTileMap(
+            uint16_t _width_in_cells,
+            uint16_t _height_in_cells,
+            uint16_t _cell_width,
+            uint16_t _cell_height,
+            uint32_t z = MCK::DEFAULT_Z_VALUE
+        ) : GameEngRenderBase( z ),
+            cells(
+                size_t( _width_in_cells ) * size_t( _height_in_cells ),
+                uint16_t( MCK::GameEngTileMap::EMPTY_CELL )
+            )
+        {
+            this->width_in_cells = _width_in_cells;
+            this->height_in_cells = _height_in_cells;
+            this->cell_width = _cell_width;
+            this->cell_height = _cell_height;
+            this->x = 0;
+            this->y = 0;
+            this->scroll_x = 0;
+            this->scroll_y = 0;
+            this->revision = 0;
+
+            this->type = MCK::RenderInstanceType::TILE_MAP;
+        }
+
+        //! Destructor
+        /*! Releases map's references to its tile textures,
+         *  so that GameEng may evict them once unused.
+         */
+        virtual ~GameEngTileMap( void )
+        {
+            MCK::GameEngRenderInfo::TexReleaseFunc const RELEASE
+                = MCK::GameEngRenderInfo::tex_release_func();
+            if( RELEASE == NULL )
+            {
+                return;
+            }
+            for( const auto &tile : this->tiles )
+            {
+                if( tile.get_tex_id() != MCK::INVALID_TEX_ID )
+                {
+                    RELEASE( tile.get_tex_id() );
+                }
+            }
+        }
+
+        //! Get width of map, in cells
+        uint16_t get_width_in_cells( void ) const noexcept
+        {
+            return this->width_in_cells;
+        }
+
+        //! Get height of map, in cells
+        uint16_t get_height_in_cells( void ) const noexcept
+        {
+            return this->height_in_cells;
+        }
+
+        //! Get width of each cell, in pixels
+        uint16_t get_cell_width( void ) const noexcept
+        {
+            return this->cell_width;
+        }
+
+        //! Get height of each cell, in pixels
+        uint16_t get_cell_height( void ) const noexcept
+        {
+            return this->cell_height;
+        }
+
+        //! Get number of tiles in tile set (see GameEng::set_tile_map_tile)
+        size_t get_num_tiles( void ) const noexcept
+        {
+            return this->tiles.size();
+        }
+
+        //! Get tile number of cell
+        /*! @param col: Column of cell
+         *  @param row: Row of cell
+         *  @returns Tile number, or EMPTY_CELL if cell empty or does not exist
+         */
+        uint16_t get_cell( int col, int row ) const noexcept
+        {
+            if( col < 0 || col >= this->width_in_cells
+                || row < 0 || row >= this->height_in_cells
+            )
+            {
+                return MCK::GameEngTileMap::EMPTY_CELL;
+            }
+            return this->cells[
+                size_t( row ) * size_t( this->width_in_cells ) + size_t( col )
+            ];
+        }
+
+        //! Set tile number of cell
+        /*! @param col: Column of cell
+         *  @param row: Row of cell
+         *  @param tile: Tile number, or EMPTY_CELL
+         *  Cells that do not exist are ignored, as are tile
+         *  numbers with no texture in the tile set.
+         */
+        void set_cell( int col, int row, uint16_t tile ) noexcept
+        {
+            if( col < 0 || col >= this->width_in_cells
+                || row < 0 || row >= this->height_in_cells
+            )
+            {
+                return;
+            }
+            this->cells[
+                size_t( row ) * size_t( this->width_in_cells ) + size_t( col )
+            ] = tile;
+            this->cells_changed();
+        }
+
+        //! Set tile number of every cell
+        /*! @param tile: Tile number, or EMPTY_CELL */
+        void fill( uint16_t tile ) noexcept
+        {
+            std::fill( this->cells.begin(), this->cells.end(), tile );
+            this->cells_changed();
+        }
+
+        //! Get horizontal scroll offset, in pixels
+        int get_scroll_x( void ) const noexcept
+        {
+            return this->scroll_x;
+        }
+
+        //! Get vertical scroll offset, in pixels
+        int get_scroll_y( void ) const noexcept
+        {
+            return this->scroll_y;
+        }
+
+        //! Set scroll offset
+        /*! @param _scroll_x: Horizontal offset, in pixels
+         *  @param _scroll_y: Vertical offset, in pixels
+         *  Cells are drawn this far up and to the left
+         *  of their unscrolled position.
+         */
+        void set_scroll( int _scroll_x, int _scroll_y ) noexcept
+        {
+            this->scroll_x = _scroll_x;
+            this->scroll_y = _scroll_y;
+            this->pos_changed();
+        }
+
+        //! Adjust scroll offset
+        void adj_scroll( int dx, int dy ) noexcept
+        {
+            this->set_scroll( this->scroll_x + dx, this->scroll_y + dy );
+        }
+
+        //! Set x position (of unscrolled cell (0,0))
+        virtual void set_x( int _x ) noexcept
+        {
+            this->x = _x;
+            this->pos_changed();
+        }
+
+        //! Set y position (of unscrolled cell (0,0))
+        virtual void set_y( int _y ) noexcept
+        {
+            this->y = _y;
+            this->pos_changed();
+        }
+
+        //! Set position (of unscrolled cell (0,0))
+        virtual void set_pos( int _x, int _y ) noexcept
+        {
+            this->x = _x;
+            this->y = _y;
+            this->pos_changed();
+        }
+
+        //! Get x position (of unscrolled cell (0,0))
+        virtual int get_x( void ) const noexcept
+        {
+            return this->x;
+        }
+
+        //! Get y position (of unscrolled cell (0,0))
+        virtual int get_y( void ) const noexcept
+        {
+            return this->y;
+        }
+
+        //! Get width of map, in pixels
+        virtual int get_width( void ) const noexcept
+        {
+            return int( this->width_in_cells ) * int( this->cell_width );
+        }
+
+        //! Get height of map, in pixels
+        virtual int get_height( void ) const noexcept
+        {
+            return int( this->height_in_cells ) * int( this->cell_height );
+        }
+
+        //! Get position of bottom edge (unscrolled)
+        virtual int get_bottom( void ) const noexcept
+        {
+            return this->y + this->get_height() - 1;
+        }
+
+        //! Get position of right-hand edge (unscrolled)
+        virtual int get_right( void ) const noexcept
+        {
+            return this->x + this->get_width() - 1;
+        }
+
+        //! Adjust position
+        virtual void adj_pos( int dx, int dy ) noexcept
+        {
+            this->set_pos( this->x + dx, this->y + dy );
+        }
+
+        //! Get area covered by map, including scroll offset
+        /*! @param rect: Bounding rectangle, in screen pixels */
+        void get_bounds( SDL_Rect &rect ) const noexcept
+        {
+            rect.x = this->x - this->scroll_x;
+            rect.y = this->y - this->scroll_y;
+            rect.w = this->get_width();
+            rect.h = this->get_height();
+        }
+
+        //! Render every (non-empty) cell
+        /*! GameEng does not use this, as it draws only
+         *  the cells that fall within the game window.
+         */
+        virtual void render( SDL_Renderer* renderer ) const
+        {
+            SDL_Rect dest;
+            dest.w = this->cell_width;
+            dest.h = this->cell_height;
+            for( int row = 0; row < this->height_in_cells; row++ )
+            {
+                dest.y = this->y - this->scroll_y + row * this->cell_height;
+                for( int col = 0; col < this->width_in_cells; col++ )
+                {
+                    const uint16_t TILE = this->cells[
+                        size_t( row ) * size_t( this->width_in_cells )
+                            + size_t( col )
+                    ];
+                    if( TILE >= this->tiles.size()
+                        || this->tiles[ TILE ].tex == NULL
+                    )
+                    {
+                        continue;
+                    }
+                    const MCK::GameEngRenderInfo::TexHandle &HANDLE
+                        = this->tiles[ TILE ];
+                    dest.x = this->x - this->scroll_x + col * this->cell_width;
+                    SDL_RenderCopy(
+                        renderer,
+                        HANDLE.tex,
+                        HANDLE.in_atlas ? &HANDLE.atlas_rect : NULL,
+                        &dest
+                    );
+                }
+            }
+        }
+
+    protected:
+
+        //! Called whenever position or scroll offset changes
+        /*! Invalidates bounds of parent block, for culling */
+        void pos_changed( void ) noexcept
+        {
+            this->revision++;
+            if( this->parent_block != NULL )
+            {
+                MCK::GameEngRenderBase::invalidate_bounds( this->parent_block );
+            }
+        }
+
+        //! Called whenever cells or tile set change
+        /*! Marks draw commands of parent block as out of date */
+        void cells_changed( void ) noexcept
+        {
+            this->revision++;
+            if( this->parent_block != NULL )
+            {
+                MCK::GameEngRenderBase::content_changed( this->parent_block );
+            }
+        }
+
+        // Disabled to prevent copying,
+        // as this would cause chaos
+        GameEngTileMap(GameEngTileMap const&) = delete;
+        void operator=(GameEngTileMap const&)  = delete;
+
+        //! Tile number of each cell, row by row
+        std::vector<uint16_t> cells;
+
+        //! Tile set, i.e. texture of each tile number
+        /*! Each handle holds a reference to its texture.
+         *  Set by GameEng (see 'set_tile_map_tile').
+         */
+        std::vector<MCK::GameEngRenderInfo::TexHandle> tiles;
+
+        uint16_t width_in_cells;
+        uint16_t height_in_cells;
+        uint16_t cell_width;
+        uint16_t cell_height;
+
+        //! Position of unscrolled cell (0,0)
+        int x;
+        int y;
+
+        //! Scroll offset
+        int scroll_x;
+        int scroll_y;
+
+        //! Incremented whenever anything drawn changes
+        /*! Used to detect changes to retained frame */
+        uint32_t revision;
+
+        // Dummy method to this class non-abstract
+        void dummy( void ) {}
+};
+
+}  // End of namespace MCK
+
+#endif
@@ -0,0 +1,142 @@
+////////////////////////////////////////////
+//  ------------------------------------
+//  ---MUCKY VISION 3 (BASIC ENGINE) ---
+//  ------------------------------------
+//
+//  GameEngTripleBuffer.h
+//
+//  Lock-free triple buffer, for handing
+//  values from one thread to another
+//  without either thread waiting
+//
+//  This file has no corresponding .cpp file
+//
+//  Copyright (c) Muckytaters 2023
+//
+//  This program is free software: you can
+//  redistribute it and/or modify it under
+//  the terms of the GNU General Public License
+//  as published by the Free Software Foundation,
+//  either version 3 of the License, or (at your
+//  option) any later version.
+//
+//  This program is distributed in the hope it
+//  will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY
+//  or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU
+//  General Public License along with this
+//  program. If not, see http://www.gnu.org/license
+////////////////////////////////////////////
+
+#ifndef MCK_GAME_ENG_TRIPLE_BUFFER_H
+#define MCK_GAME_ENG_TRIPLE_BUFFER_H
+
+// SDL includes (Linux/Windows specific)
+// This is required if cross-compiling for Windows *on Linux*
+#ifdef MCK_MINGW
+#include <SDL.h>
+#endif
+#ifndef MCK_MINGW
+// This is required if compiling on Linux or Windows (MinGW)
+#include <SDL2/SDL.h>
+#endif
+
+namespace MCK
+{
+
+//! Triple buffer of values of type T, for one writer thread and one reader thread
+/*! The writer fills the 'back' value, then publishes it.
+ *  The reader takes the most recently published value as
+ *  its 'front' value. The third value sits between them,
+ *  so neither thread ever waits for the other: if the
+ *  writer is faster, unread values are simply overwritten.
+ *  Values are swapped by index, never copied, so a value
+ *  (e.g. a vector) keeps its storage from use to use.
+ */
+template<class T>
+class GameEngTripleBuffer
+{
+    public:
+
+        //! Default constructor
+        GameEngTripleBuffer( void )
+        {
+            this->back = 0;
+            SDL_AtomicSet( &this->middle, 1 );
+            this->front = 2;
+        }
+
+        //! Get value being filled (writer thread only)
+        T& get_back( void ) noexcept
+        {
+            return this->values[ this->back ];
+        }
+
+        //! Publish value being filled, and start filling another (writer thread only)
+        void publish( void ) noexcept
+        {
+            const int PREV = SDL_AtomicSet(
+                &this->middle,
+                this->back | MCK::GameEngTripleBuffer<T>::FRESH
+            );
+            this->back = PREV & MCK::GameEngTripleBuffer<T>::INDEX_MASK;
+        }
+
+        //! Take most recently published value, if any (reader thread only)
+        /*! @returns True if a value was published since the last call
+         *  If false, 'get_front' is unchanged.
+         */
+        bool update_front( void ) noexcept
+        {
+            if( !( SDL_AtomicGet( &this->middle )
+                    & MCK::GameEngTripleBuffer<T>::FRESH )
+            )
+            {
+                return false;
+            }
+
+            // Only writer can make middle value fresh,
+            // so it is still fresh at this point
+            const int PREV = SDL_AtomicSet( &this->middle, this->front );
+            this->front = PREV & MCK::GameEngTripleBuffer<T>::INDEX_MASK;
+            return true;
+        }
+
+        //! Get most recently taken value (reader thread only)
+        const T& get_front( void ) const noexcept
+        {
+            return this->values[ this->front ];
+        }
+
+    protected:
+
+        // Disabled to prevent copying,
+        // as this would cause chaos
+        GameEngTripleBuffer(GameEngTripleBuffer const&) = delete;
+        void operator=(GameEngTripleBuffer const&)  = delete;
+
+        //! Mask of value index held in 'middle'
+        static const int INDEX_MASK = 0x03;
+
+        //! Flag held in 'middle' if value is published but not yet taken
+        static const int FRESH = 0x04;
+
+        //! Values
+        T values[ 3 ];
+
+        //! Index of value being filled by writer
+        int back;
+
+        //! Index of value between writer and reader (plus FRESH flag)
+        SDL_atomic_t middle;
+
+        //! Index of value held by reader
+        int front;
+};
+
+}  // End of namespace MCK
+
+#endif
@@ -41,13 +41,17 @@
 
 #include <map>  // For map
 #include <memory>  // For shared_ptr
+#include <set>  // For set
 #include <string>  // For string uses other than std output
+#include <unordered_map>  // For unordered_map
+#include <utility>  // For pair
 #include <vector>  // For vector
 
 #include "Defs.h"
 #include "GameEng.h"
 #include "GameEngRenderBlock.h"
 #include "GameEngRenderInfo.h"
+#include "GameEngTileMap.h"
 #include "ImageDataASCII.h"
 #include "Version.h"
 
@@ -91,12 +95,76 @@ class ImageMan
          *  Local palettes are order sensitive, so (for example)
          *  {0,1} and {1,0} will produce mutally inverted images.
          *  If a local palette already exists, ID of existing
-         *  palette will be returned.
+         *  palette will be returned (existing palettes are
+         *  found by a hash of their contents, so this takes
+         *  the same time however many palettes exist).
          */
         MCK_PAL_ID_TYPE create_local_palette(
             const std::shared_ptr<std::vector<uint8_t>> global_color_ids
         );
 
+        //! Create several local palettes at once, and return their IDs
+        /*! @param palettes: Vector of pointers to vectors of global colo(u)r IDs
+         *  @returns Palette IDs, in the same order as 'palettes'
+         *  Equivalent to calling 'create_local_palette' for each
+         *  palette, except that all palettes are checked before
+         *  any are created. Intended for procedurally generated
+         *  content.
+         */
+        std::vector<MCK_PAL_ID_TYPE> create_local_palettes(
+            const std::vector<std::shared_ptr<std::vector<uint8_t>>> &palettes
+        );
+
+        //! Create local palette with colo(u)rs that cycle, and return its ID
+        /*! @param global_color_ids: Vector of global colo(u)r IDs (copied)
+         *  Unlike 'create_local_palette', a new palette is always
+         *  created. Use 'add_palette_cycle' to choose which
+         *  colo(u)rs cycle, and 'update_palette_cycles' to
+         *  animate them.
+         *  Textures created with this palette are streaming
+         *  textures, and are updated in place as the palette
+         *  cycles, so any number of render infos can share
+         *  the animation at the cost of a single texture
+         *  update per image.
+         *  Note: Palette-indexed render blocks (see
+         *        'create_indexed_render_block') are not updated,
+         *        use 'change_indexed_render_block_palette' instead.
+         */
+        MCK_PAL_ID_TYPE create_cycling_palette(
+            const std::vector<uint8_t> &global_color_ids
+        );
+
+        //! Rotate a range of colo(u)rs within a cycling palette
+        /*! @param local_palette_id: ID returned by 'create_cycling_palette'
+         *  @param first_index: Index of first colo(u)r in range
+         *  @param num_indices: Number of colo(u)rs in range (at least 2)
+         *  @param ticks_per_step: Ticks (ms) between each rotation by one place
+         *  @param reverse: If true, colo(u)rs move towards lower indices
+         *  A palette may have several ranges (each with its own
+         *  speed), but ranges should not overlap.
+         */
+        void add_palette_cycle(
+            MCK_PAL_ID_TYPE local_palette_id,
+            uint8_t first_index,
+            uint8_t num_indices,
+            uint32_t ticks_per_step,
+            bool reverse = false
+        );
+
+        //! Advance all palette cycles, updating textures that have changed
+        /*! @param ticks: Current time (e.g. from GameEng::get_ticks)
+         *  @returns Number of textures updated
+         *  Call once per frame, before rendering. Only palettes
+         *  with a range that has moved on are updated.
+         */
+        size_t update_palette_cycles( uint32_t ticks );
+
+        //! Returns true if palette was created by 'create_cycling_palette'
+        bool is_cycling_palette( MCK_PAL_ID_TYPE local_palette_id ) const
+        {
+            return this->palette_cycles.count( local_palette_id ) > 0;
+        }
+
         //! Create a custom image (using shared pointer), and return its Image ID
         /*! @param pixel_data: Shared pointer to byte vector holding pixel data.
          *  @param pitch_per_pixel: Image width in pixels.
@@ -206,6 +274,85 @@ class ImageMan
             
         ) const;
 
+        //! Resolve texture of image and palette in advance, creating it if necessary
+        /*! @param image_id: ID of (an existing) image
+         *  @param local_palette_id: ID of existing local colo(u)r palette
+         *  @param handle: Handle to be set (see GameEng::acquire_tex_handle)
+         *  @param width_in_pixels: Set to width of image
+         *  @param height_in_pixels: Set to height of image
+         *  Note: The handle must be released by
+         *        GameEng::release_tex_handle once no longer needed.
+         */
+        void acquire_tex_handle(
+            MCK_IMG_ID_TYPE image_id,
+            MCK_PAL_ID_TYPE local_palette_id,
+            MCK::GameEngRenderInfo::TexHandle &handle,
+            uint16_t &width_in_pixels,
+            uint16_t &height_in_pixels
+        ) const;
+
+        //! Set texture of a tile number in tile map's tile set, creating texture if necessary
+        /*! @param tile_map: Pointer to tile map
+         *  @param tile: Tile number (see GameEng::set_tile_map_tile)
+         *  @param image_id: ID of (an existing) image
+         *  @param local_palette_id: ID of existing local colo(u)r palette
+         */
+        void set_tile_map_tile(
+            std::shared_ptr<MCK::GameEngTileMap> tile_map,
+            uint16_t tile,
+            MCK_IMG_ID_TYPE image_id,
+            MCK_PAL_ID_TYPE local_palette_id
+        ) const;
+
+        //! Resize destination rect of render info, for an image of a new size
+        /*! @param info: Render info object
+         *  @param width_in_pixels: Width of new image
+         *  @param height_in_pixels: Height of new image
+         *  @param keep_orig_dest_rect_width: If true, width is kept and height scaled to match
+         *  @param keep_orig_dest_rect_height: If true, height is kept and width scaled to match
+         *  Used by 'change_render_info_tex'.
+         */
+        static void fit_dest_rect(
+            MCK::GameEngRenderInfo &info,
+            uint16_t width_in_pixels,
+            uint16_t height_in_pixels,
+            bool keep_orig_dest_rect_width,
+            bool keep_orig_dest_rect_height
+        ) noexcept;
+
+        //! Create palette-indexed render block for specified image and colo(u)r palette
+        // @param image_id: ID of existing image
+        // @param local_palette_id: ID of existing local colo(u)r palette
+        // @param x_pos: Hoz screen pos of image (excluding any block offsets) 
+        // @param x_pos: Vert screen pos of image (excluding any block offsets) 
+        // @param width_in_pixels: image width, in window pixels
+        // @param height_in_pixels: image height, in window pixels
+        // @param owning_block: Pointer to block to which new block is assigned
+        // Notes: Unlike 'create_render_info', only one texture is
+        //        created per image, whatever palettes are used with
+        //        it, and the palette can be changed without creating
+        //        any textures (see 'change_indexed_render_block_palette').
+        //        The image is moved by changing the block's offsets.
+        //        See GameEng::create_indexed_texture for details.
+        std::shared_ptr<MCK::GameEngRenderBlock> create_indexed_render_block(
+            MCK_IMG_ID_TYPE image_id,
+            MCK_PAL_ID_TYPE local_palette_id,
+            int x_pos,
+            int y_pos,
+            uint16_t width_in_pixels,
+            uint16_t height_in_pixels,
+            std::shared_ptr<MCK::GameEngRenderBlock> parent_block
+        ) const;
+
+        //! Change local palette of block created by 'create_indexed_render_block'
+        /*! @param block: Pointer to palette-indexed render block
+         *  @param local_palette_id: ID of existing local colo(u)r palette
+         */
+        void change_indexed_render_block_palette(
+            std::shared_ptr<MCK::GameEngRenderBlock> block,
+            MCK_PAL_ID_TYPE local_palette_id
+        ) const;
+
         //! Assign new ASCII texture to render info object, keeping original dest_rect size
         /*! @param info: Pointer to render info object
          *  @param ascii_value: ASCII code (0-255) of desired char
@@ -259,6 +406,52 @@ class ImageMan
              return ascii_set < this->ascii_mappings.size();
         }
 
+        //! Obtain image ID for given ASCII code and ASCII set
+        /*! Useful for building a list of images for 'prewarm' */
+        MCK_IMG_ID_TYPE get_ascii_image_id(
+            uint8_t ascii_val,
+            uint8_t ascii_set = 0
+        ) const;
+
+        //! Image ID and local palette ID pair, for 'prewarm'
+        typedef std::pair<MCK_IMG_ID_TYPE,MCK_PAL_ID_TYPE> ImagePalettePair;
+
+        //! Progress callback, for 'prewarm'
+        /*! @param num_done: Number of textures created so far
+         *  @param num_total: Total number of textures to create
+         *  @param user_data: Pointer passed to 'prewarm'
+         *  This is called on the thread that called 'prewarm',
+         *  so may render and show a frame (e.g. a loading bar).
+         */
+        typedef void (*PrewarmProgressCallback)(
+            size_t num_done,
+            size_t num_total,
+            void* user_data
+        );
+
+        //! Create textures for image and palette pairs in advance
+        /*! @param images_and_palettes: Pairs of existing image and local palette IDs
+         *  @param progress_callback: Called after each texture is created (may be NULL)
+         *  @param user_data: Passed to 'progress_callback'
+         *  @param num_threads: Number of worker threads (zero for one less than number of CPUs)
+         *  Images are decoded in parallel by worker threads,
+         *  while the calling (render) thread creates the textures
+         *  as decoded images become available. Textures that
+         *  already exist (or are listed twice) are skipped.
+         *  Call this while loading, so that textures are not
+         *  created mid-game (by 'create_render_info' or
+         *  'change_render_info_tex'), which causes hitches.
+         *  Note: Must be called from the thread that initialized
+         *        GameEng, and must not run concurrently with
+         *        any other ImageMan method.
+         */
+        void prewarm(
+            const std::vector<MCK::ImageMan::ImagePalettePair> &images_and_palettes,
+            PrewarmProgressCallback progress_callback = NULL,
+            void* user_data = NULL,
+            int num_threads = 0
+        ) const;
+
 
     private:
 
@@ -362,6 +555,106 @@ class ImageMan
             std::shared_ptr<MCK::GameEngRenderBlock> parent_block
         ) const;
 
+        //! Image decoded (or being decoded) by 'prewarm'
+        struct PrewarmJob
+        {
+            MCK_IMG_ID_TYPE image_id;
+            MCK_PAL_ID_TYPE local_palette_id;
+            const MCK::ImageMan::ImageMetaData* meta_data;
+            const std::vector<uint8_t>* pixel_data;
+            const std::vector<uint8_t>* local_palette;
+
+            //! Decoded pixels
+            std::vector<uint32_t> pixels;
+            uint16_t height_in_pixels;
+
+            //! Flag to indicate decoding (or texture creation) failed
+            /*! Note: Error messages are empty unless
+             *        MCK_STD_OUT is defined, so only
+             *        this indicates failure.
+             */
+            bool failed;
+
+            //! Error message, if decoding failed
+            std::string error;
+
+            //! Set (to 1) by worker thread when done
+            SDL_atomic_t done;
+        };
+
+        //! Work shared by 'prewarm' worker threads
+        struct PrewarmWork
+        {
+            const MCK::GameEng* game_eng;
+            std::vector<MCK::ImageMan::PrewarmJob> jobs;
+
+            //! Index of next job to be taken by a worker thread
+            SDL_atomic_t next_job;
+
+            //! Posted once for each job done
+            SDL_sem* jobs_done;
+        };
+
+        //! Worker thread function for 'prewarm'
+        /*! @param data: Pointer to PrewarmWork
+         *  @returns Zero
+         */
+        static int prewarm_worker( void* data );
+
+        //! Hash of local palette contents, for 'palette_ids_by_color_ids'
+        struct PaletteHash
+        {
+            size_t operator()( const std::vector<uint8_t> &color_ids ) const noexcept
+            {
+                // FNV-1a
+                uint64_t hash = 0xCBF29CE484222325;
+                for( const uint8_t COLOR_ID : color_ids )
+                {
+                    hash = ( hash ^ COLOR_ID ) * 0x100000001B3;
+                }
+                return size_t( hash );
+            }
+        };
+
+        //! Range of colo(u)rs within a cycling palette
+        struct PaletteCycleRange
+        {
+            uint8_t first_index;
+            uint8_t num_indices;
+            uint32_t ticks_per_step;
+            bool reverse;
+
+            //! Number of places colo(u)rs are currently rotated by
+            uint8_t step;
+        };
+
+        //! Cycling palette
+        struct PaletteCycle
+        {
+            //! Colo(u)rs before any rotation
+            std::vector<uint8_t> base_color_ids;
+
+            std::vector<MCK::ImageMan::PaletteCycleRange> ranges;
+
+            //! Images with a texture using this palette
+            std::set<MCK_IMG_ID_TYPE> image_ids;
+        };
+
+        //! Record texture created with a cycling palette, only used internally
+        /*! Does nothing if palette is not cycling */
+        void register_cycling_texture(
+            MCK_IMG_ID_TYPE image_id,
+            MCK_PAL_ID_TYPE local_palette_id
+        ) const
+        {
+            std::map<MCK_PAL_ID_TYPE,MCK::ImageMan::PaletteCycle>::iterator it
+                = this->palette_cycles.find( local_palette_id );
+            if( it != this->palette_cycles.end() )
+            {
+                it->second.image_ids.insert( image_id );
+            }
+        }
+
         //! Private method for checks shared by both versions of create_custom_image
         void create_custom_image_quality_checks(
             uint8_t bits_per_pixel,
@@ -370,12 +663,6 @@ class ImageMan
             size_t pixel_data_size
         );
 
-        //! Private method to obtain image ID for given ASCII code and ASCII set
-        MCK_IMG_ID_TYPE get_ascii_image_id(
-            uint8_t ascii_val,
-            uint8_t ascii_set
-        ) const;
-
 
         bool initialized;
 
@@ -384,6 +671,19 @@ class ImageMan
         //! Store pointers to local palettes, indexed by their id 
         std::vector<std::shared_ptr<std::vector<uint8_t>>> palettes_by_id;
 
+        //! IDs of local palettes (except cycling palettes), by their contents
+        std::unordered_map<
+            std::vector<uint8_t>,
+            MCK_PAL_ID_TYPE,
+            MCK::ImageMan::PaletteHash
+        > palette_ids_by_color_ids;
+
+        //! Cycling palettes, by local palette ID
+        /*! This is mutable as textures are registered
+         *  by the (const) methods that create them.
+         */
+        mutable std::map<MCK_PAL_ID_TYPE,MCK::ImageMan::PaletteCycle> palette_cycles;
+
         //! Store pointers to image data, indexed by image ID
         std::vector<MCK::ImageMan::ImageMetaData> image_meta_data_by_id;
 
@@ -39,6 +39,7 @@
 #define MCK_SPRITE_H
 
 #include <memory>  // For shared pointer
+#include "GameEngProfiler.h"
 #include "SpriteAnimTime.h"
 #include "SpriteMotionConstVel.h"
 #include "SpriteCollisionCircle.h"
@@ -159,6 +160,10 @@ class Sprite : public MOTION, public ANIM, public COLL
         //! Process sprite, at current ticks
         void process( void )
         {
+#if defined MCK_PROFILE
+            MCK::GameEngProfiler::Zone zone( "Sprite::process" );
+#endif
+
             // Set sprite position
             try
             {
@@ -166,8 +171,10 @@ class Sprite : public MOTION, public ANIM, public COLL
             }
             catch( std::exception &e )
             {
+#if defined MCK_STD_OUT
                 std::cout << "Failed to set sprite position, error: "
                           << e.what() << std::endl;
+#endif
             }
 
             // Set sprite appearance
@@ -177,8 +184,10 @@ class Sprite : public MOTION, public ANIM, public COLL
             }
             catch( std::exception &e )
             {
+#if defined MCK_STD_OUT
                 std::cout << "Failed to set sprite appearance, error: "
                           << e.what() << std::endl;
+#endif
             }
 
             //    // TODO Process collisions
@@ -47,6 +47,16 @@ class SpriteAnimTime : public SpriteAnimBase
             this->use_offsets = false;
         }
 
+        //! Destructor
+        /*! Releases frame textures, once render info (which
+         *  may outlive this sprite) has its own reference
+         *  to its texture.
+         */
+        virtual ~SpriteAnimTime( void )
+        {
+            this->release_frames( this->frames );
+        }
+
         bool has_frames( void ) const noexcept
         {
             return this->frames.size() > 0;
@@ -83,28 +93,32 @@ class SpriteAnimTime : public SpriteAnimBase
 
             this->use_offsets = _use_offsets;
 
-            // Dummy pointer, pointing to NULL by default
-            // Explainer: using a NULL render info pointer
-            //            in the method call below instructs
-            //            the method to check/create texture only,
-            //            without affecting any actual render
-            //            info instance.
-            std::shared_ptr<MCK::GameEngRenderInfo> null_info_ptr;
-
-            // Create frame textures if necessary
-            for( auto &frm : _frames )
+            // Resolve frame textures (creating them if necessary),
+            // so that changing frame needs no look up
+            for( size_t i = 0; i < _frames.size(); i++ )
             {
+                // Caller's handles are copies, so hold no reference
+                _frames[ i ].tex_handle = MCK::GameEngRenderInfo::TexHandle();
                 try
                 {
-                    // Check/create texture (see explainer above)
-                    MCK::SpritePos::image_man->change_render_info_tex(
-                        null_info_ptr,
-                        frm.image_id,
-                        frm.palette_id
+                    MCK::SpritePos::image_man->acquire_tex_handle(
+                        _frames[ i ].image_id,
+                        _frames[ i ].palette_id,
+                        _frames[ i ].tex_handle,
+                        _frames[ i ].width_in_pixels,
+                        _frames[ i ].height_in_pixels
                     );
                 }
                 catch( std::exception &e )
                 {
+                    // Release handles already acquired
+                    for( size_t j = 0; j < i; j++ )
+                    {
+                        MCK::GameEng::release_tex_handle(
+                            _frames[ j ].tex_handle
+                        );
+                    }
+
                     throw( std::runtime_error(
 #if defined MCK_STD_OUT
                         std::string( "Cannot set frame as texture " )
@@ -118,10 +132,29 @@ class SpriteAnimTime : public SpriteAnimBase
             }
 
             std::swap( this->frames, _frames );
-            this->frame_num = starting_frame_num % this->frames.size();
-            this->select_frame( this->frame_num );
+
+            // With no previous frame, 'select_frame'
+            // always sets the texture
+            this->frame_num = this->frames.size();
+            this->select_frame( starting_frame_num % this->frames.size() );
+
+            // Release previous frames' textures
+            this->release_frames( _frames );
         }   
 
+        //! Set render info or render block associated with sprite
+        /* See SpritePos::set_render_instance */
+        virtual void set_render_instance(
+            std::shared_ptr<GameEngRenderBase> _render_instance
+        ) noexcept
+        {
+            // Previous instance may be using a frame texture,
+            // without a reference of its own
+            this->hold_render_info_tex();
+
+            this->SpritePos::set_render_instance( _render_instance );
+        }
+
         void next_frame( void )
         {
             this->select_frame( this->frame_num + 1 );
@@ -157,11 +190,11 @@ class SpriteAnimTime : public SpriteAnimBase
                     || PREV_FRM->palette_id != FRM->palette_id
                 )
                 {
-                    if( MCK::SpritePos::image_man == NULL )
+                    if( MCK::SpritePos::game_eng == NULL )
                     {
                         throw( std::runtime_error(
 #if defined MCK_STD_OUT
-                            "Cannot set new render texture as 'SpritePos::image_man' NULL."
+                            "Cannot set new render texture as 'SpritePos::game_eng' NULL."
 #else
                             ""
 #endif
@@ -173,38 +206,25 @@ class SpriteAnimTime : public SpriteAnimBase
                             == MCK::RenderInstanceType::INFO
                     )
                     {
-                        try
-                        {
-                            // GameEngRenderInfo
-                            image_man->change_render_info_tex(
-                                std::dynamic_pointer_cast<
-                                    MCK::GameEngRenderInfo
-                                >( this->SpritePos::render_instance ),
-                                FRM->image_id,
-                                FRM->palette_id,
-                                FRM->keep_orig_dest_rect_width,
-                                FRM->keep_orig_dest_rect_height
+                        // GameEngRenderInfo (safe, as type checked above)
+                        MCK::GameEngRenderInfo* const INFO
+                            = static_cast<MCK::GameEngRenderInfo*>(
+                                this->SpritePos::render_instance.get()
                             );
 
-                            // DEBUG
-                            MCK::GameEngRenderInfo::Rect dr
-                                = std::dynamic_pointer_cast<
-                                    MCK::GameEngRenderInfo
-                                >( this->SpritePos::render_instance )->dest_rect;
-                        }
-                        catch( std::exception &e )
-                        {
-                            throw( std::runtime_error(
-#if defined MCK_STD_OUT
-                                std::string( "Cannot update render info " )
-                                + std::string( "for select frame, error =  " )
-                                + e.what()
-#else
-                                ""
-#endif
-                            ) );
-                        }
-
+                        // Texture resolved in 'set_frames',
+                        // so this is just a pointer swap
+                        MCK::SpritePos::game_eng->set_render_info_tex_handle(
+                            *INFO,
+                            FRM->tex_handle
+                        );
+                        MCK::ImageMan::fit_dest_rect(
+                            *INFO,
+                            FRM->width_in_pixels,
+                            FRM->height_in_pixels,
+                            FRM->keep_orig_dest_rect_width,
+                            FRM->keep_orig_dest_rect_height
+                        );
                     }
                     else
                     {
@@ -242,8 +262,8 @@ class SpriteAnimTime : public SpriteAnimBase
                         == MCK::RenderInstanceType::INFO
                 )
                 {
-                    std::static_pointer_cast<MCK::GameEngRenderInfo>(
-                        this->MCK::SpritePos::render_instance
+                    static_cast<MCK::GameEngRenderInfo*>(
+                        this->MCK::SpritePos::render_instance.get()
                     )->set_flags( FRM->flags );
                 }
             }
@@ -282,6 +302,63 @@ class SpriteAnimTime : public SpriteAnimBase
 
     protected:
 
+        //! Make render info count itself as a user of its texture, only used internally
+        /*! While animating, render info uses frame textures
+         *  without a reference of its own (see 'set_frames'),
+         *  so this must be called before frame textures are
+         *  released or render info is replaced.
+         */
+        void hold_render_info_tex( void ) noexcept
+        {
+            // Nothing to do if no render info, or
+            // if GameEng destroyed (e.g. during exit)
+            if( this->SpritePos::render_instance.get() == NULL
+                || this->SpritePos::render_instance->get_type()
+                    != MCK::RenderInstanceType::INFO
+                || MCK::SpritePos::game_eng == NULL
+                || MCK::GameEngRenderInfo::tex_release_func() == NULL
+            )
+            {
+                return;
+            }
+
+            try
+            {
+                MCK::SpritePos::game_eng->hold_render_info_tex(
+                    *static_cast<MCK::GameEngRenderInfo*>(
+                        this->SpritePos::render_instance.get()
+                    )
+                );
+            }
+            catch( std::exception &e )
+            {
+#if defined MCK_STD_OUT && defined MCK_VERBOSE
+                std::cout << "Failed to hold render info texture, error = "
+                          << e.what() << std::endl;
+#endif
+            }
+        }
+
+        //! Release textures of frames, only used internally
+        void release_frames( std::vector<MCK::SpriteFrame> &_frames ) noexcept
+        {
+            if( _frames.size() == 0 )
+            {
+                return;
+            }
+
+            this->hold_render_info_tex();
+            for( auto &frm : _frames )
+            {
+                MCK::GameEng::release_tex_handle( frm.tex_handle );
+            }
+        }
+
+        // Disabled to prevent copying, as frames
+        // hold texture references
+        SpriteAnimTime(SpriteAnimTime const&) = delete;
+        void operator=(SpriteAnimTime const&)  = delete;
+
         std::vector<MCK::SpriteFrame> frames;
 
         size_t frame_num;
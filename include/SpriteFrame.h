@@ -31,6 +31,7 @@
 #define MCK_SPRITE_FRAME_H
 
 #include "Defs.h"
+#include "GameEngRenderInfo.h"
 
 namespace MCK
 {
@@ -46,6 +47,13 @@ struct SpriteFrame
     int offset_y;
     uint8_t flags;
 
+    //! Texture, resolved by SpriteAnimTime::set_frames
+    MCK::GameEngRenderInfo::TexHandle tex_handle;
+
+    //! Image size, resolved by SpriteAnimTime::set_frames
+    uint16_t width_in_pixels;
+    uint16_t height_in_pixels;
+
     //! Default constructor
     SpriteFrame( void )
     {
@@ -57,6 +65,8 @@ struct SpriteFrame
         this->offset_x = 0;
         this->offset_y = 0;
         this->flags = 0;
+        this->width_in_pixels = 0;
+        this->height_in_pixels = 0;
     }
 
     //! Constructor
@@ -79,7 +89,9 @@ struct SpriteFrame
         keep_orig_dest_rect_height( _keep_orig_dest_rect_height ),
         offset_x( _offset_x ),
         offset_y( _offset_y ),
-        flags( _flags )
+        flags( _flags ),
+        width_in_pixels( 0 ),
+        height_in_pixels( 0 )
     {}
 };
 
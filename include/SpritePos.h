@@ -149,8 +149,10 @@ class SpritePos
         //! Set render info or render block associated with sprite
         /* Note: Supplying a NULL pointer is acceptable, but means
          *       the sprite will not be rendered at present.
+         * Note: Virtual, so that animation classes can make
+         *       sure the previous instance keeps its texture.
          */
-        void set_render_instance(
+        virtual void set_render_instance(
             std::shared_ptr<GameEngRenderBase> _render_instance
         ) noexcept
         {
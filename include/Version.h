@@ -44,6 +44,16 @@
 // using MINGW
 // #define MCK_MINGW
 
+// Keep this commented OUT unless you want
+// a release build, i.e. no console output,
+// no error messages in exceptions and no
+// integrity checks during render.
+// (Alternatively, pass -DMCK_RELEASE to the
+// compiler, e.g. in a makefile's COMPILER_FLAGS)
+// #define MCK_RELEASE
+
+#ifndef MCK_RELEASE
+
 // Keep this commented IN unless you
 // want NO console output
 #define MCK_STD_OUT
@@ -58,3 +68,10 @@
 #define MCK_RENDER_INTEGRITY_CHK
 
 #endif
+
+// Keep this commented OUT unless you
+// want frame-time profiling
+// (see GameEngProfiler.h)
+// #define MCK_PROFILE
+
+#endif
@@ -178,12 +178,47 @@ MCK::GameEng::GameEng( void )
     // Set all variables to invalid/default values
     this->renderer = NULL;
     this->window = NULL;
+    this->headless = false;
+    this->frame_surface = NULL;
+    this->texture_format = SDL_PIXELFORMAT_ARGB8888;
+    this->texture_pixel_format = NULL;
+    this->use_compiled_render_list = false;
+    this->use_batched_render = false;
+    this->use_sub_pixel_render = false;
+    this->use_culling = false;
+    this->use_retained_frame = false;
+    this->retained_frame_tex = NULL;
+    this->atlas_max_image_size = 0;
+    this->max_texture_bytes = 0;
+    this->max_textures = 0;
+    this->texture_bytes = 0;
+    this->num_separate_textures = 0;
+    this->num_evicted_textures = 0;
+#if defined MCK_PROFILE
+    this->profile_prev_tex = NULL;
+#endif
+
+    // Render infos release their texture references
+    // through GameEng, while it exists
+    MCK::GameEngRenderInfo::tex_release_func()
+        = MCK::GameEng::release_render_info_tex;
+
+    // Likewise, render blocks tell GameEng when they
+    // are destroyed
+    MCK::GameEngRenderBlock::destroy_func()
+        = MCK::GameEng::render_block_destroyed;
 }
 
 ///////////////////////////////////////////////
 
 MCK::GameEng::~GameEng( void )
 {
+    // Render infos may outlive GameEng (e.g. if
+    // held by other static objects), so stop them
+    // releasing texture references
+    MCK::GameEngRenderInfo::tex_release_func() = NULL;
+    MCK::GameEngRenderBlock::destroy_func() = NULL;
+
 #if defined MCK_STD_OUT && defined MCK_VERBOSE
     std::cout << "Destroying all SDL textures..."
               << std::endl;
@@ -191,9 +226,17 @@ MCK::GameEng::~GameEng( void )
     bool all_textures_destroyed = true;
 #endif
 
-    for( auto& it : this->textures )
+    for( size_t i = 0; i < this->textures.get_num_slots(); i++ )
     {
-        SDL_Texture* const TEX = it.second;
+        // Atlas pages are destroyed separately
+        if( this->textures.get_key( i ) == MCK::INVALID_TEX_ID
+            || this->textures.get_value( i ).in_atlas
+        )
+        {
+            continue;
+        }
+
+        SDL_Texture* const TEX = this->textures.get_value( i ).tex;
         if( TEX != NULL )
         {
             try
@@ -214,6 +257,20 @@ MCK::GameEng::~GameEng( void )
         }
     }
     
+    for( uint16_t i = 0; i < this->atlas.get_num_pages(); i++ )
+    {
+        SDL_Texture* const TEX = this->atlas.get_page_tex( i );
+        if( TEX != NULL )
+        {
+            SDL_DestroyTexture( TEX );
+        }
+    }
+
+    if( this->retained_frame_tex != NULL )
+    {
+        SDL_DestroyTexture( this->retained_frame_tex );
+    }
+
 #if defined MCK_STD_OUT && defined MCK_VERBOSE
     if( all_textures_destroyed )
     {
@@ -239,6 +296,14 @@ MCK::GameEng::~GameEng( void )
     {
         SDL_DestroyWindow( this->window );
     }
+    if( this->frame_surface != NULL )
+    {
+        SDL_FreeSurface( this->frame_surface );
+    }
+    if( this->texture_pixel_format != NULL )
+    {
+        SDL_FreeFormat( this->texture_pixel_format );
+    }
 
     SDL_Quit();
 
@@ -314,11 +379,12 @@ void MCK::GameEng::init(
     }
     
     // Record window dimensions
-    this->window_height_in_pixels = WIDTH;
+    this->window_width_in_pixels = WIDTH;
     this->window_height_in_pixels = HEIGHT;
 
     // Try to initialize SDL2
-    int rc = SDL_Init( SDL_INIT_VIDEO );
+    // (video subsystem not needed if headless)
+    int rc = SDL_Init( this->headless ? SDL_INIT_EVENTS : SDL_INIT_VIDEO );
     if( rc < 0 )
     {
         throw( std::runtime_error(
@@ -385,54 +451,143 @@ void MCK::GameEng::init(
 #endif
     }
 
-    //Create SDL window
-    this->window = SDL_CreateWindow(
-        window_title,
-        window_initial_x_pos,
-        window_initial_y_pos,
-        WIDTH,
-        HEIGHT,
-        SDL_WINDOW_SHOWN
-    );  // No resize allowed
-    if( this->window == NULL )
+    if( this->headless )
     {
-        throw( std::runtime_error(
+        // Create surface to hold frame, and software
+        // renderer that draws onto it (no vsync)
+        this->frame_surface = SDL_CreateRGBSurfaceWithFormat(
+            0,  // Flags (unused)
+            WIDTH,
+            HEIGHT,
+            32,  // Bits per pixel
+            SDL_PIXELFORMAT_ARGB8888
+        );
+        if( this->frame_surface == NULL )
+        {
+            throw( std::runtime_error(
 #if defined MCK_STD_OUT
-            "Cannot create window with SDL2, SDL error:"
-            + *SDL_GetError()
+                std::string( "Cannot create frame surface with SDL2, " )
+                + std::string( "SDL error: " )
+                + SDL_GetError()
 #else
-            ""
+                ""
 #endif
-        ) );
+            ) );
+        }
+
+        this->renderer = SDL_CreateSoftwareRenderer( this->frame_surface );
+        if( this->renderer == NULL )
+        {
+            throw( std::runtime_error(
+#if defined MCK_STD_OUT
+                std::string( "Cannot create SDL2 software renderer, " )
+                + std::string( "SDL error: " )
+                + SDL_GetError()
+#else
+                ""
+#endif
+            ) );
+        }
+        else
+        {
+#if defined MCK_STD_OUT && defined MCK_VERBOSE
+            std::cout << "SDL2 software renderer created for "
+                      << "headless frame surface" << std::endl;
+#endif
+        }
     }
     else
     {
+        // Create SDL window
+        this->window = SDL_CreateWindow(
+            window_title,
+            window_initial_x_pos,
+            window_initial_y_pos,
+            WIDTH,
+            HEIGHT,
+            SDL_WINDOW_SHOWN
+        );  // No resize allowed
+        if( this->window == NULL )
+        {
+            throw( std::runtime_error(
+#if defined MCK_STD_OUT
+                "Cannot create window with SDL2, SDL error:"
+                + *SDL_GetError()
+#else
+                ""
+#endif
+            ) );
+        }
+        else
+        {
+#if defined MCK_STD_OUT && defined MCK_VERBOSE
+            std::cout << "Window created with SDL2" << std::endl;
+#endif
+        }
+
+        // Create renderer
+        this->renderer = SDL_CreateRenderer(
+            this->window,
+            -1,
+            SDL_RENDERER_ACCELERATED|SDL_RENDERER_PRESENTVSYNC );
+        if( this->renderer == NULL )
+        {
+            throw( std::runtime_error(
+#if defined MCK_STD_OUT
+                    "Cannot create SDL2 renderer, "
+                    "SDL Error: "
+                    + *SDL_GetError()
+#else
+                    ""
+#endif
+            ) );
+        }
+        else
+        {
 #if defined MCK_STD_OUT && defined MCK_VERBOSE
-        std::cout << "Window created with SDL2" << std::endl;
+            std::cout<< "SDL2 renderer created for window" << std::endl;
 #endif
+        }
     }
 
-    // Create renderer
-    this->renderer = SDL_CreateRenderer(
-        this->window,
-        -1,
-        SDL_RENDERER_ACCELERATED|SDL_RENDERER_PRESENTVSYNC );
-    if( this->renderer == NULL )
+    // Choose texture format: the renderer's preferred 32bit
+    // format with alpha, so that uploads need no conversion
     {
-        throw( std::runtime_error(
+        SDL_RendererInfo info;
+        if( SDL_GetRendererInfo( this->renderer, &info ) == 0 )
+        {
+            for( Uint32 i = 0; i < info.num_texture_formats; i++ )
+            {
+                const Uint32 FORMAT = info.texture_formats[ i ];
+                if( !SDL_ISPIXELFORMAT_FOURCC( FORMAT )
+                    && SDL_BITSPERPIXEL( FORMAT ) == 32
+                    && SDL_ISPIXELFORMAT_ALPHA( FORMAT )
+                )
+                {
+                    this->texture_format = FORMAT;
+                    break;
+                }
+            }
+        }
+
+        this->texture_pixel_format = SDL_AllocFormat( this->texture_format );
+        if( this->texture_pixel_format == NULL )
+        {
+            throw( std::runtime_error(
 #if defined MCK_STD_OUT
-                "Cannot create SDL2 renderer, "
-                "SDL Error: "
-                + *SDL_GetError()
+                std::string( "Cannot allocate texture pixel format, " )
+                + std::string( "SDL error: " )
+                + SDL_GetError()
 #else
                 ""
 #endif
-        ) );
-    }
-    else
-    {
+            ) );
+        }
+
 #if defined MCK_STD_OUT && defined MCK_VERBOSE
-        std::cout<< "SDL2 renderer created for window" << std::endl;
+        std::cout << "Texture format: "
+                  << SDL_GetPixelFormatName( this->texture_format )
+                  << std::endl;
 #endif
     }
 
@@ -635,12 +790,105 @@ void MCK::GameEng::init(
 
 ///////////////////////////////////////////////
 
+void MCK::GameEng::init_headless(
+    uint16_t _frame_width_in_pixels,
+    uint16_t _frame_height_in_pixels
+)
+{
+    if( this->initialized )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot create game engine (SDL2) as SDL already init."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    this->headless = true;
+    try
+    {
+        this->init(
+            "",  // Window title (unused)
+            0,  // Window x pos (unused)
+            0,  // Window y pos (unused)
+            _frame_width_in_pixels,
+            _frame_height_in_pixels
+        );
+    }
+    catch( std::exception &e )
+    {
+        this->headless = false;
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Failed to initialize headless game engine, " )
+            + std::string( "error = " )
+            + e.what()
+#else
+            ""
+#endif
+        ) );
+    }
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::read_frame_pixels( std::vector<uint32_t> &pixels ) const
+{
+    if( !this->initialized )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot read frame pixels as game engine not init."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    pixels.resize(
+        size_t( this->window_width_in_pixels )
+            * size_t( this->window_height_in_pixels )
+    );
+    if( pixels.empty() )
+    {
+        return;
+    }
+
+    if( SDL_RenderReadPixels(
+            this->renderer,
+            NULL,  // Entire frame
+            SDL_PIXELFORMAT_ARGB8888,
+            pixels.data(),
+            this->window_width_in_pixels * sizeof( uint32_t )
+        ) != 0
+    )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Failed to read frame pixels, " )
+            + std::string( "SDL error: " )
+            + SDL_GetError()
+#else
+            ""
+#endif
+        ) );
+    }
+}
+
+///////////////////////////////////////////////
+
 void MCK::GameEng::render_all( 
     std::shared_ptr<MCK::GameEngRenderBlock> render_block,
     int16_t hoz_offset,
     int16_t vert_offset
 ) const
 {
+#if defined MCK_PROFILE
+    MCK::GameEngProfiler::Zone zone( "render_all" );
+#endif
+
     if( !this->initialized || this->renderer == NULL )
     {
         throw( std::runtime_error(
@@ -665,100 +913,339 @@ void MCK::GameEng::render_all(
         return;
     }
 
-    // Calculate cumulative offset for this render block
-    const int16_t HOZ_OFFSET = hoz_offset + render_block->hoz_offset;
-    const int16_t VERT_OFFSET = vert_offset + render_block->vert_offset;
-
-    // Check for offset
-    if( HOZ_OFFSET == 0 && VERT_OFFSET == 0 )
+    // If enabled, render from compiled render list
+    if( this->use_compiled_render_list )
     {
-        ///////////////////////////////////////
-        // If no offset, use a faster loop
+        this->render_compiled( render_block.get(), hoz_offset, vert_offset );
+        return;
+    }
 
-        // Iterate over all render instances in block
-        for( const auto it : render_block->render_instances )
-        {
-            // Get pointer to item
-            const std::shared_ptr<MCK::GameEngRenderBase> item = it.second;
+    this->render_sub_tree(
+        render_block.get(),
+        hoz_offset,
+        vert_offset,
+        0  // Top-level block
+    );
+}
 
-            // Ignore NULL items
-            if( item.get() == NULL )
-            {
-#if defined MCK_RENDER_INTEGRITY_CHK && defined MCK_STD_OUT
-                std::cout << "NULL item found during render"
-                          << std::endl;
-#endif
-                continue;
-            }
+///////////////////////////////////////////////
 
-#if defined MCK_RENDER_INTEGRITY_CHK && defined MCK_STD_OUT
-            if( it.first != item->render_order )
-            {
-                std::cout << "WARNING: Render order of item (0x"
-                          << std::hex << item->render_order
-                          << ") differs from key (0x"
-                          << it.first
-                          << "). Blocks and/or images may be "
-                          << "rendered in wrong order!"
-                          << std::dec << std::endl;
-            }
+void MCK::GameEng::publish_render_snapshot(
+    std::shared_ptr<MCK::GameEngRenderBlock> render_block,
+    int16_t hoz_offset,
+    int16_t vert_offset
+) const
+{
+#if defined MCK_PROFILE
+    MCK::GameEngProfiler::Zone zone( "publish_render_snapshot" );
 #endif
 
-#ifdef MCK_RENDER_INTEGRITY_CHK
-            // Check parentage
-            if( item->parent_block != render_block.get() )
-            {
+    if( !this->initialized || this->renderer == NULL )
+    {
+        throw( std::runtime_error(
 #if defined MCK_STD_OUT
-                std::cout << "Cuckoo item found during render, ignoring."
-                          << std::endl;
-#endif
-                continue;
-            }
+            "Cannot publish render snapshot as SDL not yet init."
+#else
+            ""
 #endif
+        ) );
+    }
 
-            // If item is GameEngRenderInfo instance,
-            // process accordingly
-            if( item->get_type() == MCK::RenderInstanceType::INFO )
-            {
-#ifdef MCK_RENDER_INTEGRITY_CHK
-                std::shared_ptr<MCK::GameEngRenderInfo> info
-                    = std::dynamic_pointer_cast<MCK::GameEngRenderInfo>(
-                        item
-                    );
-                if( info->tex == NULL )
-                {
+    // Retained frame would be composited over
+    // snapshot by 'show'
+    if( this->use_retained_frame )
+    {
+        throw( std::runtime_error(
 #if defined MCK_STD_OUT
-                    std::cout << "NULL texture found during render"
-                              << std::endl;
+            "Cannot publish render snapshot while retained frame enabled."
+#else
+            ""
 #endif
-                    continue;
-                }
+        ) );
+    }
+
+    // Check if supplied render block is prime render block
+    const bool IS_PRIME
+        = render_block.get() == this->prime_render_block.get();
+
+    // If supplied block NULL, or inactive (except prime
+    // render block), publish empty snapshot
+    if( render_block.get() == NULL
+        || ( !IS_PRIME && !render_block->active )
+    )
+    {
+        this->render_list.items.clear();
+    }
+    else
+    {
+        this->update_render_list_items(
+            render_block.get(),
+            hoz_offset,
+            vert_offset,
+            false  // Retained frame not used
+        );
+    }
+
+    // Swap, rather than copy, draw commands into snapshot,
+    // so no memory is allocated once vectors are large enough
+    std::swap(
+        this->render_snapshots.get_back(),
+        this->render_list.items
+    );
+    this->render_list.items_valid = false;
+    this->render_snapshots.publish();
+}
+
+///////////////////////////////////////////////
+
+bool MCK::GameEng::render_snapshot( void ) const
+{
+#if defined MCK_PROFILE
+    MCK::GameEngProfiler::Zone zone( "render_snapshot" );
 #endif
 
-                try
-                {
-                    item->render( renderer );
-                }
-                catch( const std::exception &e )
-                {
-                    throw( std::runtime_error(
+    if( !this->initialized || this->renderer == NULL )
+    {
+        throw( std::runtime_error(
 #if defined MCK_STD_OUT
-                        std::string( "Failed to render instance, error = " )
+            "Cannot render snapshot as SDL not yet init."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    // Retained frame would be composited over
+    // snapshot by 'show'
+    if( this->use_retained_frame )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot render snapshot while retained frame enabled."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    const bool IS_NEW = this->render_snapshots.update_front();
+    this->render_items( this->render_snapshots.get_front() );
+    return IS_NEW;
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::render_sub_tree( 
+    const MCK::GameEngRenderBlock* render_block,
+    int16_t hoz_offset,
+    int16_t vert_offset,
+    unsigned depth
+) const
+{
+#if defined MCK_PROFILE
+    // Zones are named by depth of block
+    MCK::GameEngProfiler::Zone zone(
+        MCK::GameEngProfiler::get_block_depth_zone_name( depth )
+    );
+#endif
+
+    // Calculate cumulative offset for this render block
+    const int16_t HOZ_OFFSET = hoz_offset + render_block->hoz_offset;
+    const int16_t VERT_OFFSET = vert_offset + render_block->vert_offset;
+
+    // If none of this block's own images are on screen,
+    // only its sub-blocks need be considered
+    if( this->use_culling )
+    {
+        render_block->update_bounds();
+        if( !this->is_on_screen(
+                render_block->bounds,
+                HOZ_OFFSET,
+                VERT_OFFSET
+            )
+        )
+        {
+            for( const MCK::GameEngRenderBlock* const BLOCK
+                    : render_block->sub_blocks
+            )
+            {
+                // Ignore inactive sub-blocks
+                if( !BLOCK->active )
+                {
+                    continue;
+                }
+
+                try
+                {
+                    this->render_sub_tree(
+                        BLOCK,
+                        HOZ_OFFSET,
+                        VERT_OFFSET,
+                        depth + 1
+                    );
+                }
+                catch( std::exception &e )
+                {
+#if defined MCK_STD_OUT
+                    // Issue warning but do not throw,
+                    // as we can try rendering other sub-blocks
+                    std::cout << "(3)Failed to render sub-block, "
+                              << "error = "
+                              << e.what() << std::endl;
+#endif
+                }
+            }
+            return;
+        }
+    }
+
+    // Check for offset
+    if( HOZ_OFFSET == 0 && VERT_OFFSET == 0 )
+    {
+        ///////////////////////////////////////
+        // If no offset, use a faster loop
+
+        // Iterate over all render instances in block
+        // (by reference, to avoid copying shared pointers)
+        for( const auto &it : render_block->render_instances )
+        {
+            // Get pointer to item
+            const MCK::GameEngRenderBase* const ITEM = it.second.get();
+#if defined MCK_PROFILE
+            this->profile_counts.num_instances_visited++;
+#endif
+
+            // Ignore NULL items
+            if( ITEM == NULL )
+            {
+#if defined MCK_RENDER_INTEGRITY_CHK && defined MCK_STD_OUT
+                std::cout << "NULL item found during render"
+                          << std::endl;
+#endif
+                continue;
+            }
+
+#if defined MCK_RENDER_INTEGRITY_CHK && defined MCK_STD_OUT
+            if( it.first != ITEM->render_order )
+            {
+                std::cout << "WARNING: Render order of item (0x"
+                          << std::hex << ITEM->render_order
+                          << ") differs from key (0x"
+                          << it.first
+                          << "). Blocks and/or images may be "
+                          << "rendered in wrong order!"
+                          << std::dec << std::endl;
+            }
+#endif
+
+#ifdef MCK_RENDER_INTEGRITY_CHK
+            // Check parentage
+            if( ITEM->parent_block != render_block )
+            {
+#if defined MCK_STD_OUT
+                std::cout << "Cuckoo item found during render, ignoring."
+                          << std::endl;
+#endif
+                continue;
+            }
+#endif
+
+            // If item is GameEngRenderInfo instance,
+            // process accordingly
+            if( ITEM->get_type() == MCK::RenderInstanceType::INFO )
+            {
+#ifdef MCK_RENDER_INTEGRITY_CHK
+                if( static_cast<const MCK::GameEngRenderInfo*>(
+                        ITEM
+                    )->tex == NULL
+                )
+                {
+#if defined MCK_STD_OUT
+                    std::cout << "NULL texture found during render"
+                              << std::endl;
+#endif
+                    continue;
+                }
+#endif
+
+                // Ignore images outside game window
+                if( this->use_culling )
+                {
+                    SDL_Rect bounds;
+                    static_cast<const MCK::GameEngRenderInfo*>(
+                        ITEM
+                    )->get_bounds( bounds );
+                    if( !this->is_on_screen( bounds, 0, 0 ) )
+                    {
+                        continue;
+                    }
+                }
+
+#if defined MCK_PROFILE
+                this->profile_draw_call(
+                    static_cast<const MCK::GameEngRenderInfo*>( ITEM )->tex
+                );
+#endif
+
+#ifdef MCK_RENDER_INTEGRITY_CHK
+                try
+                {
+                    ITEM->render( renderer );
+                }
+                catch( const std::exception &e )
+                {
+                    throw( std::runtime_error(
+#if defined MCK_STD_OUT
+                        std::string( "Failed to render instance, error = " )
                         + e.what()
 #else
                         ""
 #endif
                     ) );
                 }
+#else
+                // No exceptions expected, as
+                // render only calls SDL
+                ITEM->render( renderer );
+#endif
+            }
+            else if( ITEM->get_type() == MCK::RenderInstanceType::TILE_MAP )
+            {
+                // Draw only cells within game window
+                std::vector<MCK::GameEngRenderList::Item> &items
+                    = this->render_list.tile_map_items;
+                items.clear();
+                this->add_tile_map_items(
+                    static_cast<const MCK::GameEngTileMap*>( ITEM ),
+                    0,  // No x offset needed
+                    0,  // No y offset needed
+                    0,  // No sub-pixel offsets
+                    0,
+                    items
+                );
+                for( const auto &item : items )
+                {
+                    this->render_item( item );
+                }
             }
-            else if( item->get_type() == MCK::RenderInstanceType::BLOCK )
+            else if( ITEM->get_type() == MCK::RenderInstanceType::BLOCK )
             {
+                const MCK::GameEngRenderBlock* const BLOCK
+                    = static_cast<const MCK::GameEngRenderBlock*>( ITEM );
+
+                // Ignore inactive sub-blocks
+                if( !BLOCK->active )
+                {
+                    continue;
+                }
+
                 try
                 {
-                    this->render_all(
-                        std::dynamic_pointer_cast<MCK::GameEngRenderBlock>( item ),
+                    this->render_sub_tree(
+                        BLOCK,
                         0,  // No x offset needed
-                        0  // No y offset needed
+                        0,  // No y offset needed
+                        depth + 1
                     );
                 }
                 catch( std::exception &e )
@@ -788,13 +1275,17 @@ void MCK::GameEng::render_all(
         // destination rectangle separately
 
         // Iterate over all render instances in block
-        for( const auto it : render_block->render_instances )
+        // (by reference, to avoid copying shared pointers)
+        for( const auto &it : render_block->render_instances )
         {
             // Get pointer to item
-            const std::shared_ptr<MCK::GameEngRenderBase> item = it.second;
+            const MCK::GameEngRenderBase* const ITEM = it.second.get();
+#if defined MCK_PROFILE
+            this->profile_counts.num_instances_visited++;
+#endif
             
             // Ignore NULL pointers and NULL textures
-            if( item.get() == NULL )
+            if( ITEM == NULL )
             {
 #if defined MCK_RENDER_INTEGRITY_CHK && defined MCK_STD_OUT
                 std::cout << "(2)NULL item found during render"
@@ -805,7 +1296,7 @@ void MCK::GameEng::render_all(
 
 #ifdef MCK_RENDER_INTEGRITY_CHK
             // Check parentage
-            if( item->parent_block != render_block.get() )
+            if( ITEM->parent_block != render_block )
             {
 #if defined MCK_STD_OUT
                 std::cout << "(2)Cuckoo item found during render, ignoring."
@@ -815,14 +1306,13 @@ void MCK::GameEng::render_all(
             }
 #endif
 
-            if( item->get_type() == MCK::RenderInstanceType::INFO )
+            if( ITEM->get_type() == MCK::RenderInstanceType::INFO )
             {
-                std::shared_ptr<MCK::GameEngRenderInfo> info
-                    = std::dynamic_pointer_cast<MCK::GameEngRenderInfo>(
-                        item
-                    );
+                // Type already checked, so no need for dynamic cast
+                const MCK::GameEngRenderInfo* const INFO
+                    = static_cast<const MCK::GameEngRenderInfo*>( ITEM );
 
-                if( info->tex == NULL )
+                if( INFO->tex == NULL )
                 {
 #if defined MCK_RENDER_INTEGRITY_CHK && defined MCK_STD_OUT
                     std::cout << "(2)NULL texture found during render"
@@ -831,20 +1321,53 @@ void MCK::GameEng::render_all(
                     continue;
                 }
 
+                // Ignore images made invisible by colo(u)r modulation
+                if( INFO->color_mod.a == 0 )
+                {
+                    continue;
+                }
+
+                // Ignore images outside game window
+                if( this->use_culling )
+                {
+                    SDL_Rect bounds;
+                    INFO->get_bounds( bounds );
+                    if( !this->is_on_screen( bounds, HOZ_OFFSET, VERT_OFFSET ) )
+                    {
+                        continue;
+                    }
+                }
+
                 // Get offset destination rectangle
-                SDL_Rect dest = info->dest_rect.r;
+                SDL_Rect dest = INFO->dest_rect.r;
                 dest.x += HOZ_OFFSET;
                 dest.y += VERT_OFFSET;
 
+                // Get source rectangle
+                SDL_Rect src_buffer;
+                const SDL_Rect* const SRC_RECT
+                    = INFO->get_src_rect( src_buffer );
+
+                const bool COLOR_MOD
+                    = MCK::GameEngRenderInfo::set_tex_color_mod(
+                        INFO->tex,
+                        INFO->color_mod
+                    );
+
+#if defined MCK_PROFILE
+                this->profile_draw_call( INFO->tex );
+#endif
+
                 // If no flags, use simpler command
-                if( info->flags == 0 )
+                if( INFO->flags == 0 )
                 {
+#ifdef MCK_RENDER_INTEGRITY_CHK
                     try
                     {
                         SDL_RenderCopy(
                             this->renderer,
-                            info->tex,
-                            info->clip ? &info->clip_rect.r : NULL,
+                            INFO->tex,
+                            SRC_RECT,
                             &dest
                         );
                     }
@@ -855,35 +1378,35 @@ void MCK::GameEng::render_all(
                                   << SDL_GetError() << std::endl;
 #endif
                     }
+#else
+                    SDL_RenderCopy(
+                        this->renderer,
+                        INFO->tex,
+                        SRC_RECT,
+                        &dest
+                    );
+#endif
                 }
                 else
                 {
-                    // Get rotation angle (in degrees)
-                    const double ANGLE
-                        = ( 
-                            ( info->flags & MCK::GameEngRenderInfo::ROTATION_MASK )
-                                >> MCK::GameEngRenderInfo::ROTATION_RSHIFT
-                        ) * 90.0f;
-               
-                    // Get flip
-                    SDL_RendererFlip flip = SDL_FLIP_NONE;
-                    if( info->get_flip_x() )
-                    {
-                        flip = SDL_RendererFlip( flip | SDL_FLIP_HORIZONTAL );
-                    }
-                    if( info->get_flip_y() )
-                    {
-                        flip = SDL_RendererFlip( flip | SDL_FLIP_VERTICAL );
-                    }
+                    // Get rotation angle (in degrees) and flip
+                    double angle;
+                    SDL_RendererFlip flip;
+                    MCK::GameEngRenderInfo::calc_angle_and_flip(
+                        INFO->flags,
+                        angle,
+                        flip
+                    );
                     
+#ifdef MCK_RENDER_INTEGRITY_CHK
                     try
                     {
                         SDL_RenderCopyEx(
                             this->renderer,
-                            info->tex,
-                            info->clip ? &info->clip_rect.r : NULL,
+                            INFO->tex,
+                            SRC_RECT,
                             &dest,
-                            ANGLE,
+                            angle,
                             NULL,  // Rotate about centre
                             flip
                         );
@@ -895,16 +1418,61 @@ void MCK::GameEng::render_all(
                                   << SDL_GetError() << std::endl;
 #endif
                     }
+#else
+                    SDL_RenderCopyEx(
+                        this->renderer,
+                        INFO->tex,
+                        SRC_RECT,
+                        &dest,
+                        angle,
+                        NULL,  // Rotate about centre
+                        flip
+                    );
+#endif
+                }
+
+                if( COLOR_MOD )
+                {
+                    MCK::GameEngRenderInfo::clear_tex_color_mod( INFO->tex );
+                }
+            }
+            else if( ITEM->get_type() == MCK::RenderInstanceType::TILE_MAP )
+            {
+                // Draw only cells within game window
+                std::vector<MCK::GameEngRenderList::Item> &items
+                    = this->render_list.tile_map_items;
+                items.clear();
+                this->add_tile_map_items(
+                    static_cast<const MCK::GameEngTileMap*>( ITEM ),
+                    HOZ_OFFSET,
+                    VERT_OFFSET,
+                    0,  // No sub-pixel offsets
+                    0,
+                    items
+                );
+                for( const auto &item : items )
+                {
+                    this->render_item( item );
                 }
             }
-            else if( item->get_type() == MCK::RenderInstanceType::BLOCK )
+            else if( ITEM->get_type() == MCK::RenderInstanceType::BLOCK )
             {
+                const MCK::GameEngRenderBlock* const BLOCK
+                    = static_cast<const MCK::GameEngRenderBlock*>( ITEM );
+
+                // Ignore inactive sub-blocks
+                if( !BLOCK->active )
+                {
+                    continue;
+                }
+
                 try
                 {
-                    this->render_all(
-                        std::dynamic_pointer_cast<MCK::GameEngRenderBlock>( item ),
+                    this->render_sub_tree(
+                        BLOCK,
                         HOZ_OFFSET,
-                        VERT_OFFSET
+                        VERT_OFFSET,
+                        depth + 1
                     );
                 }
                 catch( std::exception &e )
@@ -931,73 +1499,1814 @@ void MCK::GameEng::render_all(
     }
 }
 
-void MCK::GameEng::create_texture(
-    MCK_IMG_ID_TYPE image_id,
-    MCK_PAL_ID_TYPE local_palette_id,
-    uint8_t bits_per_pixel,
-    uint16_t pitch_in_pixels,
-    const std::vector<uint8_t> &pixel_data,
-    const std::vector<uint8_t> &local_palette,
-    MCK_TEX_ID_TYPE &tex_id,
-    uint16_t &height_in_pixels,
-    bool throw_if_exists
-)
-{
-    // Set answers to default
-    tex_id = 0;
-    height_in_pixels = 0;
+///////////////////////////////////////////////
+
+void MCK::GameEng::add_tile_map_items(
+    const MCK::GameEngTileMap* tile_map,
+    int hoz_offset,
+    int vert_offset,
+    uint8_t hoz_sub_offset,
+    uint8_t vert_sub_offset,
+    std::vector<MCK::GameEngRenderList::Item> &items
+) const
+{
+    const int CELL_WIDTH = tile_map->cell_width;
+    const int CELL_HEIGHT = tile_map->cell_height;
+    if( CELL_WIDTH == 0 || CELL_HEIGHT == 0 )
+    {
+        return;
+    }
+
+    // Position of cell (0,0) in game window
+    const int LEFT = hoz_offset + tile_map->x - tile_map->scroll_x;
+    const int TOP = vert_offset + tile_map->y - tile_map->scroll_y;
+
+    // Calculate range of cells within game window
+    // (including cells ending exactly at its left or
+    // top edge, which fractions of a pixel may reveal)
+    // Note: Integer division rounds towards zero,
+    //       so it is only applied to positive values
+    const int SPAN_X = int( this->window_width_in_pixels ) - LEFT;
+    const int SPAN_Y = int( this->window_height_in_pixels ) - TOP;
+    const int COL_BEGIN = LEFT < 0 ? ( -LEFT - 1 ) / CELL_WIDTH : 0;
+    const int ROW_BEGIN = TOP < 0 ? ( -TOP - 1 ) / CELL_HEIGHT : 0;
+    const int COL_END
+        = SPAN_X <= 0
+            ? 0
+            : std::min(
+                int( tile_map->width_in_cells ),
+                ( SPAN_X + CELL_WIDTH - 1 ) / CELL_WIDTH
+            );
+    const int ROW_END
+        = SPAN_Y <= 0
+            ? 0
+            : std::min(
+                int( tile_map->height_in_cells ),
+                ( SPAN_Y + CELL_HEIGHT - 1 ) / CELL_HEIGHT
+            );
+
+    MCK::GameEngRenderList::Item item;
+    item.flags = 0;
+    item.color_mod.r = 0xFF;
+    item.color_mod.g = 0xFF;
+    item.color_mod.b = 0xFF;
+    item.color_mod.a = 0xFF;
+    item.dest_rect.w = CELL_WIDTH;
+    item.dest_rect.h = CELL_HEIGHT;
+    item.hoz_sub_offset = hoz_sub_offset;
+    item.vert_sub_offset = vert_sub_offset;
+
+    // Note: As EMPTY_CELL cannot be given a texture,
+    //       the tile set is always smaller than it
+    const size_t NUM_TILES = tile_map->tiles.size();
+    for( int row = ROW_BEGIN; row < ROW_END; row++ )
+    {
+        const uint16_t* const CELLS
+            = &tile_map->cells[
+                  size_t( row ) * size_t( tile_map->width_in_cells )
+              ];
+        item.dest_rect.y = TOP + row * CELL_HEIGHT;
+
+        for( int col = COL_BEGIN; col < COL_END; col++ )
+        {
+            // Ignore empty cells, and tiles without texture
+            const uint16_t TILE = CELLS[ col ];
+            if( TILE >= NUM_TILES )
+            {
+                continue;
+            }
+            const MCK::GameEngRenderInfo::TexHandle &HANDLE
+                = tile_map->tiles[ TILE ];
+            if( HANDLE.tex == NULL )
+            {
+                continue;
+            }
+
+            item.tex = HANDLE.tex;
+            item.clip = HANDLE.in_atlas;
+            if( item.clip )
+            {
+                item.clip_rect = HANDLE.atlas_rect;
+            }
+            item.dest_rect.x = LEFT + col * CELL_WIDTH;
+            items.push_back( item );
+        }
+    }
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::render_compiled(
+    const MCK::GameEngRenderBlock* render_block,
+    int16_t hoz_offset,
+    int16_t vert_offset
+) const
+{
+    MCK::GameEngRenderList &rl = this->render_list;
+    rl.dirty_rects.clear();
+
+    this->update_render_list_items(
+        render_block,
+        hoz_offset,
+        vert_offset,
+        this->use_retained_frame
+    );
+
+    // Submit draw commands (if retained frame
+    // in use, only areas that have changed)
+    if( this->use_retained_frame )
+    {
+        this->render_retained_frame();
+        return;
+    }
+    this->render_items( rl.items );
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::update_render_list_items(
+    const MCK::GameEngRenderBlock* render_block,
+    int16_t hoz_offset,
+    int16_t vert_offset,
+    bool track_changes
+) const
+{
+#if defined MCK_PROFILE
+    MCK::GameEngProfiler::Zone zone( "render_list update" );
+#endif
+
+    MCK::GameEngRenderList &rl = this->render_list;
+
+    // If list was compiled from a different block
+    // (or not at all), compile from scratch
+    if( rl.root != render_block )
+    {
+        rl.clear();
+        rl.scratch_slots.clear();
+        rl.scratch_entries.clear();
+        this->compile_render_block(
+            render_block,
+            MCK::GameEngRenderList::NO_PARENT,
+            0,
+            0
+        );
+        std::swap( rl.slots, rl.scratch_slots );
+        std::swap( rl.entries, rl.scratch_entries );
+        rl.root = render_block;
+    }
+    else
+    {
+        // Re-compile any blocks that have changed.
+        // Note: As parent slots precede child slots, a
+        //       block that has been removed from the tree
+        //       is always discarded (along with its
+        //       parent's old contents) before its
+        //       own slot is reached.
+        uint32_t slot = 0;
+        while( slot < rl.slots.size() )
+        {
+            if( rl.slots[ slot ].revision
+                    != rl.slots[ slot ].block->revision
+            )
+            {
+                this->recompile_render_list_slot( slot );
+
+                // Skip descendants, as these are now up to date
+                slot = rl.slots[ slot ].slot_end;
+            }
+            else
+            {
+                slot++;
+            }
+        }
+    }
+
+    // Calculate cumulative offsets and visibility of
+    // each block. As parent slots precede child slots,
+    // a single pass is sufficient. The draw commands of
+    // a block's own entries only need regenerating if
+    // these (or the block's contents) have changed.
+    bool any_changed = false;
+    for( auto &s : rl.slots )
+    {
+        const MCK::GameEngRenderBlock* const BLOCK = s.block;
+        const MCK::GameEngRenderList::BlockSlot PREV = s;
+        if( s.parent_slot == MCK::GameEngRenderList::NO_PARENT )
+        {
+            // Activity of top-level block already checked
+            s.hoz_offset = hoz_offset + BLOCK->hoz_offset;
+            s.vert_offset = vert_offset + BLOCK->vert_offset;
+            s.visible = true;
+        }
+        else
+        {
+            const MCK::GameEngRenderList::BlockSlot &PARENT
+                = rl.slots[ s.parent_slot ];
+            s.hoz_offset = PARENT.hoz_offset + BLOCK->hoz_offset;
+            s.vert_offset = PARENT.vert_offset + BLOCK->vert_offset;
+            s.visible = PARENT.visible && BLOCK->active;
+        }
+
+        // Add fractions of a pixel (sub-pixel rendering only),
+        // carrying any whole pixels into the integer offsets
+        s.hoz_sub_offset = 0;
+        s.vert_sub_offset = 0;
+        if( this->use_sub_pixel_render )
+        {
+            float hoz_sub_offset = BLOCK->hoz_sub_offset;
+            float vert_sub_offset = BLOCK->vert_sub_offset;
+            if( s.parent_slot != MCK::GameEngRenderList::NO_PARENT )
+            {
+                const MCK::GameEngRenderList::BlockSlot &PARENT
+                    = rl.slots[ s.parent_slot ];
+                hoz_sub_offset += float( PARENT.hoz_sub_offset ) / 256.0f;
+                vert_sub_offset += float( PARENT.vert_sub_offset ) / 256.0f;
+            }
+            const float HOZ_FLOOR = std::floor( hoz_sub_offset );
+            const float VERT_FLOOR = std::floor( vert_sub_offset );
+            s.hoz_offset += int16_t( HOZ_FLOOR );
+            s.vert_offset += int16_t( VERT_FLOOR );
+            s.hoz_sub_offset
+                = uint8_t( ( hoz_sub_offset - HOZ_FLOOR ) * 256.0f );
+            s.vert_sub_offset
+                = uint8_t( ( vert_sub_offset - VERT_FLOOR ) * 256.0f );
+        }
+
+        // Check if any of block's own images are on screen
+        s.on_screen = s.visible;
+        if( s.visible && this->use_culling )
+        {
+            BLOCK->update_bounds();
+            s.on_screen = this->is_on_screen(
+                BLOCK->bounds,
+                s.hoz_offset,
+                s.vert_offset
+            );
+        }
+
+        s.changed = !PREV.cached
+                    || PREV.content_revision != BLOCK->content_revision
+                    || PREV.hoz_offset != s.hoz_offset
+                    || PREV.vert_offset != s.vert_offset
+                    || PREV.hoz_sub_offset != s.hoz_sub_offset
+                    || PREV.vert_sub_offset != s.vert_sub_offset
+                    || PREV.visible != s.visible
+                    || PREV.on_screen != s.on_screen;
+        s.content_revision = BLOCK->content_revision;
+        s.cached = true;
+        any_changed = any_changed || s.changed;
+    }
+
+    // If nothing has changed, draw commands are
+    // those of the previous render
+    if( !any_changed && rl.items_valid )
+    {
+        return;
+    }
+
+    // Collect draw commands, regenerating those of
+    // changed blocks
+    rl.items.clear();
+    rl.items_valid = true;
+    this->generate_render_list_items( track_changes );
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::generate_render_list_items( bool track_changes ) const
+{
+    MCK::GameEngRenderList &rl = this->render_list;
+    const uint32_t NUM_ENTRIES = rl.entries.size();
+    for( uint32_t i = 0; i < NUM_ENTRIES; i++ )
+    {
+#if defined MCK_PROFILE
+        this->profile_counts.num_instances_visited++;
+#endif
+
+        MCK::GameEngRenderList::Entry &entry = rl.entries[ i ];
+        const MCK::GameEngRenderList::BlockSlot &SLOT
+            = rl.slots[ entry.slot ];
+
+        // If none of an unchanged block's own images were
+        // drawn, skip them (and, if it is not visible or
+        // has no sub-blocks, skip it entirely).
+        // Note: Sub-blocks of a block that was not visible
+        //       were not visible either, so none of their
+        //       images were drawn.
+        if( !SLOT.changed && !SLOT.on_screen )
+        {
+            if( !SLOT.visible || SLOT.slot_end == entry.slot + 1 )
+            {
+                i = SLOT.entry_end - 1;
+            }
+            continue;
+        }
+
+        if( SLOT.changed )
+        {
+            this->update_render_list_entry(
+                entry,
+                SLOT,
+                track_changes
+            );
+        }
+
+        if( !entry.drawn )
+        {
+            continue;
+        }
+
+        // Tile maps give one draw command per cell within game window
+        if( entry.tile_map != NULL )
+        {
+            this->add_tile_map_items(
+                entry.tile_map,
+                SLOT.hoz_offset,
+                SLOT.vert_offset,
+                SLOT.hoz_sub_offset,
+                SLOT.vert_sub_offset,
+                rl.items
+            );
+            continue;
+        }
+
+        rl.items.push_back( entry.item );
+    }
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::update_render_list_entry(
+    MCK::GameEngRenderList::Entry &entry,
+    const MCK::GameEngRenderList::BlockSlot &slot,
+    bool track_changes
+) const
+{
+    MCK::GameEngRenderList::Item item;
+    bool drawn = slot.on_screen;
+    uint32_t revision = 0;
+
+    if( !drawn )
+    {
+        // Nothing to generate
+    }
+    else if( entry.tile_map != NULL )
+    {
+        // The whole map is treated as changed whenever its
+        // revision changes, so its area (including offsets)
+        // is stored in place of a draw command
+        const MCK::GameEngTileMap* const TILE_MAP = entry.tile_map;
+        item.tex = NULL;
+        item.clip_rect.x = 0;
+        item.clip_rect.y = 0;
+        item.clip_rect.w = 0;
+        item.clip_rect.h = 0;
+        TILE_MAP->get_bounds( item.dest_rect );
+        item.dest_rect.x += slot.hoz_offset;
+        item.dest_rect.y += slot.vert_offset;
+        item.flags = 0;
+        item.clip = false;
+        item.hoz_sub_offset = slot.hoz_sub_offset;
+        item.vert_sub_offset = slot.vert_sub_offset;
+        item.color_mod.r = 0;
+        item.color_mod.g = 0;
+        item.color_mod.b = 0;
+        item.color_mod.a = 0;
+        revision = TILE_MAP->revision;
+    }
+    else
+    {
+        const MCK::GameEngRenderInfo* const INFO = entry.info;
+
+        // Ignore NULL textures
+        if( INFO->tex == NULL )
+        {
+#if defined MCK_RENDER_INTEGRITY_CHK && defined MCK_STD_OUT
+            std::cout << "(3)NULL texture found during render"
+                      << std::endl;
+#endif
+            drawn = false;
+        }
+        // Ignore images made invisible by colo(u)r modulation
+        else if( INFO->color_mod.a == 0 )
+        {
+            drawn = false;
+        }
+        else
+        {
+            item.tex = INFO->tex;
+            const SDL_Rect* const SRC_RECT = INFO->get_src_rect( item.clip_rect );
+            item.clip = SRC_RECT != NULL;
+            if( item.clip && SRC_RECT != &item.clip_rect )
+            {
+                item.clip_rect = *SRC_RECT;
+            }
+            item.dest_rect = INFO->dest_rect.r;
+            item.dest_rect.x += slot.hoz_offset;
+            item.dest_rect.y += slot.vert_offset;
+            item.flags = INFO->flags;
+            item.color_mod = INFO->color_mod;
+            item.hoz_sub_offset = slot.hoz_sub_offset;
+            item.vert_sub_offset = slot.vert_sub_offset;
+
+            // Ignore images outside game window
+            if( this->use_culling )
+            {
+                SDL_Rect bounds;
+                INFO->get_bounds( bounds );
+                drawn = this->is_on_screen(
+                    bounds,
+                    slot.hoz_offset,
+                    slot.vert_offset
+                );
+            }
+        }
+    }
+
+    // Check for change since entry last drawn
+    if( drawn == entry.drawn
+        && ( !drawn
+             || ( revision == entry.revision
+                  && MCK::GameEngRenderList::same_item( entry.item, item )
+                )
+           )
+    )
+    {
+        return;
+    }
+
+    // Old and new areas need redrawing (retained frame only)
+    if( track_changes )
+    {
+        if( entry.drawn )
+        {
+            this->render_list.add_dirty_item( entry.item );
+        }
+        if( drawn )
+        {
+            this->render_list.add_dirty_item( item );
+        }
+    }
+
+    entry.drawn = drawn;
+    if( drawn )
+    {
+        entry.item = item;
+        entry.revision = revision;
+    }
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::render_items(
+    const std::vector<MCK::GameEngRenderList::Item> &items
+) const
+{
+#if defined MCK_PROFILE
+    MCK::GameEngProfiler::Zone zone( "render_list submit" );
+#endif
+
+#if SDL_VERSION_ATLEAST(2,0,18)
+    if( this->use_batched_render )
+    {
+        this->render_items_batched( items );
+        return;
+    }
+#endif
+#if SDL_VERSION_ATLEAST(2,0,10)
+    if( this->use_sub_pixel_render )
+    {
+        for( const auto &item : items )
+        {
+            this->render_item_sub_pixel( item );
+        }
+        this->render_list.num_draw_calls = items.size();
+        return;
+    }
+#endif
+    for( const auto &item : items )
+    {
+        this->render_item( item );
+    }
+    this->render_list.num_draw_calls = items.size();
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::render_retained_frame( void ) const
+{
+    MCK::GameEngRenderList &rl = this->render_list;
+    rl.num_draw_calls = 0;
+
+    const SDL_Rect WINDOW_RECT = {
+        0,
+        0,
+        int( this->window_width_in_pixels ),
+        int( this->window_height_in_pixels )
+    };
+
+    // If too many areas have changed, it is quicker to
+    // treat them as a single area than to test every image
+    // against each of them
+    const size_t MAX_DIRTY_RECTS = 64;
+    std::vector<SDL_Rect> &dirty_rects = rl.dirty_rects;
+    if( dirty_rects.size() > MAX_DIRTY_RECTS )
+    {
+        for( size_t i = 1; i < dirty_rects.size(); i++ )
+        {
+            SDL_UnionRect( &dirty_rects[ 0 ], &dirty_rects[ i ], &dirty_rects[ 0 ] );
+        }
+        dirty_rects.resize( 1 );
+    }
+
+    // Merge overlapping areas (so no pixel is drawn twice),
+    // and discard anything outside the window
+    size_t i = 0;
+    while( i < dirty_rects.size() )
+    {
+        if( !SDL_IntersectRect( &dirty_rects[ i ], &WINDOW_RECT, &dirty_rects[ i ] ) )
+        {
+            dirty_rects[ i ] = dirty_rects.back();
+            dirty_rects.pop_back();
+            continue;
+        }
+
+        bool merged = false;
+        for( size_t j = 0; j < dirty_rects.size(); j++ )
+        {
+            if( j != i
+                && SDL_HasIntersection( &dirty_rects[ i ], &dirty_rects[ j ] )
+            )
+            {
+                SDL_UnionRect( &dirty_rects[ i ], &dirty_rects[ j ], &dirty_rects[ i ] );
+                dirty_rects[ j ] = dirty_rects.back();
+                dirty_rects.pop_back();
+                merged = true;
+                break;
+            }
+        }
+
+        // Merged area may now overlap earlier areas,
+        // so start again
+        i = merged ? 0 : i + 1;
+    }
+
+    // If nothing has changed, the retained frame is up to date
+    rl.last_full_redraw = rl.full_redraw;
+    if( !rl.full_redraw && dirty_rects.size() == 0 )
+    {
+        return;
+    }
+
+    SDL_SetRenderTarget( this->renderer, this->retained_frame_tex );
+
+    if( rl.full_redraw )
+    {
+        SDL_RenderSetClipRect( this->renderer, NULL );
+        SDL_RenderClear( this->renderer );
+        this->render_items( rl.items );
+        dirty_rects.clear();
+        rl.full_redraw = false;
+    }
+    else
+    {
+        // Erase every changed area, then redraw, in a
+        // single pass, each image that overlaps any of
+        // them, clipped to each area it overlaps.
+        // Note: As areas do not overlap, the order in
+        //       which areas are drawn makes no difference.
+        // Note: Clear colo(u)r is current draw colo(u)r
+        SDL_RenderSetClipRect( this->renderer, NULL );
+        SDL_RenderFillRects(
+            this->renderer,
+            dirty_rects.data(),
+            int( dirty_rects.size() )
+        );
+
+        // Images outside the area enclosing all changed
+        // areas need no further checks
+        SDL_Rect all_dirty = dirty_rects[ 0 ];
+        for( size_t i = 1; i < dirty_rects.size(); i++ )
+        {
+            SDL_UnionRect( &all_dirty, &dirty_rects[ i ], &all_dirty );
+        }
+
+        SDL_Rect bounds;
+        size_t clip_index = dirty_rects.size();  // No clip set
+        for( const auto &item : rl.items )
+        {
+            MCK::GameEngRenderList::calc_item_bounds( item, bounds );
+            if( !SDL_HasIntersection( &bounds, &all_dirty ) )
+            {
+                continue;
+            }
+
+            for( size_t i = 0; i < dirty_rects.size(); i++ )
+            {
+                if( !SDL_HasIntersection( &bounds, &dirty_rects[ i ] ) )
+                {
+                    continue;
+                }
+
+                if( clip_index != i )
+                {
+                    SDL_RenderSetClipRect( this->renderer, &dirty_rects[ i ] );
+                    clip_index = i;
+                }
+#if SDL_VERSION_ATLEAST(2,0,10)
+                if( this->use_sub_pixel_render )
+                {
+                    this->render_item_sub_pixel( item );
+                }
+                else
+                {
+                    this->render_item( item );
+                }
+#else
+                this->render_item( item );
+#endif
+                rl.num_draw_calls++;
+            }
+        }
+        SDL_RenderSetClipRect( this->renderer, NULL );
+    }
+
+    SDL_SetRenderTarget( this->renderer, NULL );
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::release_retained_frame( void ) noexcept
+{
+    this->use_retained_frame = false;
+    if( this->retained_frame_tex != NULL )
+    {
+        SDL_DestroyTexture( this->retained_frame_tex );
+        this->retained_frame_tex = NULL;
+    }
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::set_retained_frame( bool val )
+{
+    if( !val )
+    {
+        this->release_retained_frame();
+        return;
+    }
+
+    if( !this->initialized || this->renderer == NULL )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot enable retained frame as SDL not yet init."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    if( !SDL_RenderTargetSupported( this->renderer ) )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot enable retained frame as renderer does not support target textures."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    if( this->retained_frame_tex == NULL )
+    {
+        this->retained_frame_tex = SDL_CreateTexture(
+            this->renderer,
+            SDL_PIXELFORMAT_ARGB8888,
+            SDL_TEXTUREACCESS_TARGET,
+            this->window_width_in_pixels,
+            this->window_height_in_pixels
+        );
+        if( this->retained_frame_tex == NULL )
+        {
+            throw( std::runtime_error(
+#if defined MCK_STD_OUT
+                std::string( "Failed to create retained frame texture, " )
+                + std::string( "SDL error = " )
+                + SDL_GetError()
+#else
+                ""
+#endif
+            ) );
+        }
+        SDL_SetTextureBlendMode( this->retained_frame_tex, SDL_BLENDMODE_NONE );
+    }
+
+    this->use_retained_frame = true;
+    this->use_compiled_render_list = true;
+    this->render_list.full_redraw = true;
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::render_items_batched(
+    const std::vector<MCK::GameEngRenderList::Item> &items
+) const
+{
+    MCK::GameEngRenderList &rl = this->render_list;
+    rl.num_draw_calls = 0;
+
+#if SDL_VERSION_ATLEAST(2,0,18)
+    const size_t NUM_ITEMS = items.size();
+    size_t run_begin = 0;
+    while( run_begin < NUM_ITEMS )
+    {
+        // Find run of consecutive items sharing a texture
+        SDL_Texture* const TEX = items[ run_begin ].tex;
+        size_t run_end = run_begin + 1;
+        while( run_end < NUM_ITEMS && items[ run_end ].tex == TEX )
+        {
+            run_end++;
+        }
+        const size_t RUN_LENGTH = run_end - run_begin;
+
+        // Get texture size, to normalize texture co-ordinates
+        int tex_width = 0;
+        int tex_height = 0;
+        if( RUN_LENGTH > 1 )
+        {
+            SDL_QueryTexture( TEX, NULL, NULL, &tex_width, &tex_height );
+        }
+
+        // Nothing to gain from batching a single item,
+        // and cannot batch if texture size unknown
+        if( tex_width <= 0 || tex_height <= 0 )
+        {
+            for( size_t i = run_begin; i < run_end; i++ )
+            {
+                if( this->use_sub_pixel_render )
+                {
+                    this->render_item_sub_pixel( items[ i ] );
+                }
+                else
+                {
+                    this->render_item( items[ i ] );
+                }
+            }
+            rl.num_draw_calls += RUN_LENGTH;
+            run_begin = run_end;
+            continue;
+        }
+
+        const float U_SCALE = 1.0f / float( tex_width );
+        const float V_SCALE = 1.0f / float( tex_height );
+
+        // Extend index pattern, if necessary
+        while( rl.indices.size() < RUN_LENGTH * 6 )
+        {
+            const int BASE = int( rl.indices.size() / 6 * 4 );
+            rl.indices.push_back( BASE );
+            rl.indices.push_back( BASE + 1 );
+            rl.indices.push_back( BASE + 2 );
+            rl.indices.push_back( BASE );
+            rl.indices.push_back( BASE + 2 );
+            rl.indices.push_back( BASE + 3 );
+        }
+
+        // Generate four vertices per item
+        rl.vertices.clear();
+        for( size_t i = run_begin; i < run_end; i++ )
+        {
+            const MCK::GameEngRenderList::Item &ITEM = items[ i ];
+
+            // Get texture co-ordinates of source rectangle
+            float u0 = 0.0f;
+            float v0 = 0.0f;
+            float u1 = 1.0f;
+            float v1 = 1.0f;
+            if( ITEM.clip )
+            {
+                u0 = float( ITEM.clip_rect.x ) * U_SCALE;
+                v0 = float( ITEM.clip_rect.y ) * V_SCALE;
+                u1 = float( ITEM.clip_rect.x + ITEM.clip_rect.w ) * U_SCALE;
+                v1 = float( ITEM.clip_rect.y + ITEM.clip_rect.h ) * V_SCALE;
+            }
+
+            // Flip is applied to source, before rotation
+            // (as per SDL_RenderCopyEx)
+            if( ITEM.flags & MCK::GameEngRenderInfo::FLIP_X_MASK )
+            {
+                std::swap( u0, u1 );
+            }
+            if( ITEM.flags & MCK::GameEngRenderInfo::FLIP_Y_MASK )
+            {
+                std::swap( v0, v1 );
+            }
+
+            // Corners relative to centre of destination
+            // rectangle, clockwise from top-left
+            const float HALF_W = float( ITEM.dest_rect.w ) * 0.5f;
+            const float HALF_H = float( ITEM.dest_rect.h ) * 0.5f;
+            const float CENTRE_X
+                = float( ITEM.dest_rect.x )
+                    + float( ITEM.hoz_sub_offset ) / 256.0f + HALF_W;
+            const float CENTRE_Y
+                = float( ITEM.dest_rect.y )
+                    + float( ITEM.vert_sub_offset ) / 256.0f + HALF_H;
+            const float CORNER_X[ 4 ] = { -HALF_W, HALF_W, HALF_W, -HALF_W };
+            const float CORNER_Y[ 4 ] = { -HALF_H, -HALF_H, HALF_H, HALF_H };
+            const float CORNER_U[ 4 ] = { u0, u1, u1, u0 };
+            const float CORNER_V[ 4 ] = { v0, v0, v1, v1 };
+
+            // Rotation is in 90 degree steps (clockwise,
+            // as per SDL_RenderCopyEx), so no trig needed
+            const uint8_t ROTATION
+                = ( ITEM.flags & MCK::GameEngRenderInfo::ROTATION_MASK )
+                    >> MCK::GameEngRenderInfo::ROTATION_RSHIFT;
+
+            for( int corner = 0; corner < 4; corner++ )
+            {
+                float x = CORNER_X[ corner ];
+                float y = CORNER_Y[ corner ];
+                for( uint8_t r = 0; r < ROTATION; r++ )
+                {
+                    const float TEMP = x;
+                    x = -y;
+                    y = TEMP;
+                }
+
+                SDL_Vertex vertex;
+                vertex.position.x = CENTRE_X + x;
+                vertex.position.y = CENTRE_Y + y;
+                vertex.color = ITEM.color_mod;
+                vertex.tex_coord.x = CORNER_U[ corner ];
+                vertex.tex_coord.y = CORNER_V[ corner ];
+                rl.vertices.push_back( vertex );
+            }
+        }
+
+#if defined MCK_PROFILE
+        this->profile_draw_call( TEX );
+#endif
+        SDL_RenderGeometry(
+            this->renderer,
+            TEX,
+            rl.vertices.data(),
+            int( rl.vertices.size() ),
+            rl.indices.data(),
+            int( RUN_LENGTH * 6 )
+        );
+        rl.num_draw_calls++;
+
+        run_begin = run_end;
+    }
+#endif
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::compile_render_block(
+    const MCK::GameEngRenderBlock* block,
+    uint32_t parent_slot,
+    uint32_t base_slot,
+    uint32_t base_entry
+) const
+{
+    MCK::GameEngRenderList &rl = this->render_list;
+
+    // Create slot for this block. Note that a reference
+    // to the slot cannot be held during the loop below,
+    // as recursion may re-allocate 'scratch_slots'.
+    const uint32_t SLOT_INDEX = base_slot + rl.scratch_slots.size();
+    {
+        MCK::GameEngRenderList::BlockSlot new_slot;
+        new_slot.block = block;
+        new_slot.parent_slot = parent_slot;
+        new_slot.slot_end = SLOT_INDEX + 1;
+        new_slot.entry_begin = base_entry + rl.scratch_entries.size();
+        new_slot.entry_end = new_slot.entry_begin;
+        new_slot.revision = block->revision;
+        new_slot.content_revision = 0;
+        new_slot.hoz_offset = 0;
+        new_slot.vert_offset = 0;
+        new_slot.hoz_sub_offset = 0;
+        new_slot.vert_sub_offset = 0;
+        new_slot.visible = false;
+        new_slot.on_screen = false;
+        new_slot.cached = false;
+        new_slot.changed = true;
+        rl.scratch_slots.push_back( new_slot );
+    }
+
+    // Iterate over all render instances in block
+    for( const auto &it : block->render_instances )
+    {
+        const MCK::GameEngRenderBase* const ITEM = it.second.get();
+
+        // Ignore NULL items
+        if( ITEM == NULL )
+        {
+#if defined MCK_RENDER_INTEGRITY_CHK && defined MCK_STD_OUT
+            std::cout << "(3)NULL item found during compile"
+                      << std::endl;
+#endif
+            continue;
+        }
+
+#ifdef MCK_RENDER_INTEGRITY_CHK
+        // Check parentage
+        if( ITEM->parent_block != block )
+        {
+#if defined MCK_STD_OUT
+            std::cout << "(3)Cuckoo item found during compile, ignoring."
+                      << std::endl;
+#endif
+            continue;
+        }
+#endif
+
+        if( ITEM->get_type() == MCK::RenderInstanceType::INFO )
+        {
+            MCK::GameEngRenderList::Entry entry;
+            entry.info = static_cast<const MCK::GameEngRenderInfo*>( ITEM );
+            entry.tile_map = NULL;
+            entry.slot = SLOT_INDEX;
+            entry.drawn = false;
+            entry.revision = 0;
+            rl.scratch_entries.push_back( entry );
+        }
+        else if( ITEM->get_type() == MCK::RenderInstanceType::TILE_MAP )
+        {
+            MCK::GameEngRenderList::Entry entry;
+            entry.info = NULL;
+            entry.tile_map = static_cast<const MCK::GameEngTileMap*>( ITEM );
+            entry.slot = SLOT_INDEX;
+            entry.drawn = false;
+            entry.revision = 0;
+            rl.scratch_entries.push_back( entry );
+        }
+        else if( ITEM->get_type() == MCK::RenderInstanceType::BLOCK )
+        {
+            this->compile_render_block(
+                static_cast<const MCK::GameEngRenderBlock*>( ITEM ),
+                SLOT_INDEX,
+                base_slot,
+                base_entry
+            );
+        }
+        else
+        {
+#if defined MCK_STD_OUT
+            std::cout << "(3)Unknown render instance type found during compile"
+                      << std::endl;
+#endif
+        }
+    }
+
+    MCK::GameEngRenderList::BlockSlot &s
+        = rl.scratch_slots[ SLOT_INDEX - base_slot ];
+    s.slot_end = base_slot + rl.scratch_slots.size();
+    s.entry_end = base_entry + rl.scratch_entries.size();
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::recompile_render_list_slot( uint32_t slot ) const
+{
+    MCK::GameEngRenderList &rl = this->render_list;
+
+    // Copy old slot, as it is about to be overwritten
+    const MCK::GameEngRenderList::BlockSlot OLD = rl.slots[ slot ];
+
+    // Compile block into scratch space
+    rl.scratch_slots.clear();
+    rl.scratch_entries.clear();
+    this->compile_render_block(
+        OLD.block,
+        OLD.parent_slot,
+        slot,
+        OLD.entry_begin
+    );
+
+    // Calculate changes in number of slots and entries.
+    // Note: Unsigned addition of a negative delta wraps
+    //       around to the correct value.
+    const int32_t DELTA_SLOTS
+        = int32_t( rl.scratch_slots.size() )
+            - int32_t( OLD.slot_end - slot );
+    const int32_t DELTA_ENTRIES
+        = int32_t( rl.scratch_entries.size() )
+            - int32_t( OLD.entry_end - OLD.entry_begin );
+
+    // Old images need redrawing, as does anything
+    // they overlapped (new images are added to
+    // the dirty area when they are first drawn)
+    if( this->use_retained_frame )
+    {
+        for( uint32_t i = OLD.entry_begin; i < OLD.entry_end; i++ )
+        {
+            if( rl.entries[ i ].drawn )
+            {
+                rl.add_dirty_item( rl.entries[ i ].item );
+            }
+        }
+    }
+
+    // Splice new slots and entries into list
+    rl.slots.erase(
+        rl.slots.begin() + slot,
+        rl.slots.begin() + OLD.slot_end
+    );
+    rl.slots.insert(
+        rl.slots.begin() + slot,
+        rl.scratch_slots.begin(),
+        rl.scratch_slots.end()
+    );
+    rl.entries.erase(
+        rl.entries.begin() + OLD.entry_begin,
+        rl.entries.begin() + OLD.entry_end
+    );
+    rl.entries.insert(
+        rl.entries.begin() + OLD.entry_begin,
+        rl.scratch_entries.begin(),
+        rl.scratch_entries.end()
+    );
+
+    if( DELTA_SLOTS == 0 && DELTA_ENTRIES == 0 )
+    {
+        return;
+    }
+
+    // Adjust indices of slots following the new block
+    const uint32_t NUM_SLOTS = rl.slots.size();
+    for( uint32_t i = slot + rl.scratch_slots.size(); i < NUM_SLOTS; i++ )
+    {
+        MCK::GameEngRenderList::BlockSlot &s = rl.slots[ i ];
+        s.slot_end += DELTA_SLOTS;
+        s.entry_begin += DELTA_ENTRIES;
+        s.entry_end += DELTA_ENTRIES;
+        if( s.parent_slot != MCK::GameEngRenderList::NO_PARENT
+            && s.parent_slot >= OLD.slot_end
+        )
+        {
+            s.parent_slot += DELTA_SLOTS;
+        }
+    }
+
+    // Adjust slot indices of entries following the new block
+    if( DELTA_SLOTS != 0 )
+    {
+        const uint32_t NUM_ENTRIES = rl.entries.size();
+        for( uint32_t i = OLD.entry_begin + rl.scratch_entries.size();
+             i < NUM_ENTRIES;
+             i++
+        )
+        {
+            MCK::GameEngRenderList::Entry &e = rl.entries[ i ];
+            if( e.slot >= OLD.slot_end )
+            {
+                e.slot += DELTA_SLOTS;
+            }
+        }
+    }
+
+    // Adjust ancestors of the new block
+    for( uint32_t i = OLD.parent_slot;
+         i != MCK::GameEngRenderList::NO_PARENT;
+         i = rl.slots[ i ].parent_slot
+    )
+    {
+        rl.slots[ i ].slot_end += DELTA_SLOTS;
+        rl.slots[ i ].entry_end += DELTA_ENTRIES;
+    }
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::create_texture(
+    MCK_IMG_ID_TYPE image_id,
+    MCK_PAL_ID_TYPE local_palette_id,
+    uint8_t bits_per_pixel,
+    uint16_t pitch_in_pixels,
+    const std::vector<uint8_t> &pixel_data,
+    const std::vector<uint8_t> &local_palette,
+    MCK_TEX_ID_TYPE &tex_id,
+    uint16_t &height_in_pixels,
+    bool throw_if_exists,
+    bool streaming
+)
+{
+#if defined MCK_PROFILE
+    MCK::GameEngProfiler::Zone zone( "create_texture" );
+#endif
+
+    // Set answers to default
+    tex_id = 0;
+    height_in_pixels = 0;
+
+    if( !this->initialized )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot create texture as SDL not yet init."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    if( bits_per_pixel == 0 || bits_per_pixel > 8 )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot create texture as bits per pixel invalid."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    if( pixel_data.size() == 0 )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot create texture as no pixel data."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    // Check palette has at least enough colo(u)rs to 
+    // cover bit depth
+    if( local_palette.size() < pow( 2, bits_per_pixel ) )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot create texture as palette has too few colors."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    // Calculate texture id
+    tex_id = MCK::GameEng::calc_tex_id( image_id, local_palette_id );
+
+    // Calculate image height
+    height_in_pixels
+        = uint16_t(
+            std::ceil ( 
+                float( pixel_data.size() * 8 )  // Size of pixel data in *bits* 
+                    / float( bits_per_pixel )
+                        / float( pitch_in_pixels )
+            )
+        );
+
+    // If this texture already exists, throw or do nothing
+    {
+        if( this->textures.contains( tex_id ) )
+        {
+            if( throw_if_exists )
+            {
+                throw( std::runtime_error(
+#if defined MCK_STD_OUT
+                    std::string( "Texture already exists and " )
+                    + std::string( "'throw_if_exists' is selected." )
+#else
+                    ""
+#endif
+                ) );
+            }
+            else
+            {
+                // Do nothing
+                return;
+            }
+        }
+    }
+
+    // Decode image
+    std::vector<uint32_t> &pixels = MCK::GameEng::get_scratch_pixels(
+        size_t( pitch_in_pixels ) * size_t( height_in_pixels )
+    );
+    try
+    {
+        this->basic_decode_image(
+            bits_per_pixel,
+            pitch_in_pixels,
+            height_in_pixels,
+            pixel_data,
+            local_palette,
+            pixels.data()
+        );
+    }
+    catch( const std::exception &e )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Failed to decode image, error = " )
+            + e.what()
+#else
+            ""
+#endif
+        ) );
+    }
+
+    // Create texture (let calling method
+    // catch any exceptions)
+    this->add_texture(
+        tex_id,
+        pitch_in_pixels,
+        height_in_pixels,
+        pixels.data(),
+        streaming
+    );
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::decode_image(
+    uint8_t bits_per_pixel,
+    uint16_t pitch_in_pixels,
+    const std::vector<uint8_t> &pixel_data,
+    const std::vector<uint8_t> &local_palette,
+    std::vector<uint32_t> &pixels,
+    uint16_t &height_in_pixels
+) const
+{
+    height_in_pixels = 0;
+
+    if( !this->initialized )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot decode image as SDL not yet init."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    if( bits_per_pixel == 0 || bits_per_pixel > 8
+        || pitch_in_pixels == 0 || pixel_data.size() == 0
+    )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot decode image as bits per pixel, pitch or data invalid."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    // Calculate image height
+    height_in_pixels
+        = uint16_t(
+            std::ceil ( 
+                float( pixel_data.size() * 8 )  // Size of pixel data in *bits* 
+                    / float( bits_per_pixel )
+                        / float( pitch_in_pixels )
+            )
+        );
+
+    // Decode (let calling method catch any exceptions)
+    pixels.resize( size_t( pitch_in_pixels ) * size_t( height_in_pixels ) );
+    this->basic_decode_image(
+        bits_per_pixel,
+        pitch_in_pixels,
+        height_in_pixels,
+        pixel_data,
+        local_palette,
+        pixels.data()
+    );
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::create_texture_from_pixels(
+    MCK_IMG_ID_TYPE image_id,
+    MCK_PAL_ID_TYPE local_palette_id,
+    uint16_t pitch_in_pixels,
+    uint16_t height_in_pixels,
+    const std::vector<uint32_t> &pixels,
+    MCK_TEX_ID_TYPE &tex_id,
+    bool streaming
+)
+{
+    tex_id = 0;
+
+    if( !this->initialized )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot create texture as SDL not yet init."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    if( pixels.size()
+            < size_t( pitch_in_pixels ) * size_t( height_in_pixels )
+    )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot create texture as too few pixels."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    // If texture already exists, do nothing
+    tex_id = MCK::GameEng::calc_tex_id( image_id, local_palette_id );
+    if( this->textures.contains( tex_id ) )
+    {
+        return;
+    }
+
+    // Let calling method catch any exceptions
+    this->add_texture(
+        tex_id,
+        pitch_in_pixels,
+        height_in_pixels,
+        pixels.data(),
+        streaming
+    );
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::add_texture(
+    MCK_TEX_ID_TYPE tex_id,
+    uint16_t pitch_in_pixels,
+    uint16_t height_in_pixels,
+    const uint32_t* pixels,
+    bool streaming
+)
+{
+    // If atlas enabled and image is small enough,
+    // try adding image to atlas
+    if( !streaming
+        && this->atlas.is_enabled()
+        && pitch_in_pixels <= this->atlas_max_image_size
+        && height_in_pixels <= this->atlas_max_image_size
+        && this->add_to_atlas(
+               tex_id,
+               pitch_in_pixels,
+               height_in_pixels,
+               pixels
+           )
+    )
+    {
+#if defined MCK_STD_OUT && defined MCK_VERBOSE
+        std::cout << "Added texture with id " << tex_id
+                  << " to atlas" << std::endl;
+#endif
+        return;
+    }
+
+    // Otherwise, create separate texture,
+    // evicting unused textures if over budget
+    const size_t NUM_BYTES
+        = size_t( pitch_in_pixels ) * size_t( height_in_pixels )
+            * sizeof( uint32_t );
+    this->evict_textures( NUM_BYTES );
+
+    SDL_Texture* tex = NULL;
+    try
+    {
+        this->basic_upload_texture(
+            pitch_in_pixels,
+            height_in_pixels,
+            pixels,
+            tex,
+            streaming
+        );
+    }
+    catch( const std::exception &e )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Failed to create new SDL texture, error = " )
+            + e.what()
+#else
+            ""
+#endif
+        ) );
+    }
+    if( tex == NULL )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "SDL texture NULL!"
+#else
+            ""
+#endif
+        ) );
+    }
+
+    // Store pointer to texture
+    // This should not fail due to previous
+    // check the texutre did not currently exist
+    {
+        MCK::GameEng::TextureRecord record;
+        record.tex = tex;
+        record.num_bytes = NUM_BYTES;
+        this->add_texture_record( tex_id, record );
+    }
+
+#if defined MCK_STD_OUT && defined MCK_VERBOSE
+    std::cout << "Created texture with id " << tex_id << std::endl;
+#endif
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::create_indexed_texture(
+    MCK_IMG_ID_TYPE image_id,
+    uint8_t bits_per_pixel,
+    uint16_t pitch_in_pixels,
+    const std::vector<uint8_t> &pixel_data,
+    MCK_TEX_ID_TYPE &tex_id,
+    uint16_t &height_in_pixels
+)
+{
+    tex_id = 0;
+    height_in_pixels = 0;
+
+    if( !this->initialized )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot create indexed texture as SDL not yet init."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    if( bits_per_pixel == 0 || bits_per_pixel > 8
+        || pitch_in_pixels == 0 || pixel_data.size() == 0
+    )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot create indexed texture as bits per pixel, pitch or data invalid."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    // Calculate image height
+    height_in_pixels
+        = uint16_t(
+            std::ceil ( 
+                float( pixel_data.size() * 8 )  // Size of pixel data in *bits* 
+                    / float( bits_per_pixel )
+                        / float( pitch_in_pixels )
+            )
+        );
+
+    // If texture already exists, do nothing
+    tex_id = MCK::GameEng::calc_tex_id( image_id, MCK::INDEXED_PAL_ID );
+    if( this->textures.contains( tex_id ) )
+    {
+        return;
+    }
+
+    // Expand palette indices (using a lookup table
+    // that maps each index onto itself)
+    uint32_t lut[ MCK::GameEngPixelDecoder::MAX_LUT_SIZE ];
+    for( size_t i = 0; i < MCK::GameEngPixelDecoder::MAX_LUT_SIZE; i++ )
+    {
+        lut[ i ] = uint32_t( i );
+    }
+    const size_t NUM_PIXELS = pixel_data.size() * 8 / bits_per_pixel;
+    const size_t LAYER_SIZE
+        = size_t( pitch_in_pixels ) * size_t( height_in_pixels );
+    std::vector<uint32_t> indices( NUM_PIXELS );
+    MCK::GameEngPixelDecoder::decode(
+        bits_per_pixel,
+        pixel_data.data(),
+        NUM_PIXELS,
+        lut,
+        indices.data()
+    );
+
+    // Find which palette indices are used
+    // (any pixels beyond the data use index zero)
+    std::vector<bool> index_used( MCK::GameEngPixelDecoder::MAX_LUT_SIZE, false );
+    for( uint32_t index : indices )
+    {
+        index_used[ index ] = true;
+    }
+    if( NUM_PIXELS < LAYER_SIZE )
+    {
+        index_used[ 0 ] = true;
+    }
+    std::vector<uint8_t> layers;
+    for( size_t i = 0; i < index_used.size(); i++ )
+    {
+        if( index_used[ i ] )
+        {
+            layers.push_back( uint8_t( i ) );
+        }
+    }
+
+    // Create one white mask per index used,
+    // one above the other
+    // (white is 0xFFFFFFFF in any 32bit format)
+    std::vector<uint32_t> &pixels
+        = MCK::GameEng::get_scratch_pixels( LAYER_SIZE * layers.size() );
+    std::fill( pixels.begin(), pixels.end(), 0 );
+    for( size_t layer = 0; layer < layers.size(); layer++ )
+    {
+        uint32_t* const LAYER_PIXELS = pixels.data() + layer * LAYER_SIZE;
+        const uint32_t INDEX = layers[ layer ];
+        for( size_t i = 0; i < NUM_PIXELS; i++ )
+        {
+            if( indices[ i ] == INDEX )
+            {
+                LAYER_PIXELS[ i ] = 0xFFFFFFFF;
+            }
+        }
+        if( INDEX == 0 )
+        {
+            for( size_t i = NUM_PIXELS; i < LAYER_SIZE; i++ )
+            {
+                LAYER_PIXELS[ i ] = 0xFFFFFFFF;
+            }
+        }
+    }
+
+    try
+    {
+        this->add_texture(
+            tex_id,
+            pitch_in_pixels,
+            uint16_t( height_in_pixels * layers.size() ),
+            pixels.data(),
+            false  // Static
+        );
+    }
+    catch( std::exception &e )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Failed to create indexed texture with " )
+            + std::to_string( layers.size() )
+            + std::string( " layers, error = " )
+            + e.what()
+#else
+            ""
+#endif
+        ) );
+    }
+
+    this->indexed_tex_layers[ tex_id ] = layers;
+}
+
+///////////////////////////////////////////////
+
+std::shared_ptr<MCK::GameEngRenderBlock> MCK::GameEng::create_indexed_render_block(
+    MCK_TEX_ID_TYPE tex_id,
+    const std::vector<uint8_t> &local_palette,
+    std::shared_ptr<MCK::GameEngRenderBlock> parent_block,
+    MCK::GameEngRenderInfo::Rect dest_rect,
+    uint32_t z
+) const
+{
+    if( !this->initialized )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot create indexed render block as SDL not yet init."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    std::map<MCK_TEX_ID_TYPE,std::vector<uint8_t>>::const_iterator it
+        = this->indexed_tex_layers.find( tex_id );
+    const MCK::GameEng::TextureRecord* const RECORD
+        = this->textures.find( tex_id );
+    if( it == this->indexed_tex_layers.end() || RECORD == NULL )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Cannot create indexed render block as " )
+            + std::string( "indexed texture with id " )
+            + std::to_string( tex_id )
+            + std::string( " does not exist." )
+#else
+            ""
+#endif
+        ) );
+    }
+    const size_t NUM_LAYERS = it->second.size();
+
+    // Get size of image (within atlas, if held there),
+    // and hence height of a single layer
+    int width = 0;
+    int layer_height = 0;
+    {
+        if( RECORD->in_atlas )
+        {
+            width = RECORD->atlas_region.rect.w;
+            layer_height = RECORD->atlas_region.rect.h;
+        }
+        else
+        {
+            SDL_QueryTexture(
+                RECORD->tex,
+                NULL,
+                NULL,
+                &width,
+                &layer_height
+            );
+        }
+        layer_height /= int( NUM_LAYERS );
+    }
+
+    // Let calling method catch any exceptions hereafter
+    std::shared_ptr<MCK::GameEngRenderBlock> block
+        = this->create_empty_render_block( parent_block, z );
+    block->hoz_offset = int16_t( dest_rect.get_x() );
+    block->vert_offset = int16_t( dest_rect.get_y() );
+
+    // Each layer is clipped from the texture
+    for( size_t layer = 0; layer < NUM_LAYERS; layer++ )
+    {
+        this->create_render_info(
+            tex_id,
+            block,
+            MCK::GameEngRenderInfo::Rect(
+                0,
+                0,
+                dest_rect.get_w(),
+                dest_rect.get_h()
+            ),
+            true,  // Clip
+            MCK::GameEngRenderInfo::Rect(
+                0,
+                int( layer ) * layer_height,
+                width,
+                layer_height
+            )
+        );
+    }
+
+    this->set_indexed_layer_colors( block.get(), local_palette );
+
+    return block;
+}
+
+///////////////////////////////////////////////
 
-    if( !this->initialized )
+void MCK::GameEng::change_indexed_render_block_palette(
+    std::shared_ptr<MCK::GameEngRenderBlock> block,
+    const std::vector<uint8_t> &local_palette
+) const
+{
+    if( block.get() == NULL )
     {
         throw( std::runtime_error(
 #if defined MCK_STD_OUT
-            "Cannot create texture as SDL not yet init."
+            "Cannot change palette of indexed render block as block is NULL."
 #else
             ""
 #endif
         ) );
     }
 
-    if( bits_per_pixel == 0 || bits_per_pixel > 8 )
+    // Let calling method catch any exceptions
+    this->set_indexed_layer_colors( block.get(), local_palette );
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::set_indexed_layer_colors(
+    MCK::GameEngRenderBlock* block,
+    const std::vector<uint8_t> &local_palette
+) const
+{
+    for( const auto &it : block->render_instances )
+    {
+        MCK::GameEngRenderBase* const ITEM = it.second.get();
+        if( ITEM == NULL
+            || ITEM->get_type() != MCK::RenderInstanceType::INFO
+        )
+        {
+            continue;
+        }
+        MCK::GameEngRenderInfo* const INFO
+            = static_cast<MCK::GameEngRenderInfo*>( ITEM );
+
+        std::map<MCK_TEX_ID_TYPE,std::vector<uint8_t>>::const_iterator layers_it
+            = this->indexed_tex_layers.find( INFO->tex_id );
+        if( layers_it == this->indexed_tex_layers.end() )
+        {
+            throw( std::runtime_error(
+#if defined MCK_STD_OUT
+                std::string( "Cannot set palette of indexed render " )
+                + std::string( "block as texture with id " )
+                + std::to_string( INFO->tex_id )
+                + std::string( " is not indexed." )
+#else
+                ""
+#endif
+            ) );
+        }
+
+        // Layer is given by position of clipping rectangle
+        const std::vector<uint8_t> &LAYERS = layers_it->second;
+        const int LAYER_HEIGHT = INFO->clip_rect.get_h();
+        const size_t LAYER
+            = LAYER_HEIGHT > 0 ? size_t( INFO->clip_rect.get_y() / LAYER_HEIGHT ) : 0;
+        if( LAYER >= LAYERS.size() || LAYERS[ LAYER ] >= local_palette.size() )
+        {
+            throw( std::runtime_error(
+#if defined MCK_STD_OUT
+                std::string( "Cannot set palette of indexed render " )
+                + std::string( "block as local palette has too few " )
+                + std::string( "colo(u)rs (" )
+                + std::to_string( local_palette.size() )
+                + std::string( ")." )
+#else
+                ""
+#endif
+            ) );
+        }
+
+        MCK::GameEng::get_RGBA(
+            local_palette[ LAYERS[ LAYER ] ],
+            INFO->color_mod.r,
+            INFO->color_mod.g,
+            INFO->color_mod.b,
+            INFO->color_mod.a
+        );
+    }
+
+    // Colo(u)r modulation set directly, so
+    // notify compiled render list
+    block->content_changed();
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::update_texture(
+    MCK_TEX_ID_TYPE tex_id,
+    uint8_t bits_per_pixel,
+    uint16_t pitch_in_pixels,
+    const std::vector<uint8_t> &pixel_data,
+    const std::vector<uint8_t> &local_palette
+)
+{
+    if( !this->initialized )
     {
         throw( std::runtime_error(
 #if defined MCK_STD_OUT
-            "Cannot create texture as bits per pixel invalid."
+            "Cannot update texture as SDL not yet init."
 #else
             ""
 #endif
         ) );
     }
 
-    if( pixel_data.size() == 0 )
+    if( bits_per_pixel == 0 || bits_per_pixel > 8 || pixel_data.size() == 0 )
     {
         throw( std::runtime_error(
 #if defined MCK_STD_OUT
-            "Cannot create texture as no pixel data."
+            "Cannot update texture as bits per pixel or pixel data invalid."
 #else
             ""
 #endif
         ) );
     }
 
-    // Check palette has at least enough colo(u)rs to 
-    // cover bit depth
-    if( local_palette.size() < pow( 2, bits_per_pixel ) )
+    const MCK::GameEng::TextureRecord* const RECORD
+        = this->textures.find( tex_id );
+    if( RECORD == NULL || RECORD->tex == NULL )
     {
         throw( std::runtime_error(
 #if defined MCK_STD_OUT
-            "Cannot create texture as palette has too few colors."
+            std::string( "Cannot update texture as texture id " )
+            + std::to_string( tex_id )
+            + std::string( " does not exist." )
 #else
             ""
 #endif
         ) );
     }
 
-    // Calculate texture id
-    tex_id = MCK::GameEng::calc_tex_id( image_id, local_palette_id );
-
-    // Calculate image height
-    height_in_pixels
+    // Check texture is streaming, and same size as image
+    const uint16_t HEIGHT_IN_PIXELS
         = uint16_t(
             std::ceil ( 
                 float( pixel_data.size() * 8 )  // Size of pixel data in *bits* 
@@ -1005,86 +3314,292 @@ void MCK::GameEng::create_texture(
                         / float( pitch_in_pixels )
             )
         );
-
-    // If this texture already exists, throw or do nothing
+    int access, w, h;
+    if( SDL_QueryTexture( RECORD->tex, NULL, &access, &w, &h ) != 0
+        || access != SDL_TEXTUREACCESS_STREAMING
+        || w != pitch_in_pixels
+        || h != HEIGHT_IN_PIXELS
+    )
     {
-        std::map<MCK_TEX_ID_TYPE,SDL_Texture*>::iterator it 
-            = this->textures.find( tex_id );
-        if( it != this->textures.end() )
-        {
-            if( throw_if_exists )
-            {
-                throw( std::runtime_error(
+        throw( std::runtime_error(
 #if defined MCK_STD_OUT
-                    std::string( "Texture already exists and " )
-                    + std::string( "'throw_if_exists' is selected." )
+            std::string( "Cannot update texture id " )
+            + std::to_string( tex_id )
+            + std::string( " as it is not streaming, or size differs." )
 #else
-                    ""
+            ""
 #endif
-                ) );
-            }
-            else
-            {
-                // Do nothing
-                return;
-            }
-        }
+        ) );
     }
 
-    // Declare texture pointer
-    SDL_Texture* tex = NULL;
-
-    // Create texture
     try
     {
-        this->basic_create_texture(
+        this->basic_update_texture(
             bits_per_pixel,
             pitch_in_pixels,
-            height_in_pixels,
+            HEIGHT_IN_PIXELS,
             pixel_data,
             local_palette,
-            tex
+            RECORD->tex
         );
     }
     catch( const std::exception &e )
     {
         throw( std::runtime_error(
 #if defined MCK_STD_OUT
-            std::string( "Failed to create new SDL texture, error = " )
+            std::string( "Failed to update SDL texture, error = " )
             + e.what()
 #else
             ""
 #endif
         ) );
     }
-    if( tex == NULL )
+
+    // Texture may be drawn in retained frame
+    this->invalidate_retained_frame();
+}
+
+///////////////////////////////////////////////
+
+bool MCK::GameEng::add_to_atlas(
+    MCK_TEX_ID_TYPE tex_id,
+    uint16_t width_in_pixels,
+    uint16_t height_in_pixels,
+    const uint32_t* pixels
+)
+{
+    MCK::GameEngTextureAtlas::Region region;
+    if( !this->atlas.allocate( width_in_pixels, height_in_pixels, region ) )
     {
-        throw( std::runtime_error(
-#if defined MCK_STD_OUT
-            "SDL texture NULL!"
-#else
-            ""
+        // If atlas full, add another page or
+        // evict unused pages
+        if( this->atlas.can_add_page() )
+        {
+            SDL_Texture* const PAGE_TEX = SDL_CreateTexture(
+                this->renderer,
+                this->texture_format,  // Matches decoded pixels
+                SDL_TEXTUREACCESS_STATIC,
+                this->atlas.get_page_size(),
+                this->atlas.get_page_size()
+            );
+            if( PAGE_TEX == NULL )
+            {
+#if defined MCK_STD_OUT && defined MCK_VERBOSE
+                std::cout << "Failed to create atlas page, SDL error = "
+                          << SDL_GetError() << std::endl;
 #endif
-        ) );
+                return false;
+            }
+            SDL_SetTextureBlendMode( PAGE_TEX, SDL_BLENDMODE_BLEND );
+            this->atlas.add_page( PAGE_TEX );
+        }
+        else
+        {
+            this->evict_atlas_pages();
+        }
+
+        if( !this->atlas.allocate( width_in_pixels, height_in_pixels, region ) )
+        {
+            return false;
+        }
     }
 
-    // Store pointer to texture
-    // This should not fail due to previous
-    // check the texutre did not currently exist
+    SDL_Texture* const PAGE_TEX = this->atlas.get_page_tex( region.page );
+    if( SDL_UpdateTexture(
+            PAGE_TEX,
+            &region.rect,
+            pixels,
+            width_in_pixels * sizeof( uint32_t )
+        ) != 0
+    )
     {
-        this->textures.insert(
-            std::pair<MCK_TEX_ID_TYPE,SDL_Texture*>(
-                tex_id,
-                tex
-            )
+#if defined MCK_STD_OUT && defined MCK_VERBOSE
+        std::cout << "Failed to update atlas page, SDL error = "
+                  << SDL_GetError() << std::endl;
+#endif
+        return false;
+    }
+
+    MCK::GameEng::TextureRecord record;
+    record.tex = PAGE_TEX;
+    record.in_atlas = true;
+    record.atlas_region = region;
+    this->add_texture_record( tex_id, record );
+
+    return true;
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::evict_atlas_pages( void )
+{
+    // Find which pages hold textures in use
+    std::vector<bool> page_in_use( this->atlas.get_num_pages(), false );
+    std::vector<MCK_TEX_ID_TYPE> atlas_tex_ids;
+    for( size_t i = 0; i < this->textures.get_num_slots(); i++ )
+    {
+        const MCK::GameEng::TextureRecord &RECORD
+            = this->textures.get_value( i );
+        if( this->textures.get_key( i ) == MCK::INVALID_TEX_ID
+            || !RECORD.in_atlas
+        )
+        {
+            continue;
+        }
+
+        atlas_tex_ids.push_back( this->textures.get_key( i ) );
+        if( RECORD.ref_count > 0 )
+        {
+            page_in_use[ RECORD.atlas_region.page ] = true;
+        }
+    }
+
+    // Forget textures on unused pages, so 'texture_exists'
+    // reports them as not existing (allowing them to be
+    // re-created if needed later)
+    for( const MCK_TEX_ID_TYPE TEX_ID : atlas_tex_ids )
+    {
+        if( !page_in_use[ this->textures.find( TEX_ID )->atlas_region.page ] )
+        {
+            this->textures.erase( TEX_ID );
+            this->indexed_tex_layers.erase( TEX_ID );
+        }
+    }
+
+    for( uint16_t i = 0; i < page_in_use.size(); i++ )
+    {
+        if( !page_in_use[ i ] )
+        {
+            this->atlas.reset_page( i );
+
+#if defined MCK_STD_OUT && defined MCK_VERBOSE
+            std::cout << "Evicted atlas page " << i << std::endl;
+#endif
+        }
+    }
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::set_texture_budget(
+    size_t max_bytes,
+    size_t max_textures
+)
+{
+    this->max_texture_bytes = max_bytes;
+    this->max_textures = max_textures;
+
+    // Evict any excess now
+    this->evict_textures( 0 );
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::add_texture_record(
+    MCK_TEX_ID_TYPE tex_id,
+    MCK::GameEng::TextureRecord record
+)
+{
+    record.ref_count = 0;
+
+    // Textures outside atlas are unused until
+    // a render info acquires them
+    if( !record.in_atlas )
+    {
+        record.unused_pos = this->unused_textures.insert(
+            this->unused_textures.end(),
+            tex_id
         );
+        this->texture_bytes += record.num_bytes;
+        this->num_separate_textures++;
     }
 
+    this->textures.insert( tex_id, record );
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::evict_textures( size_t num_bytes )
+{
+    // If 'num_bytes' is zero, only evict excess
+    const size_t NUM_NEW = num_bytes > 0 ? 1 : 0;
+    const size_t PREV_NUM_EVICTED = this->num_evicted_textures;
+
+    while( this->unused_textures.size() > 0
+           && (
+               ( this->max_texture_bytes > 0
+                 && this->texture_bytes + num_bytes > this->max_texture_bytes
+               )
+               || ( this->max_textures > 0
+                    && this->num_separate_textures + NUM_NEW > this->max_textures
+               )
+           )
+    )
+    {
+        // Evict least recently used
+        const MCK_TEX_ID_TYPE TEX_ID = this->unused_textures.front();
+        this->unused_textures.pop_front();
+
+        const MCK::GameEng::TextureRecord* const RECORD
+            = this->textures.find( TEX_ID );
+        if( RECORD != NULL )
+        {
+            if( RECORD->tex != NULL )
+            {
+                SDL_DestroyTexture( RECORD->tex );
+            }
+            this->texture_bytes -= RECORD->num_bytes;
+            this->textures.erase( TEX_ID );
+        }
+        this->indexed_tex_layers.erase( TEX_ID );
+        this->num_separate_textures--;
+        this->num_evicted_textures++;
+
 #if defined MCK_STD_OUT && defined MCK_VERBOSE
-    std::cout << "Created texture with id " << tex_id << std::endl;
+        std::cout << "Evicted texture with id " << TEX_ID << std::endl;
 #endif
+    }
+
+    // Retained frame compares textures by address,
+    // which a new texture may re-use
+    if( this->num_evicted_textures > PREV_NUM_EVICTED )
+    {
+        this->invalidate_retained_frame();
+    }
 }
-        
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::acquire_tex( MCK::GameEng::TextureRecord &record ) const
+{
+    if( record.ref_count++ == 0 && !record.in_atlas )
+    {
+        this->unused_textures.erase( record.unused_pos );
+    }
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::release_tex( MCK_TEX_ID_TYPE tex_id ) const noexcept
+{
+    MCK::GameEng::TextureRecord* const RECORD = this->textures.find( tex_id );
+    if( RECORD == NULL || RECORD->ref_count == 0 )
+    {
+        return;
+    }
+
+    // Most recently used textures go to back of list
+    if( --RECORD->ref_count == 0 && !RECORD->in_atlas )
+    {
+        RECORD->unused_pos = this->unused_textures.insert(
+            this->unused_textures.end(),
+            tex_id
+        );
+    }
+}
+
+///////////////////////////////////////////////
+
 std::shared_ptr<MCK::GameEngRenderBlock> MCK::GameEng::create_empty_render_block(
     std::shared_ptr<MCK::GameEngRenderBlock> parent_block,
     uint32_t z
@@ -1105,7 +3620,10 @@ std::shared_ptr<MCK::GameEngRenderBlock> MCK::GameEng::create_empty_render_block
 
     // Create new block
     std::shared_ptr<MCK::GameEngRenderBlock> new_block
-        = std::make_shared<MCK::GameEngRenderBlock>( z );
+        = std::allocate_shared<MCK::GameEngRenderBlock>(
+              MCK::GameEngPoolAllocator<MCK::GameEngRenderBlock>(),
+              z
+          );
 
     // Add to parent block, if exists
     if( parent_block.get() != NULL )
@@ -1114,6 +3632,7 @@ std::shared_ptr<MCK::GameEngRenderBlock> MCK::GameEng::create_empty_render_block
         
         try
         {
+            parent_block->mark_changed();
             parent_block->render_instances.insert(
                 std::pair<
                     uint64_t, std::shared_ptr<MCK::GameEngRenderBase>
@@ -1144,8 +3663,23 @@ std::shared_ptr<MCK::GameEngRenderBlock> MCK::GameEng::create_empty_render_block
 
 void MCK::GameEng::show( void ) const
 {
+#if defined MCK_PROFILE
+    MCK::GameEngProfiler::Zone zone( "show" );
+#endif
+
     try
     {
+        // Composite retained frame onto window
+        if( this->use_retained_frame )
+        {
+            SDL_RenderCopy(
+                this->renderer,
+                this->retained_frame_tex,
+                NULL,
+                NULL
+            );
+        }
+
         SDL_RenderPresent( this->renderer );
     }
     catch( std::exception &e )
@@ -1160,6 +3694,17 @@ void MCK::GameEng::show( void ) const
 #endif
         ) );
     }
+
+#if defined MCK_PROFILE
+    // End frame, handing over counts gathered
+    // by this (rendering) thread
+    zone.end();
+    MCK::GameEngProfiler &profiler = MCK::GameEngProfiler::get_singleton();
+    profiler.add_counts( this->profile_counts );
+    profiler.end_frame();
+    this->profile_counts = MCK::GameEngProfiler::Counts();
+    this->profile_prev_tex = NULL;
+#endif
 }
         
 std::shared_ptr<MCK::GameEngRenderInfo> MCK::GameEng::create_render_info(
@@ -1186,29 +3731,23 @@ std::shared_ptr<MCK::GameEngRenderInfo> MCK::GameEng::create_render_info(
     }
 
     // Get texture
-    SDL_Texture* tex = NULL;
+    MCK::GameEng::TextureRecord* const RECORD = this->textures.find( tex_id );
+
+    // If texture does not exist, throw exception
+    if( RECORD == NULL )
     {
-        std::map<MCK_TEX_ID_TYPE,SDL_Texture*>::const_iterator it 
-            = this->textures.find( tex_id );
-        
-        // If texture does not exist, throw exception
-        if( it == this->textures.end() )
-        {
-            throw( std::runtime_error(
+        throw( std::runtime_error(
 #if defined MCK_STD_OUT
-                std::string( "Cannot create render info as texture with id " )
-                + std::to_string( tex_id )
-                + std::string( " does not exist." )
+            std::string( "Cannot create render info as texture with id " )
+            + std::to_string( tex_id )
+            + std::string( " does not exist." )
 #else
-                ""
+            ""
 #endif
-            ) );
-        }
-
-        tex = it->second;
+        ) );
     }
 
-    if( tex == NULL )
+    if( RECORD->tex == NULL )
     {
         throw( std::runtime_error(
 #if defined MCK_STD_OUT
@@ -1223,9 +3762,11 @@ std::shared_ptr<MCK::GameEngRenderInfo> MCK::GameEng::create_render_info(
 
     // Create new info instance
     std::shared_ptr<MCK::GameEngRenderInfo> new_info
-        = std::make_shared<MCK::GameEngRenderInfo>( z );
-    new_info->tex = tex;
-    new_info->tex_id = tex_id;
+        = std::allocate_shared<MCK::GameEngRenderInfo>(
+              MCK::GameEngPoolAllocator<MCK::GameEngRenderInfo>(),
+              z
+          );
+    this->set_render_info_tex( *new_info, tex_id, *RECORD );
     new_info->dest_rect = dest_rect;
     new_info->clip = clip;
     new_info->clip_rect = clip_rect;
@@ -1243,6 +3784,7 @@ std::shared_ptr<MCK::GameEngRenderInfo> MCK::GameEng::create_render_info(
 
         try
         {
+            parent_block->mark_changed();
             parent_block->render_instances.insert(
                 std::pair<
                     uint64_t,
@@ -1274,6 +3816,10 @@ std::shared_ptr<MCK::GameEngRenderInfo> MCK::GameEng::create_render_info(
 
 void MCK::GameEng::clear( void ) const
 {
+#if defined MCK_PROFILE
+    MCK::GameEngProfiler::Zone zone( "clear" );
+#endif
+
     if( !this->initialized || this->renderer == NULL )
     {
         throw( std::runtime_error(
@@ -1285,6 +3831,13 @@ void MCK::GameEng::clear( void ) const
         ) );
     }
 
+    // Nothing to clear if retained frame in use,
+    // as it is entirely overwritten by 'show'
+    if( this->use_retained_frame )
+    {
+        return;
+    }
+
     // Clear window
     int rc = SDL_RenderClear( this->renderer );
     // -ve return code indicates failure
@@ -1346,6 +3899,16 @@ void MCK::GameEng::get_pending_keyboard_actions(
             continue;
         }
 
+        // If render targets have been lost, retained
+        // frame must be redrawn in full
+        if( e.type == SDL_RENDER_TARGETS_RESET
+            || e.type == SDL_RENDER_DEVICE_RESET
+        )
+        {
+            this->render_list.full_redraw = true;
+            continue;
+        }
+
         // Otherwise, check for a key up or key down event
         const bool UP = e.type == SDL_KEYUP;
         const bool DOWN = e.type == SDL_KEYDOWN;
@@ -1460,45 +4023,233 @@ void MCK::GameEng::change_render_info_tex(
     }
 
     // Get texture
-    SDL_Texture* tex = NULL;
+    MCK::GameEng::TextureRecord* const RECORD = this->textures.find( new_tex_id );
+
+    // If texture does not exist, throw exception
+    if( RECORD == NULL )
     {
-        std::map<MCK_TEX_ID_TYPE,SDL_Texture*>::const_iterator it 
-            = this->textures.find( new_tex_id );
-        
-        // If texture does not exist, throw exception
-        if( it == this->textures.end() )
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Cannot change render info texture as texture with id " )
+            + std::to_string( new_tex_id )
+            + std::string( " does not exist." )
+#else
+            ""
+#endif
+        ) );
+    }
+
+    if( RECORD->tex == NULL )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Cannot change render info texutre as texture with id " )
+            + std::to_string( new_tex_id )
+            + std::string( " is NULL." )
+#else
+            ""
+#endif
+        ) );
+    }
+
+    // Update render info
+    this->set_render_info_tex( *info, new_tex_id, *RECORD );
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::acquire_tex_handle(
+    MCK_TEX_ID_TYPE tex_id,
+    MCK::GameEngRenderInfo::TexHandle &handle
+) const
+{
+    if( !this->initialized )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot acquire texture handle as SDL not yet init."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    MCK::GameEng::TextureRecord* const RECORD = this->textures.find( tex_id );
+    if( RECORD == NULL || RECORD->tex == NULL )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Cannot acquire texture handle as texture with id " )
+            + std::to_string( tex_id )
+            + std::string( " does not exist." )
+#else
+            ""
+#endif
+        ) );
+    }
+
+    // Acquire new reference before releasing old,
+    // in case texture is unchanged
+    this->acquire_tex( *RECORD );
+    if( handle.tex_id != MCK::INVALID_TEX_ID )
+    {
+        this->release_tex( handle.tex_id );
+    }
+
+    handle.tex_id = tex_id;
+    handle.tex = RECORD->tex;
+    handle.in_atlas = RECORD->in_atlas;
+    if( RECORD->in_atlas )
+    {
+        handle.atlas_rect = RECORD->atlas_region.rect;
+    }
+}
+
+///////////////////////////////////////////////
+
+std::shared_ptr<MCK::GameEngTileMap> MCK::GameEng::create_tile_map(
+    std::shared_ptr<MCK::GameEngRenderBlock> parent_block,
+    int x,
+    int y,
+    uint16_t width_in_cells,
+    uint16_t height_in_cells,
+    uint16_t cell_width,
+    uint16_t cell_height,
+    uint32_t z
+) const
+{
+    if( !this->initialized )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot create tile map as SDL not yet init."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    // Create new tile map instance
+    std::shared_ptr<MCK::GameEngTileMap> new_tile_map
+        = std::make_shared<MCK::GameEngTileMap>(
+              width_in_cells,
+              height_in_cells,
+              cell_width,
+              cell_height,
+              z
+          );
+    new_tile_map->x = x;
+    new_tile_map->y = y;
+
+    // Associate tile map with render block, if render
+    // block supplied (note, always added to end of render block)
+    if( parent_block.get() != NULL )
+    {
+        new_tile_map->parent_block = parent_block.get();
+
+        try
+        {
+            parent_block->mark_changed();
+            parent_block->render_instances.insert(
+                std::pair<
+                    uint64_t,
+                    std::shared_ptr<MCK::GameEngRenderBase>
+                >(
+                    new_tile_map->render_order,
+                    std::dynamic_pointer_cast<MCK::GameEngRenderBase>(
+                        new_tile_map
+                    )
+                )
+            );
+        }
+        catch( const std::exception &e )
         {
             throw( std::runtime_error(
 #if defined MCK_STD_OUT
-                std::string( "Cannot change render info texture as texture with id " )
-                + std::to_string( new_tex_id )
-                + std::string( " does not exist." )
+                std::string( "Failed to insert new tile map " )
+                + std::string( "into parent block, error = " )
+                + e.what()
 #else
                 ""
 #endif
             ) );
         }
+    }
+
+    return new_tile_map;
+}
 
-        tex = it->second;
+///////////////////////////////////////////////
+
+void MCK::GameEng::set_tile_map_tile(
+    std::shared_ptr<MCK::GameEngTileMap> tile_map,
+    uint16_t tile,
+    MCK_TEX_ID_TYPE tex_id
+) const
+{
+    if( tile_map.get() == NULL )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot set tile map tile as tile map is NULL."
+#else
+            ""
+#endif
+        ) );
     }
 
-    if( tex == NULL )
+    if( tile == MCK::GameEngTileMap::EMPTY_CELL )
     {
         throw( std::runtime_error(
 #if defined MCK_STD_OUT
-            std::string( "Cannot change render info texutre as texture with id " )
-            + std::to_string( new_tex_id )
-            + std::string( " is NULL." )
+            std::string( "Cannot set tile map tile as tile number " )
+            + std::to_string( tile )
+            + std::string( " is reserved for empty cells." )
 #else
             ""
 #endif
         ) );
     }
 
-    // Update render info
-    info->tex = tex;
+    if( tile >= tile_map->tiles.size() )
+    {
+        tile_map->tiles.resize( size_t( tile ) + 1 );
+    }
+
+    // Note: This throws if texture does not exist
+    this->acquire_tex_handle( tex_id, tile_map->tiles[ tile ] );
+    tile_map->cells_changed();
 }
-        
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::hold_render_info_tex( MCK::GameEngRenderInfo &info ) const
+{
+    if( info.tex_ref )
+    {
+        return;
+    }
+
+    MCK::GameEng::TextureRecord* const RECORD = this->textures.find( info.tex_id );
+    if( RECORD == NULL || RECORD->tex != info.tex )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Cannot hold render info texture as texture with id " )
+            + std::to_string( info.tex_id )
+            + std::string( " does not exist." )
+#else
+            ""
+#endif
+        ) );
+    }
+
+    this->acquire_tex( *RECORD );
+    info.tex_ref = true;
+}
+
+///////////////////////////////////////////////
+
 void MCK::GameEng::remove_render_instance(
     std::shared_ptr<MCK::GameEngRenderBase> instance_to_remove,
     std::shared_ptr<MCK::GameEngRenderBlock> block_to_start_search
@@ -1513,7 +4264,9 @@ void MCK::GameEng::remove_render_instance(
     }
     
     // Loop over instances, looking for the one to remove
-    std::multimap<uint64_t,std::shared_ptr<MCK::GameEngRenderBase>>::iterator it;
+    // Note: Removal leaves a NULL 'tombstone' in place,
+    //       so iterators remain valid
+    MCK::GameEngRenderInstanceVec::iterator it;
     for( it = block_to_start_search->render_instances.begin();
          it != block_to_start_search->render_instances.end();
          it++
@@ -1531,15 +4284,12 @@ void MCK::GameEng::remove_render_instance(
         )
         {
             // Remove this instance
-            it = block_to_start_search->render_instances.erase( it );
-         
-            // If render instances is now empty, end here
-            // THIS IS IMPORTANT AS OTHERWISE THIS FOR LOOP WILL
-            // HANG WHEN IT NEXT TRIES TO EXECUTE 'it++'
-            if( block_to_start_search->render_instances.size() == 0 )
+            if( item.get() != NULL )
             {
-                return;
+                item->parent_block = NULL;
             }
+            block_to_start_search->mark_changed();
+            block_to_start_search->render_instances.erase( it );
         }
         // Otherwise, if item is a non-matching block,
         // continue search recursively
@@ -1577,8 +4327,10 @@ void MCK::GameEng::move_render_instance(
     }
     
     // Loop over instances, looking for the one to remove
+    // Note: Removal leaves a NULL 'tombstone' in place,
+    //       so iterators remain valid
     bool found = false;
-    std::multimap<uint64_t,std::shared_ptr<MCK::GameEngRenderBase>>::iterator it;
+    MCK::GameEngRenderInstanceVec::iterator it;
     for( it = old_block->render_instances.begin();
          it != old_block->render_instances.end();
          it++
@@ -1593,17 +4345,10 @@ void MCK::GameEng::move_render_instance(
         if( item.get() == instance_to_move.get() )
         {
             // Remove this instance
-            it = old_block->render_instances.erase( it );
+            old_block->mark_changed();
+            old_block->render_instances.erase( it );
          
             found = true;
-
-            // If render instances is now empty, end here
-            // THIS IS IMPORTANT AS OTHERWISE THIS FOR LOOP WILL
-            // HANG WHEN IT NEXT TRIES TO EXECUTE 'it++'
-            if( old_block->render_instances.size() == 0 )
-            {
-                break;
-            }
         }
     }
 
@@ -1627,6 +4372,7 @@ void MCK::GameEng::move_render_instance(
 
     // Add to new block
     // (done using private access)
+    new_block->mark_changed();
     new_block->render_instances.insert(
         std::pair<
             uint64_t,
@@ -1641,14 +4387,14 @@ void MCK::GameEng::move_render_instance(
     instance_to_move->parent_block = &*new_block;
 }
 
-void MCK::GameEng::basic_create_texture(
+void MCK::GameEng::basic_decode_image(
     uint8_t bits_per_pixel,
     uint16_t pitch_in_pixels,
     uint16_t height_in_pixels,
     const std::vector<uint8_t> &pixel_data,
     const std::vector<uint8_t> &local_palette,
-    SDL_Texture* &texture
-)
+    uint32_t* pixels
+) const
 {
     // No initialisation check as this is an internal method
     
@@ -1663,371 +4409,314 @@ void MCK::GameEng::basic_create_texture(
         ) );
     }
 
-    // Create new (empty) SDL surface
-    SDL_Surface* surface = NULL;
-    try
-    {
-        surface = SDL_CreateRGBSurface(
-            0,  // No flags used (as per SDL instructions)
-            pitch_in_pixels,
-            height_in_pixels,
-            32,  // depth in bits
-            // Choice of masks here is arbitrary, can be changed if required
-            0x00FF0000,  // Red mask
-            0x0000FF00,  // Green mask
-            0x000000FF,  // Blue mask
-            0xFF000000   // Alpha mask
-        );
-    }
-    catch( const std::exception &e )
-    {
-        throw( std::runtime_error(
-#if defined MCK_STD_OUT
-            "Failed to create new SDL surface, SDL error = "
-            + *SDL_GetError()
-#else
-            ""
-#endif
-        ) );
-    }
-    if( surface == NULL )
-    {
-        throw( std::runtime_error(
-#if defined MCK_STD_OUT
-            "No throw, but new SDL surface NULL, SDL error = "
-            + *SDL_GetError()
-#else
-            ""
-#endif
-        ) );
-    }
-
-    // Check surface width/height
-    if( surface->w != pitch_in_pixels
-        || surface->h != height_in_pixels )
-    {
-        throw( std::runtime_error(
-#if defined MCK_STD_OUT
-            "New SDL Surface width and/or height does "
-            "not match width/height used to create it."
-#else
-            ""
-#endif
-        ) );
-    }
-
-    // Check surface bit depth
-    const SDL_PixelFormat* const FORMAT = surface->format;
-    if( FORMAT == NULL )
-    {
-        throw( std::runtime_error(
-#if defined MCK_STD_OUT
-            "SDL Surface's format is NULL"
-#else
-            ""
-#endif
-        ) );
-    }
-    if( FORMAT->BitsPerPixel != 32 )
-    {
-        throw( std::runtime_error(
-#if defined MCK_STD_OUT
-            "SDL Surface bit depth is not 32 as specified."
-#else
-            ""
-#endif
-        ) );
-    }
-
-    // Check surface has pixels (if width or height is zero,
-    // this will be NULL)
-    if( surface->pixels == NULL )
+    if( bits_per_pixel == 0 || bits_per_pixel > 8 )
     {
         throw( std::runtime_error(
 #if defined MCK_STD_OUT
-            "SDL Surface pixel pointer is NULL, perhaps width/height zero?"
+            "Bits per pixel must be between 1 and 8."
 #else
             ""
 #endif
         ) );
     }
 
-    // Check surface pitch (based on image width and 32 bits per pixel)
-    const int EXPECTED_PITCH = pitch_in_pixels * sizeof( uint32_t );
-    if( EXPECTED_PITCH != surface->pitch )
-    {
-#if defined MCK_STD_OUT
-        std::cout << "SDL Surface pitch is "
-            << surface->pitch
-            << " bytes, not "
-            << EXPECTED_PITCH
-            << " bytes as expected. ** This could be a bug in SDL. ** "
-            << "I will override SDL surface pitch value to the "
-            << "correct value, but be mindful of this if further "
-            << "problems occur, particularly "
-            << "the 'shearing' (diagonalization) of images."
-            << std::endl;
-#endif
-        
-        // Try to correct pitch
-        surface->pitch = EXPECTED_PITCH;
-    }
-
     // Get bit shifts for RGB and alpha
+    const SDL_PixelFormat* const FORMAT = this->texture_pixel_format;
     const uint8_t RSHIFT = FORMAT->Rshift;
     const uint8_t GSHIFT = FORMAT->Gshift;
     const uint8_t BSHIFT = FORMAT->Bshift;
     const uint8_t ASHIFT = FORMAT->Ashift;
 
-    // Get pitch of pixel array when read as double words (4 bytes) 
-    const std::size_t WORD_PITCH = surface->pitch / 4;
-
-    // Get end of pixel array in memory, for safety checks
-    const uint32_t* const WORD_MAX = (uint32_t*) surface->pixels
-                             + surface->h * WORD_PITCH;
-
-    // Lock surface
-    try
+    // Build lookup table of 32bit colo(u)rs, one for each
+    // palette index, noting any index without a valid
+    // colo(u)r (this is only an error if the index is used)
+    const size_t LUT_SIZE = size_t( 0x01 ) << bits_per_pixel;
+    uint32_t lut[ MCK::GameEngPixelDecoder::MAX_LUT_SIZE ];
+    bool all_indices_valid = true;
+    for( size_t i = 0; i < LUT_SIZE; i++ )
     {
-        SDL_LockSurface( surface );
-    }
-    catch( const std::exception &e )
-    {
-        throw( std::runtime_error( 
-#if defined MCK_STD_OUT
-            "Unable to lock SDL surface."
-#else
-            ""
-#endif
-        ) );
+        if( i >= local_palette.size()
+            || local_palette[ i ] >= MCK::TOTAL_CORE_COLORS
+        )
+        {
+            lut[ i ] = 0;
+            all_indices_valid = false;
+            continue;
+        }
+
+        uint8_t r, g, b, a;
+        MCK::GameEng::get_RGBA( local_palette[ i ], r, g, b, a );
+        lut[ i ] = ( uint32_t( r ) << RSHIFT )
+                   | ( uint32_t( g ) << GSHIFT )
+                   | ( uint32_t( b ) << BSHIFT )
+                   | ( uint32_t( a ) << ASHIFT );
     }
 
-    // Loop over pixel data (ignoring any odds bits at the end)
-    uint32_t* surface_word_pos = (uint32_t*) surface->pixels; 
-    uint8_t bit_pos_within_byte = 0;
-    size_t data_pos_in_bytes = 0;
-    uint8_t current_byte = pixel_data[0];  // Checked size > 0
+    // Get number of pixels (ignoring any odd bits at the end),
+    // and check image is large enough to hold them
     const size_t NUM_PIXELS = pixel_data.size() * 8 / bits_per_pixel;
-    for( size_t pixel_pos = 0; pixel_pos < NUM_PIXELS; pixel_pos++ )
+    const size_t IMAGE_SIZE
+        = size_t( pitch_in_pixels ) * size_t( height_in_pixels );
+    if( NUM_PIXELS > IMAGE_SIZE )
     {
-        // Construct colo(u)r ID from next set of bits in pixel data
-        uint8_t palette_col_id = 0x00;
-        for( uint8_t i = 0; i < bits_per_pixel; i++ )
-        {
-            // Calculate mask used to isolate bit from pixel
-            // data, then increment bit position
-            const uint8_t BIT_MASK = 0x01 << ( 7 - bit_pos_within_byte++ );
-
-            // If current bit set to 1,
-            // set i'th bit of 'palette_col_id'
-            if( current_byte & BIT_MASK )
-            {
-                palette_col_id |= 0x01 << ( bits_per_pixel - i - 1 );
-            }
-
-            // If this is end of byte, 
-            // get next byte (unless this is the last byte)
-            if( bit_pos_within_byte > 7
-                && pixel_pos < NUM_PIXELS - 1
-            )
-            {
-                // Set bit pos back to zero
-                bit_pos_within_byte = 0;
-
-                // Increment byte pos, and check does
-                // not exceed data vector
-                if( ++data_pos_in_bytes >= pixel_data.size() )
-                {
-                    throw( std::runtime_error( 
-#if defined MCK_STD_OUT
-                        "Data pos exceeds pixel data, internal error?"
-#else
-                        ""
-#endif
-                    ) );
-                }
-
-                // Get new pixel data byte
-                current_byte = pixel_data[ data_pos_in_bytes ];
-            }
-        }
-        
-        // Check palette_col_id is valid
-        if( palette_col_id >= local_palette.size() )
-        {
-            throw( std::runtime_error( 
+        throw( std::runtime_error( 
 #if defined MCK_STD_OUT
-                "palette_col_id exceeds local_palette, internal error?"
+            "Pixel data exceeds image size, internal error?"
 #else
-                ""
+            ""
 #endif
-            ) );
-        }
-
-        // Get colo(u)r ID from local palette
-        const uint8_t COL_ID = local_palette[ palette_col_id ];
+        ) );
+    }
 
-        // Get RGBA values for this colo(u)r
-        uint8_t r, g, b, a;
-        try
-        {
-            MCK::GameEng::get_RGBA( COL_ID, r, g, b, a );
-        }
-        catch( std::exception &e )
+    // If any index lacks a valid colo(u)r, check none
+    // of the pixels use it
+    if( !all_indices_valid )
+    {
+        for( size_t pixel_pos = 0; pixel_pos < NUM_PIXELS; pixel_pos++ )
         {
-            throw( std::runtime_error( 
+            const uint8_t PALETTE_COL_ID
+                = MCK::GameEngPixelDecoder::get_index(
+                    bits_per_pixel,
+                    pixel_data.data(),
+                    pixel_pos
+                );
+            if( PALETTE_COL_ID >= local_palette.size() )
+            {
+                throw( std::runtime_error( 
 #if defined MCK_STD_OUT
-                std::string( "Failed to decode colo(u)r ID " )
-                + std::to_string( COL_ID )
-                + std::string( ", error = " )
-                + e.what()
+                    "palette_col_id exceeds local_palette, internal error?"
 #else
-                ""
+                    ""
 #endif
-            ) );
-        }
-
-        // Calculate 32bit colo(u)r
-        const uint32_t COL_32
-            = ( r << RSHIFT )
-              | ( g << GSHIFT )
-              | ( b << BSHIFT )
-              | ( a << ASHIFT );
-
-        // Set surface pixel, and increment surface word position
-        if( surface_word_pos < WORD_MAX )
-        {
-            *surface_word_pos++ = COL_32;
-        }
-        else
-        {
-            throw( std::runtime_error( 
+                ) );
+            }
+            if( local_palette[ PALETTE_COL_ID ] >= MCK::TOTAL_CORE_COLORS )
+            {
+                throw( std::runtime_error( 
 #if defined MCK_STD_OUT
-                "surface_word_pos exceeds WORD_MAX, internal error?"
+                    std::string( "Failed to decode colo(u)r ID " )
+                    + std::to_string( local_palette[ PALETTE_COL_ID ] )
 #else
-                ""
+                    ""
 #endif
-            ) );
+                ) );
+            }
         }
     }
-    
-    // Unlock surface
-    try
-    {
-        SDL_UnlockSurface( surface );
-    }
-    catch( const std::exception &e )
+
+    // Expand pixel data, and clear any pixels
+    // not covered by it (i.e. end of last row)
+    MCK::GameEngPixelDecoder::decode(
+        bits_per_pixel,
+        pixel_data.data(),
+        NUM_PIXELS,
+        lut,
+        pixels
+    );
+    std::fill( pixels + NUM_PIXELS, pixels + IMAGE_SIZE, 0 );
+}
+
+///////////////////////////////////////////////
+
+std::vector<uint32_t>& MCK::GameEng::get_scratch_pixels( size_t num_pixels )
+{
+    // One buffer per thread, so images may be decoded on
+    // any thread. It is never shrunk, so once the largest
+    // image has been decoded, no more allocation is needed.
+    static thread_local std::vector<uint32_t> scratch;
+    if( scratch.size() < num_pixels )
     {
-        throw( std::runtime_error(
-#if defined MCK_STD_OUT
-            "Unable to unlock SDL surface."
-#else
-            ""
-#endif
-        ) );
+        scratch.resize( num_pixels );
     }
+    return scratch;
+}
 
-    //////////////////////////////////////////////////
-    // Create texture from surface
-    //
-    
+///////////////////////////////////////////////
+
+void MCK::GameEng::basic_create_texture(
+    uint8_t bits_per_pixel,
+    uint16_t pitch_in_pixels,
+    uint16_t height_in_pixels,
+    const std::vector<uint8_t> &pixel_data,
+    const std::vector<uint8_t> &local_palette,
+    SDL_Texture* &texture,
+    bool streaming
+)
+{
+    // No initialisation check as this is an internal method
+
+    texture = NULL;
+
+    // Decode image into scratch buffer, then upload
+    // (let calling method catch any exceptions)
+    std::vector<uint32_t> &pixels = MCK::GameEng::get_scratch_pixels(
+        size_t( pitch_in_pixels ) * size_t( height_in_pixels )
+    );
+    this->basic_decode_image(
+        bits_per_pixel,
+        pitch_in_pixels,
+        height_in_pixels,
+        pixel_data,
+        local_palette,
+        pixels.data()
+    );
+    this->basic_upload_texture(
+        pitch_in_pixels,
+        height_in_pixels,
+        pixels.data(),
+        texture,
+        streaming
+    );
+}
+
+///////////////////////////////////////////////
+
+void MCK::GameEng::basic_upload_texture(
+    uint16_t pitch_in_pixels,
+    uint16_t height_in_pixels,
+    const uint32_t* pixels,
+    SDL_Texture* &texture,
+    bool streaming
+)
+{
+    // No initialisation check as this is an internal method
+
+    texture = NULL;
+
+    // Create texture in renderer's own format,
+    // so upload needs no conversion
     // Warning, this command will 
     // produce a segfault if 'renderer' pointer is
     // set to a junk value
-    try
-    {
-        texture = SDL_CreateTextureFromSurface( this->renderer, surface );
-    }
-    catch( const std::exception &e )
+    texture = SDL_CreateTexture(
+        this->renderer,
+        this->texture_format,
+        streaming ? SDL_TEXTUREACCESS_STREAMING : SDL_TEXTUREACCESS_STATIC,
+        pitch_in_pixels,
+        height_in_pixels
+    );
+    if( texture == NULL )
     {
         throw( std::runtime_error(
 #if defined MCK_STD_OUT
-            "Unable to create SDL texture, error: " 
-            + *SDL_GetError()
+            std::string( "Unable to create SDL texture, error: " )
+            + SDL_GetError()
 #else
             ""
 #endif
         ) );
     }
-    catch( ... )
+
+    // Enable alpha blending (as SDL_CreateTextureFromSurface
+    // does for surfaces with alpha)
+    SDL_SetTextureBlendMode( texture, SDL_BLENDMODE_BLEND );
+
+    // Upload pixels
+    if( SDL_UpdateTexture(
+            texture,
+            NULL,  // Entire texture
+            pixels,
+            pitch_in_pixels * sizeof( uint32_t )
+        ) != 0
+    )
     {
+        SDL_DestroyTexture( texture );
+        texture = NULL;
         throw( std::runtime_error(
 #if defined MCK_STD_OUT
-            "Create SDL texture has thrown non-exception, error: " 
-            + *SDL_GetError()
+            std::string( "Unable to update SDL texture, error: " )
+            + SDL_GetError()
 #else
             ""
 #endif
         ) );
     }
+}
 
-    if( texture == NULL )
+///////////////////////////////////////////////
+
+void MCK::GameEng::basic_update_texture(
+    uint8_t bits_per_pixel,
+    uint16_t pitch_in_pixels,
+    uint16_t height_in_pixels,
+    const std::vector<uint8_t> &pixel_data,
+    const std::vector<uint8_t> &local_palette,
+    SDL_Texture* texture
+)
+{
+    // No initialisation check as this is an internal method
+
+    void* locked_pixels = NULL;
+    int locked_pitch = 0;
+    if( SDL_LockTexture( texture, NULL, &locked_pixels, &locked_pitch ) != 0 )
     {
         throw( std::runtime_error(
 #if defined MCK_STD_OUT
-            "New SDL texture is NULL."
+            std::string( "Unable to lock SDL texture, error: " )
+            + SDL_GetError()
 #else
             ""
 #endif
         ) );
     }
-    else
+
+    try
     {
-        // Check texture size matches nominal size
-        // of RAM image surface
-        Uint32 format;
-        int access, w, h;
-        int rc = SDL_QueryTexture(
-            texture,
-            &format,
-            &access,
-            &w,
-            &h );
-        
-        if( rc != 0 )
+        // Decode straight into texture, unless
+        // its rows are padded
+        const int ROW_SIZE = pitch_in_pixels * sizeof( uint32_t );
+        if( locked_pitch == ROW_SIZE )
         {
-            throw( std::runtime_error(
-#if defined MCK_STD_OUT
-                "Unable to query new texture, error code = "
-                + std::to_string( rc ) 
-#else
-                ""
-#endif
-            ) );
+            this->basic_decode_image(
+                bits_per_pixel,
+                pitch_in_pixels,
+                height_in_pixels,
+                pixel_data,
+                local_palette,
+                static_cast<uint32_t*>( locked_pixels )
+            );
         }
         else
         {
-            if( w != surface->w
-                || h != surface->h )
+            std::vector<uint32_t> &pixels = MCK::GameEng::get_scratch_pixels(
+                size_t( pitch_in_pixels ) * size_t( height_in_pixels )
+            );
+            this->basic_decode_image(
+                bits_per_pixel,
+                pitch_in_pixels,
+                height_in_pixels,
+                pixel_data,
+                local_palette,
+                pixels.data()
+            );
+            for( uint16_t y = 0; y < height_in_pixels; y++ )
             {
-                throw( std::runtime_error(
-#if defined MCK_STD_OUT
-                    "Texture size not same as "
-                    "nominal size of source surface."
-#else
-                    ""
-#endif
-                ) );
+                std::memcpy(
+                    static_cast<uint8_t*>( locked_pixels ) + y * locked_pitch,
+                    pixels.data() + y * pitch_in_pixels,
+                    ROW_SIZE
+                );
             }
         }
     }
-   
-    // Destroy surface
-    try
-    {
-        SDL_FreeSurface( surface );
-    }
-    catch( const std::exception &e )
+    catch( std::exception &e )
     {
-#if defined MCK_STD_OUT && defined MCK_VERBOSE
-        // Issue a warning, but no point throwing exception here
-        std::cout << "Unable to destroy SDL surface, error: " 
-                  << SDL_GetError()
-                  << std::endl;
+        SDL_UnlockTexture( texture );
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Unable to decode image into texture, error: " )
+            + e.what()
+#else
+            ""
 #endif
+        ) );
     }
+
+    SDL_UnlockTexture( texture );
 }
 
+///////////////////////////////////////////////
+
 std::shared_ptr<MCK::GameEngRenderInfo> MCK::GameEng::create_blank_tex_render_info(
     uint8_t col_id,
     std::shared_ptr<MCK::GameEngRenderBlock> parent_block,
@@ -2066,7 +4755,9 @@ std::shared_ptr<MCK::GameEngRenderInfo> MCK::GameEng::create_blank_tex_render_in
 
     // Create new info instance
     std::shared_ptr<MCK::GameEngRenderInfo> new_info
-        = std::make_shared<MCK::GameEngRenderInfo>();
+        = std::allocate_shared<MCK::GameEngRenderInfo>(
+              MCK::GameEngPoolAllocator<MCK::GameEngRenderInfo>()
+          );
     new_info->tex = BLANK_TEX;
     new_info->tex_id = MCK::INVALID_TEX_ID;
     new_info->dest_rect = dest_rect;
@@ -2081,6 +4772,7 @@ std::shared_ptr<MCK::GameEngRenderInfo> MCK::GameEng::create_blank_tex_render_in
        
         try
         {
+            parent_block->mark_changed();
             parent_block->render_instances.insert(
                 std::pair<
                     uint64_t,
@@ -2115,7 +4807,7 @@ void MCK::GameEng::change_z(
     std::shared_ptr<MCK::GameEngRenderBase> render_instance,
     std::shared_ptr<MCK::GameEngRenderBlock> parent_block,
     uint32_t new_z,
-    bool use_current_z_as_hint
+    bool /* use_current_z_as_hint */
 )
 {
     if( render_instance.get() == NULL
@@ -2133,137 +4825,151 @@ void MCK::GameEng::change_z(
         ) );
     }
 
-    // Declare iterator to entry of render_instance in partent block
-    std::multimap<
-        uint64_t,
-        std::shared_ptr<MCK::GameEngRenderBase>
-    >::iterator it;
-
-    // Explainer: there is a *theoretical* possiblity of more than
-    //            one instance sharing the same key, but only if
-    //            more than 2^32 render instances have been
-    //            created.
-    //
-    //            To account for this, the 'strict' option uses
-    //            'equal_range' when searching the multimap
-    //            instead of 'find'.
-    if( MCK::GameEngRenderBase::duplicate_ids_exist )
+    // Find entry of render_instance in parent block
+    const MCK::GameEngRenderInstanceVec::iterator IT
+        = MCK::GameEng::find_render_instance(
+              parent_block.get(),
+              render_instance.get()
+          );
+    if( IT == parent_block->render_instances.end() )
     {
-        // Get instance's entry in parent blocks map of render instances
-        std::pair<
-            std::multimap<
-                uint64_t,
-                std::shared_ptr<MCK::GameEngRenderBase>
-            >::iterator,
-            std::multimap<
-                uint64_t,
-                std::shared_ptr<MCK::GameEngRenderBase>
-            >::iterator
-        > range = parent_block->render_instances.equal_range(
-            render_instance->render_order
-        );
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Failed to change 'z' as no matching " )
+            + std::string( "instance found in parent." )
+#else
+            ""
+#endif
+        ) );
+    }
 
-        // Now loop over all return iterators to find the
-        // correct entry
-        for( it = range.first;
-             it != parent_block->render_instances.end(); it++ )
-        {
-            // Check if this is 'render_instance'
-            if( it->second.get() == render_instance.get() )
-            {
-                // Found it
-                break;
-            }
-        }
+    // Change 'z' in render instance
+    // (Also record change for compiled render list)
+    parent_block->mark_changed();
+    const uint32_t ID = render_instance->get_id();
+    render_instance->render_order = ( uint64_t( new_z ) << 32 ) | ID;
+
+    // Update key in parent block. The entry is moved to
+    // its new position when the block is next iterated,
+    // and finding entries does not re-sort the block, so
+    // many changes per frame cost a single re-sort.
+    parent_block->render_instances.change_key(
+        IT,
+        render_instance->render_order
+    );
+}
 
-        // If no match found, throw exception
+void MCK::GameEng::change_z_bulk(
+    std::shared_ptr<MCK::GameEngRenderBlock> parent_block,
+    const MCK::GameEng::ZChange* changes,
+    size_t num_changes
+)
+{
+    if( parent_block.get() == NULL
+        || ( changes == NULL && num_changes > 0 )
+    )
+    {
         throw( std::runtime_error(
 #if defined MCK_STD_OUT
-            std::string( "Failed to change 'z' as now matching " )
-            + std::string( "instance found in parent." )
+            std::string( "Failed to change 'z' in bulk as " )
+            + std::string( "parent block or changes pointer is NULL." )
 #else
             ""
 #endif
         ) );
     }
-    else
+
+    if( num_changes == 0 )
     {
-        it = parent_block->render_instances.find(
-            render_instance->render_order
-        );
+        return;
+    }
 
-        // Quality check
-        if( it == parent_block->render_instances.end()
-            || it->second.get() != render_instance.get() )
+    // Find all entries *before* changing any, so nothing
+    // is changed if any entry cannot be found. This also
+    // keeps each search to the block's sorted entries.
+    std::vector<MCK::GameEngRenderInstanceVec::iterator> its;
+    its.reserve( num_changes );
+    for( size_t i = 0; i < num_changes; i++ )
+    {
+        const MCK::GameEngRenderBase* const INSTANCE
+            = changes[ i ].instance.get();
+
+        if( INSTANCE == NULL
+            || INSTANCE->parent_block != parent_block.get()
+        )
         {
             throw( std::runtime_error(
 #if defined MCK_STD_OUT
-                std::string( "(2)Failed to change 'z' as no matching " )
-                + std::string( "instance found in parent." )
+                std::string( "Failed to change 'z' in bulk as " )
+                + std::string( "instance/parent integrity check " )
+                + std::string( "failed for change " )
+                + std::to_string( i )
+                + std::string( "." )
 #else
                 ""
 #endif
             ) );
         }
-    }
-
-    // Remove existing instance from parent block
-    // Returns iterator to next element (or end)
-    // This is so 'it' can safely be used as a hint
-    // below
-    it = parent_block->render_instances.erase( it );
-
-    // Temporarily store ID of render instance
-    const uint32_t ID = render_instance->get_id();
-
-    // Change 'z' in render instance
-    render_instance->render_order = ( uint64_t( new_z ) << 32 ) | ID;
 
-    // Re-insert into parent block
-    try
-    {
-        if( use_current_z_as_hint
-            && it != parent_block->render_instances.end()
-        )
-        {
-            parent_block->render_instances.insert(
-                it,  // Hint
-                std::pair<
-                    uint64_t,
-                    std::shared_ptr<MCK::GameEngRenderBase>
-                >(
-                    render_instance->render_order,
-                    render_instance
-                )
-            );
-        }
-        else
+        its.push_back(
+            MCK::GameEng::find_render_instance(
+                parent_block.get(),
+                INSTANCE
+            )
+        );
+        if( its.back() == parent_block->render_instances.end() )
         {
-            parent_block->render_instances.insert(
-                std::pair<
-                    uint64_t,
-                    std::shared_ptr<MCK::GameEngRenderBase>
-                >(
-                    render_instance->render_order,
-                    render_instance
-                )
-            );
-        }
-    }
-    catch( const std::exception &e )
-    {
-        throw( std::runtime_error(
+            throw( std::runtime_error(
 #if defined MCK_STD_OUT
-            std::string( "Failed to re-insert render info " )
-            + std::string( "into parent block, error = " )
-            + e.what()
+                std::string( "Failed to change 'z' in bulk as no " )
+                + std::string( "matching instance found in parent " )
+                + std::string( "for change " )
+                + std::to_string( i )
+                + std::string( "." )
 #else
-            ""
+                ""
 #endif
-        ) );
+            ) );
+        }
+    }
+
+    // Apply changes. Entries are moved to their new
+    // positions by a single re-sort, when the block is
+    // next iterated.
+    parent_block->mark_changed();
+    for( size_t i = 0; i < num_changes; i++ )
+    {
+        MCK::GameEngRenderBase* const INSTANCE
+            = changes[ i ].instance.get();
+        INSTANCE->render_order
+            = ( uint64_t( changes[ i ].new_z ) << 32 )
+                | INSTANCE->get_id();
+        parent_block->render_instances.change_key(
+            its[ i ],
+            INSTANCE->render_order
+        );
     }
 }
 
+MCK::GameEngRenderInstanceVec::iterator MCK::GameEng::find_render_instance(
+    MCK::GameEngRenderBlock* block,
+    const MCK::GameEngRenderBase* instance
+)
+{
+    // Explainer: there is a *theoretical* possiblity of more than
+    //            one instance sharing the same key, but only if
+    //            more than 2^32 render instances have been
+    //            created. This is accounted for by matching
+    //            the instance itself, not just its key.
+    //
+    //            The search does not re-sort the block, so
+    //            this remains cheap between changes of 'z'.
+    return block->render_instances.find_instance(
+        instance,
+        instance->render_order
+    );
+}
+
 /*
 std::shared_ptr<MCK::Sprite<MCK::GameEngRenderInfo>> MCK::GameEng::create_sprite(
     std::shared_ptr<MCK::SpriteAnimBase> _anim,
@@ -2332,29 +5038,23 @@ std::shared_ptr<MCK::Sprite<MCK::GameEngRenderInfo>> MCK::GameEng::create_sprite
     }
 
     // Get texture
-    SDL_Texture* tex = NULL;
+    MCK::GameEng::TextureRecord* const RECORD = this->textures.find( tex_id );
+
+    // If texture does not exist, throw exception
+    if( RECORD == NULL )
     {
-        std::map<MCK_TEX_ID_TYPE,SDL_Texture*>::const_iterator it 
-            = this->textures.find( tex_id );
-        
-        // If texture does not exist, throw exception
-        if( it == this->textures.end() )
-        {
-            throw( std::runtime_error(
+        throw( std::runtime_error(
 #if defined MCK_STD_OUT
-                std::string( "Cannot create render info as texture with id " )
-                + std::to_string( tex_id )
-                + std::string( " does not exist." )
+            std::string( "Cannot create render info as texture with id " )
+            + std::to_string( tex_id )
+            + std::string( " does not exist." )
 #else
-                ""
+            ""
 #endif
-            ) );
-        }
-
-        tex = it->second;
+        ) );
     }
 
-    if( tex == NULL )
+    if( RECORD->tex == NULL )
     {
         throw( std::runtime_error(
 #if defined MCK_STD_OUT
@@ -2378,8 +5078,7 @@ std::shared_ptr<MCK::Sprite<MCK::GameEngRenderInfo>> MCK::GameEng::create_sprite
 
     // Set variables inherited from GameEngRenderInfo
     // and GameEngRenderBase
-    sprite->tex_id = tex_id;
-    sprite->tex = tex;
+    this->set_render_info_tex( *sprite, tex_id, *RECORD );
     sprite->dest_rect = dest_rect;
     sprite->flags = MCK::GameEngRenderInfo::calc_flags(
         rotation,
@@ -2395,6 +5094,7 @@ std::shared_ptr<MCK::Sprite<MCK::GameEngRenderInfo>> MCK::GameEng::create_sprite
 
         try
         {
+            parent_block->mark_changed();
             parent_block->render_instances.insert(
                 std::pair<
                     uint64_t,
@@ -410,6 +410,10 @@ void MCK::GameEngAudio::callback(
     int bytes
 )
 {
+#if defined MCK_PROFILE
+    MCK::GameEngProfiler::Zone zone( "GameEngAudio::callback" );
+#endif
+
     // Get number of samples required
     const int LENGTH = bytes / MCK::GameEngAudio::bytes_per_sample;
 
@@ -29,6 +29,22 @@
 ////////////////////////////////////////////
 
 #include "GameEngRenderBase.h"
+#include "GameEngRenderBlock.h"
 
 uint32_t MCK::GameEngRenderBase::next_id = 0;
 bool MCK::GameEngRenderBase::duplicate_ids_exist = false;
+uint64_t MCK::GameEngRenderBase::next_revision = 0;
+
+void MCK::GameEngRenderBase::invalidate_bounds(
+    const MCK::GameEngRenderBlock* block
+) noexcept
+{
+    block->invalidate_bounds();
+}
+
+void MCK::GameEngRenderBase::content_changed(
+    const MCK::GameEngRenderBlock* block
+) noexcept
+{
+    block->content_changed();
+}
@@ -34,6 +34,8 @@
 
 #include "ImageMan.h"
 
+#include <algorithm>  // For min, max
+
 MCK::ImageMan::ImageMan( void )
 {
     // Set all variables to invalid/default values
@@ -123,77 +125,320 @@ MCK_PAL_ID_TYPE MCK::ImageMan::create_local_palette(
         ) );
     }
 
-    const size_t SIZE = global_color_ids->size();
-
-    if( SIZE == 0 )
+    if( global_color_ids.get() == NULL || global_color_ids->size() == 0 )
     {
         throw( std::runtime_error(
 #if defined MCK_STD_OUT
             std::string( "Cannot create local palette as " )
-            + std::string( "color id vector has zero size." )
+            + std::string( "color id vector is NULL or has zero size." )
 #else
             ""
 #endif
         ) );
     }
 
-    // Loop over existing palettes and check for match
-    const MCK_PAL_ID_TYPE NUM_PAL = this->palettes_by_id.size();
-    for( MCK_PAL_ID_TYPE id = 0; id < NUM_PAL; id++ )
+    // Check for existing palette with same contents
     {
-        // Get pointer to palette
-        const std::shared_ptr<std::vector<uint8_t>> PALETTE
-            = this->palettes_by_id[id];
-
-        // Ignore NULL pointers
-        if( PALETTE.get() == NULL )
+        const std::unordered_map<
+            std::vector<uint8_t>,
+            MCK_PAL_ID_TYPE,
+            MCK::ImageMan::PaletteHash
+        >::const_iterator IT
+            = this->palette_ids_by_color_ids.find( *global_color_ids );
+        if( IT != this->palette_ids_by_color_ids.end() )
         {
-            continue;
+            // Return ID of existing palette
+            return IT->second;
         }
+    }
 
-        // If different length, no match
-        if( PALETTE->size() != SIZE )
-        {
-            continue;
-        }
+    // Unlikey, but check if we've run out of palette IDs
+    if( this->palettes_by_id.size() == MCK::INVALID_IMG_ID )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot create local palette as run out of palette IDS."
+#else
+            ""
+#endif
+        ) );
+    }
 
-        // If size matches, loop over elements
-        size_t count = 0;
-        bool match = true;
-        for( const uint8_t COLOR_ID : *PALETTE )
-        {
-            if( global_color_ids->at(count) != COLOR_ID )
-            {
-                match = false;
-                break;
-            }
-        }
+    // If we get to this point, this local
+    // palette is new, so assign it a new ID
+    this->palettes_by_id.push_back( global_color_ids );
+    const MCK_PAL_ID_TYPE ID = this->palettes_by_id.size() - 1;
+    this->palette_ids_by_color_ids[ *global_color_ids ] = ID;
+
+    // Return index of new palette as ID
+    return ID;
+}
+
+std::vector<MCK_PAL_ID_TYPE> MCK::ImageMan::create_local_palettes(
+    const std::vector<std::shared_ptr<std::vector<uint8_t>>> &palettes
+)
+{
+    if( !this->initialized )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot create local palettes as Image Manager not yet init."
+#else
+            ""
+#endif
+        ) );
+    }
 
-        if( match )
+    // Check all palettes before creating any
+    for( size_t i = 0; i < palettes.size(); i++ )
+    {
+        if( palettes[ i ].get() == NULL || palettes[ i ]->size() == 0 )
         {
-            // Return ID of existing palette
-            return id;
+            throw( std::runtime_error(
+#if defined MCK_STD_OUT
+                std::string( "Cannot create local palettes as " )
+                + std::string( "palette " )
+                + std::to_string( i )
+                + std::string( " is NULL or has zero size." )
+#else
+                ""
+#endif
+            ) );
         }
     }
 
+    if( this->palettes_by_id.size() + palettes.size()
+            >= size_t( MCK::INVALID_PAL_ID )
+    )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot create local palettes as would run out of palette IDS."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    this->palettes_by_id.reserve( this->palettes_by_id.size() + palettes.size() );
+    this->palette_ids_by_color_ids.reserve(
+        this->palette_ids_by_color_ids.size() + palettes.size()
+    );
+
+    // Let calling method catch any (unlikely) exceptions
+    std::vector<MCK_PAL_ID_TYPE> ids;
+    ids.reserve( palettes.size() );
+    for( const auto &palette : palettes )
+    {
+        ids.push_back( this->create_local_palette( palette ) );
+    }
+
+    return ids;
+}
+
+MCK_PAL_ID_TYPE MCK::ImageMan::create_cycling_palette(
+    const std::vector<uint8_t> &global_color_ids
+)
+{
+    if( !this->initialized )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot create cycling palette as Image Manager not yet init."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    if( global_color_ids.size() == 0 )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Cannot create cycling palette as " )
+            + std::string( "color id vector has zero size." )
+#else
+            ""
+#endif
+        ) );
+    }
+
     // Unlikey, but check if we've run out of palette IDs
     if( this->palettes_by_id.size() == MCK::INVALID_IMG_ID )
     {
         throw( std::runtime_error(
 #if defined MCK_STD_OUT
-            "Cannot create local palette as run out of palette IDS."
+            "Cannot create cycling palette as run out of palette IDS."
 #else
             ""
 #endif
         ) );
     }
 
-    // If we get to this point, assume this local
-    // palette is new, and assign it a new ID
-    this->palettes_by_id.push_back( global_color_ids );
+    // Palette is a copy, as its colo(u)rs are
+    // changed in place as it cycles
+    this->palettes_by_id.push_back(
+        std::make_shared<std::vector<uint8_t>>( global_color_ids )
+    );
+    const MCK_PAL_ID_TYPE ID = this->palettes_by_id.size() - 1;
+    this->palette_cycles[ ID ].base_color_ids = global_color_ids;
 
-    // Return index of new palette as ID
-    return this->palettes_by_id.size() - 1;
+    return ID;
+}
+
+void MCK::ImageMan::add_palette_cycle(
+    MCK_PAL_ID_TYPE local_palette_id,
+    uint8_t first_index,
+    uint8_t num_indices,
+    uint32_t ticks_per_step,
+    bool reverse
+)
+{
+    std::map<MCK_PAL_ID_TYPE,MCK::ImageMan::PaletteCycle>::iterator it
+        = this->palette_cycles.find( local_palette_id );
+    if( it == this->palette_cycles.end() )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Cannot add palette cycle as local palette ID " )
+            + std::to_string( local_palette_id ) 
+            + std::string( " is not a cycling palette." )
+#else
+            ""
+#endif
+        ) );
+    }
+
+    if( num_indices < 2
+        || size_t( first_index ) + size_t( num_indices )
+               > it->second.base_color_ids.size()
+        || ticks_per_step == 0
+    )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Cannot add palette cycle as range (" )
+            + std::to_string( first_index )
+            + std::string( " + " )
+            + std::to_string( num_indices )
+            + std::string( ") or ticks per step (" )
+            + std::to_string( ticks_per_step )
+            + std::string( ") invalid." )
+#else
+            ""
+#endif
+        ) );
+    }
+
+    MCK::ImageMan::PaletteCycleRange range;
+    range.first_index = first_index;
+    range.num_indices = num_indices;
+    range.ticks_per_step = ticks_per_step;
+    range.reverse = reverse;
+    range.step = 0;
+    it->second.ranges.push_back( range );
+}
+
+size_t MCK::ImageMan::update_palette_cycles( uint32_t ticks )
+{
+    if( !this->initialized )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot update palette cycles as Image Manager not yet init."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    size_t num_updated = 0;
+    for( auto &it : this->palette_cycles )
+    {
+        MCK::ImageMan::PaletteCycle &cycle = it.second;
+
+        // Check whether any range has moved on
+        bool changed = false;
+        for( MCK::ImageMan::PaletteCycleRange &range : cycle.ranges )
+        {
+            const uint8_t STEP
+                = uint8_t( ( ticks / range.ticks_per_step ) % range.num_indices );
+            if( STEP != range.step )
+            {
+                range.step = STEP;
+                changed = true;
+            }
+        }
+        if( !changed )
+        {
+            continue;
+        }
+
+        // Rotate colo(u)rs of each range, in place
+        // (so any textures created later also use them)
+        std::vector<uint8_t> &color_ids = *this->palettes_by_id[ it.first ];
+        color_ids = cycle.base_color_ids;
+        for( const MCK::ImageMan::PaletteCycleRange &RANGE : cycle.ranges )
+        {
+            const uint8_t SHIFT
+                = RANGE.reverse ? RANGE.step : RANGE.num_indices - RANGE.step;
+            for( uint8_t i = 0; i < RANGE.num_indices; i++ )
+            {
+                color_ids[ RANGE.first_index + i ]
+                    = cycle.base_color_ids[
+                        RANGE.first_index + ( i + SHIFT ) % RANGE.num_indices
+                    ];
+            }
+        }
+
+        // Update textures in place
+        for( const MCK_IMG_ID_TYPE IMAGE_ID : cycle.image_ids )
+        {
+            // Skip textures evicted by GameEng (these are
+            // re-created with current colo(u)rs when needed)
+            const MCK_TEX_ID_TYPE TEX_ID
+                = this->game_eng->calc_tex_id( IMAGE_ID, it.first );
+            if( !this->game_eng->texture_exists( TEX_ID ) )
+            {
+                continue;
+            }
+
+            const MCK::ImageMan::ImageMetaData* const META_DATA
+                = &this->image_meta_data_by_id[ IMAGE_ID ];
+            const std::vector<uint8_t>* const PIXEL_DATA
+                = META_DATA->pixel_data.get() != NULL
+                    ? META_DATA->pixel_data.get()
+                    : META_DATA->alt_pixel_data;
+            try
+            {
+                this->game_eng->update_texture(
+                    TEX_ID,
+                    META_DATA->get_bits_per_pixel(),
+                    META_DATA->get_pitch_in_pixels(),
+                    *PIXEL_DATA,
+                    color_ids
+                );
+            }
+            catch( std::exception &e )
+            {
+                throw( std::runtime_error(
+#if defined MCK_STD_OUT
+                    std::string( "Failed to update texture of image ID " )
+                    + std::to_string( IMAGE_ID )
+                    + std::string( " for cycling palette ID " )
+                    + std::to_string( it.first )
+                    + std::string( ", error = " )
+                    + e.what()
+#else
+                    ""
+#endif
+                ) );
+            }
+            num_updated++;
+        }
+    }
+
+    return num_updated;
 }
 
 std::shared_ptr<MCK::GameEngRenderInfo> MCK::ImageMan::create_texture_and_render_info(
@@ -260,8 +505,11 @@ std::shared_ptr<MCK::GameEngRenderInfo> MCK::ImageMan::create_texture_and_render
             pixel_data,
             *this->palettes_by_id[ local_palette_id ],
             tex_id,
-            height_in_pixels
+            height_in_pixels,
+            false,  // Don't throw if exists
+            this->is_cycling_palette( local_palette_id )  // Streaming
         );
+        this->register_cycling_texture( image_id, local_palette_id );
     }
     catch( std::exception &e )
     {
@@ -794,8 +1042,11 @@ void MCK::ImageMan::change_render_info_tex(
                 *pixel_data_ptr,
                 *palettes_by_id[ local_palette_id ],
                 tex_id,
-                height_in_pixels
+                height_in_pixels,
+                false,  // Don't throw if exists
+                this->is_cycling_palette( local_palette_id )  // Streaming
             );
+            this->register_cycling_texture( image_id, local_palette_id );
         }
         catch( std::exception &e )
         {
@@ -855,71 +1106,693 @@ void MCK::ImageMan::change_render_info_tex(
     // If necessary, update size of destination rect
     if( info.get() != NULL )
     {
-        // If keeping neither width or height, just use
-        // source image size
-        if( !keep_orig_dest_rect_width
-            && !keep_orig_dest_rect_height
-        )
-        {
-            info->dest_rect.set_w( META_DATA->get_pitch_in_pixels() );
-            info->dest_rect.set_h( META_DATA->get_height_in_pixels() );
+        MCK::ImageMan::fit_dest_rect(
+            *info,
+            META_DATA->get_pitch_in_pixels(),
+            META_DATA->get_height_in_pixels(),
+            keep_orig_dest_rect_width,
+            keep_orig_dest_rect_height
+        );
+    }
+}
+
+void MCK::ImageMan::fit_dest_rect(
+    MCK::GameEngRenderInfo &info,
+    uint16_t width_in_pixels,
+    uint16_t height_in_pixels,
+    bool keep_orig_dest_rect_width,
+    bool keep_orig_dest_rect_height
+) noexcept
+{
+    // If keeping neither width or height, just use
+    // source image size
+    if( !keep_orig_dest_rect_width
+        && !keep_orig_dest_rect_height
+    )
+    {
+        info.dest_rect.set_w( width_in_pixels );
+        info.dest_rect.set_h( height_in_pixels );
 
+    }
+    // If keeping width, set height of new image using existing
+    // horizontal scale
+    else if( keep_orig_dest_rect_width )
+    {
+        // Adjust height, in proportion current hoz scale (sic)
+        const int RAW_WIDTH = width_in_pixels;
+        if( RAW_WIDTH > 0 )
+        {
+            const float HOZ_SCALE
+                = float( info.dest_rect.get_w() ) 
+                    / float( RAW_WIDTH );
+            info.dest_rect.set_h(
+                int(
+                    float( height_in_pixels )
+                        * HOZ_SCALE
+                    + 0.5f
+                )
+            );
         }
-        // If keeping width, set height of new image using existing
-        // horizontal scale
-        else if( keep_orig_dest_rect_width )
+        else
         {
-            // Adjust height, in proportion current hoz scale (sic)
-            const int RAW_WIDTH = META_DATA->get_pitch_in_pixels();
-            if( RAW_WIDTH > 0 )
-            {
-                const float HOZ_SCALE
-                    = float( info->dest_rect.get_w() ) 
-                        / float( RAW_WIDTH );
-                info->dest_rect.set_h(
-                    int(
-                        float( META_DATA->get_height_in_pixels() )
-                            * HOZ_SCALE
-                        + 0.5f
-                    )
-                );
-            }
-            else
-            {
-                info->dest_rect.set_h(
-                    META_DATA->get_height_in_pixels()
-                );
-            }
+            info.dest_rect.set_h(
+                height_in_pixels
+            );
         }
-        // If keeping height, set width of new image using existing
-        // vertical scale
-        else if( keep_orig_dest_rect_height )
+    }
+    // If keeping height, set width of new image using existing
+    // vertical scale
+    else if( keep_orig_dest_rect_height )
+    {
+        // Adjust width, in proportion current vert scale (sic)
+        const int RAW_HEIGHT = height_in_pixels;
+        if( RAW_HEIGHT > 0 )
         {
-            // Adjust width, in proportion current vert scale (sic)
-            const int RAW_HEIGHT = META_DATA->get_height_in_pixels();
-            if( RAW_HEIGHT > 0 )
-            {
-                const float VERT_SCALE
-                    = float( info->dest_rect.get_h() ) 
-                        / float( RAW_HEIGHT );
-                info->dest_rect.set_w(
-                    int(
-                        float( META_DATA->get_pitch_in_pixels() )
-                            * VERT_SCALE
-                        + 0.5f
-                    )
-                );
-            }
-            else
-            {
-                info->dest_rect.set_w(
-                    META_DATA->get_pitch_in_pixels()
-                );
-            }
+            const float VERT_SCALE
+                = float( info.dest_rect.get_h() ) 
+                    / float( RAW_HEIGHT );
+            info.dest_rect.set_w(
+                int(
+                    float( width_in_pixels )
+                        * VERT_SCALE
+                    + 0.5f
+                )
+            );
+        }
+        else
+        {
+            info.dest_rect.set_w(
+                width_in_pixels
+            );
         }
     }
 }
 
+void MCK::ImageMan::acquire_tex_handle(
+    MCK_IMG_ID_TYPE image_id,
+    MCK_PAL_ID_TYPE local_palette_id,
+    MCK::GameEngRenderInfo::TexHandle &handle,
+    uint16_t &width_in_pixels,
+    uint16_t &height_in_pixels
+) const
+{
+    // Check IDs and create texture if necessary
+    // (a NULL info pointer instructs 'change_render_info_tex'
+    //  to check/create texture only)
+    try
+    {
+        this->change_render_info_tex(
+            std::shared_ptr<MCK::GameEngRenderInfo>(),
+            image_id,
+            local_palette_id
+        );
+    }
+    catch( std::exception &e )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Cannot acquire texture handle as texture " )
+            + std::string( "check/creation failed, error = " )
+            + e.what()
+#else
+            ""
+#endif
+        ) );
+    }
+
+    // Safe, as image ID checked above
+    const MCK::ImageMan::ImageMetaData* const META_DATA
+        = &this->image_meta_data_by_id[ image_id ];
+    width_in_pixels = META_DATA->get_pitch_in_pixels();
+    height_in_pixels = META_DATA->get_height_in_pixels();
+
+    try
+    {
+        this->game_eng->acquire_tex_handle(
+            this->game_eng->calc_tex_id(
+                image_id,
+                local_palette_id
+            ),
+            handle
+        );
+    }
+    catch( std::exception &e )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Cannot acquire texture handle as GameEng " )
+            + std::string( "returned error: " )
+            + e.what()
+#else
+            ""
+#endif
+        ) );
+    }
+}
+
+void MCK::ImageMan::set_tile_map_tile(
+    std::shared_ptr<MCK::GameEngTileMap> tile_map,
+    uint16_t tile,
+    MCK_IMG_ID_TYPE image_id,
+    MCK_PAL_ID_TYPE local_palette_id
+) const
+{
+    // Check IDs and create texture if necessary
+    // (a NULL info pointer instructs 'change_render_info_tex'
+    //  to check/create texture only)
+    try
+    {
+        this->change_render_info_tex(
+            std::shared_ptr<MCK::GameEngRenderInfo>(),
+            image_id,
+            local_palette_id
+        );
+    }
+    catch( std::exception &e )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Cannot set tile map tile as texture " )
+            + std::string( "check/creation failed, error = " )
+            + e.what()
+#else
+            ""
+#endif
+        ) );
+    }
+
+    try
+    {
+        this->game_eng->set_tile_map_tile(
+            tile_map,
+            tile,
+            this->game_eng->calc_tex_id(
+                image_id,
+                local_palette_id
+            )
+        );
+    }
+    catch( std::exception &e )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Cannot set tile map tile as GameEng " )
+            + std::string( "returned error: " )
+            + e.what()
+#else
+            ""
+#endif
+        ) );
+    }
+}
+
+std::shared_ptr<MCK::GameEngRenderBlock> MCK::ImageMan::create_indexed_render_block(
+    MCK_IMG_ID_TYPE image_id,
+    MCK_PAL_ID_TYPE local_palette_id,
+    int x_pos,
+    int y_pos,
+    uint16_t width_in_pixels,
+    uint16_t height_in_pixels,
+    std::shared_ptr<MCK::GameEngRenderBlock> parent_block
+) const
+{
+    if( !this->initialized )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot create indexed render block as Image Manager not yet init."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    // Make sure image ID is valid
+    if( image_id >= this->image_meta_data_by_id.size() )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Cannot create indexed render block as image ID " )
+            + std::to_string( image_id ) 
+            + std::string( " not recognized." )
+#else
+            ""
+#endif
+        ) );
+    }
+
+    // Make sure palette ID is valid
+    if( local_palette_id >= this->palettes_by_id.size() )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Cannot create indexed render block as local palette ID " )
+            + std::to_string( local_palette_id ) 
+            + std::string( " not recognized." )
+#else
+            ""
+#endif
+        ) );
+    }
+
+    // Get pointer to image meta data
+    // (safe because of above check)
+    const MCK::ImageMan::ImageMetaData* const META_DATA
+        = &this->image_meta_data_by_id[ image_id ];
+
+    // Determine (read-only) pointer to pixel data
+    const std::vector<uint8_t>* pixel_data_ptr;
+    if( META_DATA->pixel_data.get() != NULL )
+    {
+        pixel_data_ptr = META_DATA->pixel_data.get();
+    }
+    else if( META_DATA->alt_pixel_data != NULL )
+    {
+        pixel_data_ptr = META_DATA->alt_pixel_data;
+    }
+    else
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Cannot create indexed render block as " )
+            + std::string( "both pixel data pointer and alt " )
+            + std::string( "pixel data pointer are NULL. " )
+#else
+            ""
+#endif
+        ) );
+    }
+
+    // Create texture (does nothing if it already exists)
+    MCK_TEX_ID_TYPE tex_id;
+    uint16_t tex_height_in_pixels = 0;
+    try
+    {
+        this->game_eng->create_indexed_texture(
+            image_id,
+            META_DATA->get_bits_per_pixel(),
+            META_DATA->get_pitch_in_pixels(),
+            *pixel_data_ptr,
+            tex_id,
+            tex_height_in_pixels
+        );
+    }
+    catch( std::exception &e )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Cannot create indexed render block as texture " )
+            + std::string( "creation failed, error = " )
+            + e.what()
+#else
+            ""
+#endif
+        ) );
+    }
+    if( tex_height_in_pixels != META_DATA->get_height_in_pixels() )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Cannot create indexed render block as texture's " )
+            + std::string( "height in pixels (" )
+            + std::to_string( tex_height_in_pixels )
+            + std::string( ") not as expected (" )
+            + std::to_string( META_DATA->get_height_in_pixels() )
+            + std::string( ")." )
+#else
+            ""
+#endif
+        ) );
+    }
+
+    try
+    {
+        return this->game_eng->create_indexed_render_block(
+            tex_id,
+            *this->palettes_by_id[ local_palette_id ],
+            parent_block,
+            MCK::GameEngRenderInfo::Rect(
+                x_pos,
+                y_pos,
+                width_in_pixels,
+                height_in_pixels
+            )
+        );
+    }
+    catch( std::exception &e )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Attempt to create indexed render block has failed, error = " )
+            + e.what()
+#else
+            ""
+#endif
+        ) );
+    }
+}
+
+void MCK::ImageMan::change_indexed_render_block_palette(
+    std::shared_ptr<MCK::GameEngRenderBlock> block,
+    MCK_PAL_ID_TYPE local_palette_id
+) const
+{
+    if( !this->initialized )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot change indexed render block palette as Image Manager not yet init."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    // Make sure palette ID is valid
+    if( local_palette_id >= this->palettes_by_id.size() )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Cannot change indexed render block palette as local palette ID " )
+            + std::to_string( local_palette_id ) 
+            + std::string( " not recognized." )
+#else
+            ""
+#endif
+        ) );
+    }
+
+    try
+    {
+        this->game_eng->change_indexed_render_block_palette(
+            block,
+            *this->palettes_by_id[ local_palette_id ]
+        );
+    }
+    catch( std::exception &e )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Cannot change indexed render block palette as " )
+            + std::string( "GameEng returned error: " )
+            + e.what()
+#else
+            ""
+#endif
+        ) );
+    }
+}
+
+void MCK::ImageMan::prewarm(
+    const std::vector<MCK::ImageMan::ImagePalettePair> &images_and_palettes,
+    PrewarmProgressCallback progress_callback,
+    void* user_data,
+    int num_threads
+) const
+{
+    if( !this->initialized )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            "Cannot prewarm textures as Image Manager not yet init."
+#else
+            ""
+#endif
+        ) );
+    }
+
+    // Check every image and palette ID before
+    // decoding anything, and list the textures
+    // that do not yet exist (once each)
+    MCK::ImageMan::PrewarmWork work;
+    work.game_eng = this->game_eng;
+    std::set<MCK_TEX_ID_TYPE> tex_ids;
+    for( const MCK::ImageMan::ImagePalettePair &PAIR : images_and_palettes )
+    {
+        if( PAIR.first >= this->image_meta_data_by_id.size() )
+        {
+            throw( std::runtime_error(
+#if defined MCK_STD_OUT
+                std::string( "Cannot prewarm textures as image ID " )
+                + std::to_string( PAIR.first ) 
+                + std::string( " not recognized." )
+#else
+                ""
+#endif
+            ) );
+        }
+
+        if( PAIR.second >= this->palettes_by_id.size() )
+        {
+            throw( std::runtime_error(
+#if defined MCK_STD_OUT
+                std::string( "Cannot prewarm textures as local palette ID " )
+                + std::to_string( PAIR.second ) 
+                + std::string( " not recognized." )
+#else
+                ""
+#endif
+            ) );
+        }
+
+        const MCK::ImageMan::ImageMetaData* const META_DATA
+            = &this->image_meta_data_by_id[ PAIR.first ];
+
+        const std::vector<uint8_t>* pixel_data_ptr;
+        if( META_DATA->pixel_data.get() != NULL )
+        {
+            pixel_data_ptr = META_DATA->pixel_data.get();
+        }
+        else if( META_DATA->alt_pixel_data != NULL )
+        {
+            pixel_data_ptr = META_DATA->alt_pixel_data;
+        }
+        else
+        {
+            throw( std::runtime_error(
+#if defined MCK_STD_OUT
+                std::string( "Cannot prewarm textures as both pixel " )
+                + std::string( "data pointer and alt pixel data " )
+                + std::string( "pointer are NULL for image ID " )
+                + std::to_string( PAIR.first )
+#else
+                ""
+#endif
+            ) );
+        }
+
+        const MCK_TEX_ID_TYPE TEX_ID
+            = this->game_eng->calc_tex_id( PAIR.first, PAIR.second );
+        if( this->game_eng->texture_exists( TEX_ID )
+            || !tex_ids.insert( TEX_ID ).second
+        )
+        {
+            continue;
+        }
+
+        work.jobs.push_back( MCK::ImageMan::PrewarmJob() );
+        MCK::ImageMan::PrewarmJob &job = work.jobs.back();
+        job.image_id = PAIR.first;
+        job.local_palette_id = PAIR.second;
+        job.meta_data = META_DATA;
+        job.pixel_data = pixel_data_ptr;
+        job.local_palette = this->palettes_by_id[ PAIR.second ].get();
+        job.height_in_pixels = 0;
+        job.failed = false;
+        SDL_AtomicSet( &job.done, 0 );
+    }
+
+    const size_t NUM_JOBS = work.jobs.size();
+    if( NUM_JOBS == 0 )
+    {
+        if( progress_callback != NULL )
+        {
+            progress_callback( 0, 0, user_data );
+        }
+        return;
+    }
+
+    SDL_AtomicSet( &work.next_job, 0 );
+    work.jobs_done = SDL_CreateSemaphore( 0 );
+    if( work.jobs_done == NULL )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Cannot prewarm textures as failed to " )
+            + std::string( "create semaphore, SDL error: " )
+            + SDL_GetError()
+#else
+            ""
+#endif
+        ) );
+    }
+
+    // Start worker threads, leaving one CPU
+    // for this thread by default
+    if( num_threads <= 0 )
+    {
+        num_threads = std::max( SDL_GetCPUCount() - 1, 1 );
+    }
+    num_threads = int( std::min( size_t( num_threads ), NUM_JOBS ) );
+    std::vector<SDL_Thread*> threads;
+    for( int i = 0; i < num_threads; i++ )
+    {
+        SDL_Thread* const THREAD = SDL_CreateThread(
+            MCK::ImageMan::prewarm_worker,
+            "MCK_prewarm",
+            &work
+        );
+        if( THREAD == NULL )
+        {
+#if defined MCK_STD_OUT && defined MCK_VERBOSE
+            std::cout << "Failed to create prewarm worker thread, "
+                      << "SDL error: " << SDL_GetError() << std::endl;
+#endif
+            break;
+        }
+        threads.push_back( THREAD );
+    }
+
+    // If no threads could be created, decode
+    // on this thread instead
+    if( threads.size() == 0 )
+    {
+        MCK::ImageMan::prewarm_worker( &work );
+    }
+
+    // Create textures in list order, as each
+    // image is decoded (textures can only be
+    // created on this thread)
+    bool failed = false;
+    std::string error;
+    for( size_t i = 0; i < NUM_JOBS; i++ )
+    {
+        MCK::ImageMan::PrewarmJob &job = work.jobs[ i ];
+        while( SDL_AtomicGet( &job.done ) == 0 )
+        {
+            SDL_SemWait( work.jobs_done );
+        }
+
+        if( !job.failed
+            && job.height_in_pixels != job.meta_data->get_height_in_pixels()
+        )
+        {
+            job.failed = true;
+            job.error = std::string( "height in pixels (" )
+                        + std::to_string( job.height_in_pixels )
+                        + std::string( ") not as expected (" )
+                        + std::to_string( job.meta_data->get_height_in_pixels() )
+                        + std::string( ")" );
+        }
+
+        if( !job.failed )
+        {
+            try
+            {
+                MCK_TEX_ID_TYPE tex_id;
+                this->game_eng->create_texture_from_pixels(
+                    job.image_id,
+                    job.local_palette_id,
+                    job.meta_data->get_pitch_in_pixels(),
+                    job.height_in_pixels,
+                    job.pixels,
+                    tex_id,
+                    this->is_cycling_palette( job.local_palette_id )  // Streaming
+                );
+                this->register_cycling_texture(
+                    job.image_id,
+                    job.local_palette_id
+                );
+            }
+            catch( std::exception &e )
+            {
+                job.failed = true;
+                job.error = e.what();
+            }
+        }
+
+        if( job.failed )
+        {
+            failed = true;
+            error = std::string( "image ID " )
+                    + std::to_string( job.image_id )
+                    + std::string( ", palette ID " )
+                    + std::to_string( job.local_palette_id )
+                    + std::string( ", error = " )
+                    + job.error;
+
+            // Stop workers taking any more jobs
+            SDL_AtomicSet( &work.next_job, int( NUM_JOBS ) );
+            break;
+        }
+
+        // Free decoded pixels now texture exists
+        std::vector<uint32_t>().swap( job.pixels );
+
+        if( progress_callback != NULL )
+        {
+            progress_callback( i + 1, NUM_JOBS, user_data );
+        }
+    }
+
+    for( SDL_Thread* thread : threads )
+    {
+        SDL_WaitThread( thread, NULL );
+    }
+    SDL_DestroySemaphore( work.jobs_done );
+
+    if( failed )
+    {
+        throw( std::runtime_error(
+#if defined MCK_STD_OUT
+            std::string( "Failed to prewarm texture for " )
+            + error
+#else
+            ""
+#endif
+        ) );
+    }
+}
+
+int MCK::ImageMan::prewarm_worker( void* data )
+{
+    MCK::ImageMan::PrewarmWork* const WORK
+        = static_cast<MCK::ImageMan::PrewarmWork*>( data );
+    const int NUM_JOBS = int( WORK->jobs.size() );
+
+    while( true )
+    {
+        const int JOB_INDEX = SDL_AtomicAdd( &WORK->next_job, 1 );
+        if( JOB_INDEX >= NUM_JOBS )
+        {
+            break;
+        }
+
+        MCK::ImageMan::PrewarmJob &job = WORK->jobs[ JOB_INDEX ];
+        try
+        {
+            WORK->game_eng->decode_image(
+                job.meta_data->get_bits_per_pixel(),
+                job.meta_data->get_pitch_in_pixels(),
+                *job.pixel_data,
+                *job.local_palette,
+                job.pixels,
+                job.height_in_pixels
+            );
+        }
+        catch( std::exception &e )
+        {
+            job.failed = true;
+            job.error = e.what();
+        }
+
+        SDL_AtomicSet( &job.done, 1 );
+        SDL_SemPost( WORK->jobs_done );
+    }
+
+    return 0;
+}
+
 uint8_t MCK::ImageMan::create_alt_ascii_set(
     const std::vector<MCK_IMG_ID_TYPE> &ascii_to_image_id_mapping
 )
@@ -0,0 +1,469 @@
+///////////////////////////////////////////////
+//  --------------------------------------
+//  ---MUCKY VISION 3 ( BASIC ENGINE ) ---
+//  --------------------------------------
+//
+//  GameEngBenchmark.cpp
+//
+//  Benchmark for GameEng class, timing
+//  'render_all' over a large number of
+//  render instances spread across
+//  multiple (nested) render blocks
+//
+//  Run with '--headless' to render without
+//  a window (or vsync), using SDL2's
+//  software renderer
+//
+//  Copyright (c) Muckytaters 2023
+//
+//  This program is free software: you can
+//  redistribute it and/or modify it under
+//  the terms of the GNU General Public License
+//  as published by the Free Software Foundation,
+//  either version 3 of the License, or (at your
+//  option) any later version.
+//
+//  This program is distributed in the hope it
+//  will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY
+//  or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU
+//  General Public License along with this
+//  program. If not, see http://www.gnu.org/license
+////////////////////////////////////////////
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include "GameEng.h"
+
+///////////////////////////////////////////
+// BENCHMARK PARAMETERS
+// Made global for convenience,
+// as this is only a short benchmark.
+//
+const int WINDOW_WIDTH_IN_PIXELS = 640;
+const int WINDOW_HEIGHT_IN_PIXELS = 480;
+const int NUM_INSTANCES = 20000;
+const int NUM_SUB_BLOCKS = 100;
+const int NUM_FRAMES = 120;
+const int INSTANCE_SIZE_IN_PIXELS = 2;
+const int TILE_MAP_SIZE_IN_CELLS = 1000;
+const int CELL_SIZE_IN_PIXELS = 8;
+
+
+/////////////////////////////////////////////////////////
+// Utility function to time 'render_all' over NUM_FRAMES
+// frames, returning mean time per frame in microseconds.
+// Only 'render_all' is timed, so that vsync (in 'show')
+// does not affect the result. If 'moving_block' is
+// not NULL, it is moved every frame.
+double time_render_all(
+    MCK::GameEng &game_eng,
+    std::shared_ptr<MCK::GameEngRenderBlock> block,
+    int16_t hoz_offset,
+    int16_t vert_offset,
+    MCK::GameEngRenderBlock* moving_block = NULL
+)
+{
+    uint64_t total_counts = 0;
+
+    for( int frame = 0; frame < NUM_FRAMES; frame++ )
+    {
+        try
+        {
+            game_eng.clear();
+
+            if( moving_block != NULL )
+            {
+                moving_block->hoz_offset = frame % 2;
+            }
+
+            const uint64_t START_COUNT = SDL_GetPerformanceCounter();
+            game_eng.render_all( block, hoz_offset, vert_offset );
+            total_counts += SDL_GetPerformanceCounter() - START_COUNT;
+
+            game_eng.show();
+        }
+        catch( std::exception &e )
+        {
+            throw( std::runtime_error(
+                std::string( "Render sequence failed, error: ")
+                + e.what() ) );
+        }
+    }
+
+    return double( total_counts ) * 1000000.0
+               / double( SDL_GetPerformanceFrequency() )
+                   / double( NUM_FRAMES );
+}
+
+
+/////////////////////////////////////////////////////////
+// Utility function to print benchmark result
+void report(
+    const std::string &description,
+    double microseconds_per_frame,
+    int num_instances
+)
+{
+    std::cout << std::left << std::setw( 40 ) << description
+              << std::right << std::fixed << std::setprecision( 1 )
+              << std::setw( 10 ) << microseconds_per_frame
+              << " us/frame"
+              << std::setw( 10 )
+              << microseconds_per_frame * 1000.0 / double( num_instances )
+              << " ns/instance"
+              << std::endl;
+}
+
+
+/////////////////////////////////////////////////////////
+// TOP LEVEL ENTRY POINT OF THE BENCHMARK APPLICATION
+int main( int argc, char** argv )
+{
+    const bool HEADLESS
+        = argc > 1 && std::string( argv[ 1 ] ) == "--headless";
+
+    //////////////////////////////////////////////
+    // INITIALIZE SDL, CREATE WINDOW & RENDERER
+    MCK::GameEng &game_eng = MCK::GameEng::get_singleton();
+    try
+    {
+        if( HEADLESS )
+        {
+            game_eng.init_headless(
+                WINDOW_WIDTH_IN_PIXELS,
+                WINDOW_HEIGHT_IN_PIXELS
+            );
+        }
+        else
+        {
+            game_eng.init(
+                "GameEngBenchmark",  // Window name
+                0,  // Window x pos
+                0,  // Window y pos
+                WINDOW_WIDTH_IN_PIXELS,
+                WINDOW_HEIGHT_IN_PIXELS
+            );
+        }
+    }
+    catch( std::exception &e )
+    {
+        throw( std::runtime_error(
+            std::string( "Failed to initialize SDL, error: ")
+            + e.what() ) );
+    }
+
+    game_eng.set_clearing_color( MCK::COL_BLACK );
+
+
+    //////////////////////////////////////////////
+    // CREATE RENDER BLOCKS
+    // Half the sub-blocks are attached to the prime
+    // render block, the other half are nested inside
+    // these, so that recursion is exercised.
+    std::vector< std::shared_ptr<MCK::GameEngRenderBlock> > blocks;
+    for( int i = 0; i < NUM_SUB_BLOCKS; i++ )
+    {
+        try
+        {
+            blocks.push_back(
+                game_eng.create_empty_render_block(
+                    i < NUM_SUB_BLOCKS / 2 ?
+                        game_eng.get_prime_render_block() :
+                        blocks[ i - NUM_SUB_BLOCKS / 2 ],
+                    MCK::DEFAULT_Z_VALUE + i
+                )
+            );
+        }
+        catch( std::exception &e )
+        {
+            throw( std::runtime_error(
+                std::string( "Failed to create render block, error: ")
+                + e.what() ) );
+        }
+    }
+
+
+    //////////////////////////////////////////////
+    // CREATE RENDER INSTANCES
+    // Use a fixed seed, so results are comparable
+    // between runs.
+    srand( 1 );
+    for( int i = 0; i < NUM_INSTANCES; i++ )
+    {
+        try
+        {
+            game_eng.create_blank_tex_render_info(
+                // One opaque colo(u)r (i.e. texture) per block,
+                // as is typical of tile maps and text
+                MCK::COL_WHITE
+                    + ( i % NUM_SUB_BLOCKS )
+                        % ( MCK::TOTAL_CORE_COLORS - MCK::COL_WHITE ),
+                blocks[ i % NUM_SUB_BLOCKS ],
+                MCK::GameEngRenderInfo::Rect(
+                    rand() % ( WINDOW_WIDTH_IN_PIXELS
+                                - INSTANCE_SIZE_IN_PIXELS ),
+                    rand() % ( WINDOW_HEIGHT_IN_PIXELS
+                                - INSTANCE_SIZE_IN_PIXELS ),
+                    INSTANCE_SIZE_IN_PIXELS,
+                    INSTANCE_SIZE_IN_PIXELS
+                ),
+                MCK::DEFAULT_Z_VALUE + rand() % 256
+            );
+        }
+        catch( std::exception &e )
+        {
+            throw( std::runtime_error(
+                std::string( "Failed to create render info, error: ")
+                + e.what() ) );
+        }
+    }
+
+    std::cout << "Benchmarking render_all with "
+              << NUM_INSTANCES << " instances in "
+              << NUM_SUB_BLOCKS << " blocks, over "
+              << NUM_FRAMES << " frames" << std::endl;
+
+
+    //////////////////////////////////////////////
+    // RECURSIVE RENDER
+    game_eng.set_compiled_render_list( false );
+    report(
+        "Recursive render, no offset",
+        time_render_all( game_eng, game_eng.get_prime_render_block(), 0, 0 ),
+        NUM_INSTANCES
+    );
+    report(
+        "Recursive render, with offset",
+        time_render_all( game_eng, game_eng.get_prime_render_block(), 1, 1 ),
+        NUM_INSTANCES
+    );
+    report(
+        "Recursive render, one block moving",
+        time_render_all(
+            game_eng,
+            game_eng.get_prime_render_block(),
+            0,
+            0,
+            blocks[ 0 ].get()
+        ),
+        NUM_INSTANCES
+    );
+
+
+    //////////////////////////////////////////////
+    // COMPILED RENDER
+    game_eng.set_compiled_render_list( true );
+    report(
+        "Compiled render, no offset",
+        time_render_all( game_eng, game_eng.get_prime_render_block(), 0, 0 ),
+        NUM_INSTANCES
+    );
+    report(
+        "Compiled render, with offset",
+        time_render_all( game_eng, game_eng.get_prime_render_block(), 1, 1 ),
+        NUM_INSTANCES
+    );
+
+    // Only the draw commands of the moving block
+    // (and its sub-block) are regenerated
+    report(
+        "Compiled render, one block moving",
+        time_render_all(
+            game_eng,
+            game_eng.get_prime_render_block(),
+            0,
+            0,
+            blocks[ 0 ].get()
+        ),
+        NUM_INSTANCES
+    );
+    blocks[ 0 ]->hoz_offset = 0;
+
+
+    //////////////////////////////////////////////
+    // BATCHED RENDER
+    game_eng.set_batched_render( true );
+    report(
+        "Batched render, no offset",
+        time_render_all( game_eng, game_eng.get_prime_render_block(), 0, 0 ),
+        NUM_INSTANCES
+    );
+    std::cout << "Draw calls per frame (batched): "
+              << game_eng.get_render_list().get_num_draw_calls()
+              << std::endl;
+
+
+
+    //////////////////////////////////////////////
+    // CULLING
+    // Offset everything by half the window size,
+    // so only a quarter of instances are on screen
+    game_eng.set_culling( false );
+    report(
+        "Batched render, 3/4 off screen, no cull",
+        time_render_all(
+            game_eng,
+            game_eng.get_prime_render_block(),
+            WINDOW_WIDTH_IN_PIXELS / 2,
+            WINDOW_HEIGHT_IN_PIXELS / 2
+        ),
+        NUM_INSTANCES
+    );
+    game_eng.set_culling( true );
+    report(
+        "Batched render, 3/4 off screen, culled",
+        time_render_all(
+            game_eng,
+            game_eng.get_prime_render_block(),
+            WINDOW_WIDTH_IN_PIXELS / 2,
+            WINDOW_HEIGHT_IN_PIXELS / 2
+        ),
+        NUM_INSTANCES
+    );
+
+
+    //////////////////////////////////////////////
+    // RETAINED FRAME
+    // Nothing moves, so after the first frame
+    // nothing should be redrawn
+    game_eng.set_retained_frame( true );
+    report(
+        "Retained frame, static scene",
+        time_render_all( game_eng, game_eng.get_prime_render_block(), 0, 0 ),
+        NUM_INSTANCES
+    );
+    std::cout << "Draw calls per frame (retained): "
+              << game_eng.get_render_list().get_num_draw_calls()
+              << std::endl;
+
+
+    //////////////////////////////////////////////
+    // UNCAPPED FRAME RATE
+    // Without vsync, whole frames (including 'show')
+    // can be timed
+    if( HEADLESS )
+    {
+        game_eng.set_retained_frame( false );
+        const uint64_t START_COUNT = SDL_GetPerformanceCounter();
+        for( int frame = 0; frame < NUM_FRAMES; frame++ )
+        {
+            game_eng.clear();
+            game_eng.render_all( game_eng.get_prime_render_block(), 0, 0 );
+            game_eng.show();
+        }
+        const double SECONDS
+            = double( SDL_GetPerformanceCounter() - START_COUNT )
+                  / double( SDL_GetPerformanceFrequency() );
+        std::cout << "Headless frame rate (batched, uncapped): "
+                  << std::fixed << std::setprecision( 1 )
+                  << ( SECONDS > 0.0 ? double( NUM_FRAMES ) / SECONDS : 0.0 )
+                  << " fps" << std::endl;
+    }
+
+
+    //////////////////////////////////////////////
+    // TILE MAP
+    // A large scrolling world (one million cells,
+    // half of them empty), of which only the cells
+    // within the window are drawn
+    std::shared_ptr<MCK::GameEngRenderBlock> tile_map_block;
+    std::shared_ptr<MCK::GameEngTileMap> tile_map;
+    try
+    {
+        // Checkerboard texture (1 bit per pixel, 8x8 pixels)
+        const std::vector<uint8_t> PIXEL_DATA =
+            { 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55 };
+        const std::vector<uint8_t> LOCAL_PALETTE =
+            { MCK::COL_BLACK, MCK::COL_WHITE };
+        MCK_TEX_ID_TYPE tex_id;
+        uint16_t height_in_pixels;
+        game_eng.create_texture(
+            1,  // Image ID
+            1,  // Palette ID
+            1,  // Bits per pixel
+            8,  // Pitch in pixels
+            PIXEL_DATA,
+            LOCAL_PALETTE,
+            tex_id,
+            height_in_pixels
+        );
+
+        // Block has no parent, so is rendered on its own
+        tile_map_block = game_eng.create_empty_render_block(
+            std::shared_ptr<MCK::GameEngRenderBlock>()
+        );
+        tile_map = game_eng.create_tile_map(
+            tile_map_block,
+            0,  // x pos
+            0,  // y pos
+            TILE_MAP_SIZE_IN_CELLS,
+            TILE_MAP_SIZE_IN_CELLS,
+            CELL_SIZE_IN_PIXELS,
+            CELL_SIZE_IN_PIXELS
+        );
+        game_eng.set_tile_map_tile( tile_map, 0, tex_id );
+        for( int row = 0; row < TILE_MAP_SIZE_IN_CELLS; row++ )
+        {
+            for( int col = 0; col < TILE_MAP_SIZE_IN_CELLS; col++ )
+            {
+                if( rand() % 2 )
+                {
+                    tile_map->set_cell( col, row, 0 );
+                }
+            }
+        }
+        tile_map->set_scroll(
+            TILE_MAP_SIZE_IN_CELLS * CELL_SIZE_IN_PIXELS / 2,
+            TILE_MAP_SIZE_IN_CELLS * CELL_SIZE_IN_PIXELS / 2
+        );
+    }
+    catch( std::exception &e )
+    {
+        throw( std::runtime_error(
+            std::string( "Failed to create tile map, error: ")
+            + e.what() ) );
+    }
+
+    const int NUM_VISIBLE_CELLS
+        = ( WINDOW_WIDTH_IN_PIXELS / CELL_SIZE_IN_PIXELS )
+            * ( WINDOW_HEIGHT_IN_PIXELS / CELL_SIZE_IN_PIXELS );
+    std::cout << "Tile map of "
+              << TILE_MAP_SIZE_IN_CELLS * TILE_MAP_SIZE_IN_CELLS
+              << " cells (" << NUM_VISIBLE_CELLS << " in window), "
+              << "per cell figures are per cell in window"
+              << std::endl;
+    game_eng.set_retained_frame( false );
+    game_eng.set_compiled_render_list( false );
+    report(
+        "Tile map, recursive render",
+        time_render_all( game_eng, tile_map_block, 0, 0 ),
+        NUM_VISIBLE_CELLS
+    );
+    game_eng.set_compiled_render_list( true );
+    report(
+        "Tile map, batched render",
+        time_render_all( game_eng, tile_map_block, 0, 0 ),
+        NUM_VISIBLE_CELLS
+    );
+
+#if defined MCK_PROFILE
+    //////////////////////////////////////////////
+    // PROFILE
+    // Save most recent frames, for viewing
+    // in chrome://tracing
+    MCK::GameEngProfiler::get_singleton().save_chrome_trace(
+        "GameEngBenchmark_profile.json"
+    );
+    std::cout << "Profile saved to GameEngBenchmark_profile.json"
+              << std::endl;
+#endif
+
+    // Note: SDL is closed down when 'game_eng'
+    // goes out of scope
+}
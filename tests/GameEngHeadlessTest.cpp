@@ -0,0 +1,612 @@
+///////////////////////////////////////////////
+//  --------------------------------------
+//  ---MUCKY VISION 3 ( BASIC ENGINE ) ---
+//  --------------------------------------
+//
+//  GameEngHeadlessTest.cpp
+//
+//  Golden image test for GameEng class,
+//  rendering without a window, using
+//  SDL2's software renderer
+//
+//  A fixed scene is rendered with each
+//  render mode (recursive, compiled, batched
+//  and retained frame) and compared, pixel
+//  by pixel, with a golden image (BMP file).
+//  If the golden image does not exist, it is
+//  created from the first render, so should
+//  be checked by eye before being relied upon.
+//
+//  Usage: GameEngHeadlessTest [golden image file]
+//
+//  Returns zero if all renders match.
+//
+//  Copyright (c) Muckytaters 2023
+//
+//  This program is free software: you can
+//  redistribute it and/or modify it under
+//  the terms of the GNU General Public License
+//  as published by the Free Software Foundation,
+//  either version 3 of the License, or (at your
+//  option) any later version.
+//
+//  This program is distributed in the hope it
+//  will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY
+//  or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU
+//  General Public License along with this
+//  program. If not, see http://www.gnu.org/license
+////////////////////////////////////////////
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "GameEng.h"
+
+///////////////////////////////////////////
+// TEST PARAMETERS
+// Made global for convenience,
+// as this is only a short test.
+//
+const int FRAME_WIDTH_IN_PIXELS = 320;
+const int FRAME_HEIGHT_IN_PIXELS = 240;
+const int IMAGE_SCALE = 4;
+const char* const DEFAULT_GOLDEN_FILE = "GameEngHeadlessTest_golden.bmp";
+
+
+/////////////////////////////////////////////////////////
+// Utility function to render and show a single frame,
+// then read back its pixels
+void render_frame(
+    MCK::GameEng &game_eng,
+    std::vector<uint32_t> &pixels
+)
+{
+    try
+    {
+        game_eng.clear();
+        game_eng.render_all( game_eng.get_prime_render_block(), 0, 0 );
+        game_eng.show();
+        game_eng.read_frame_pixels( pixels );
+    }
+    catch( std::exception &e )
+    {
+        throw( std::runtime_error(
+            std::string( "Render sequence failed, error: ")
+            + e.what() ) );
+    }
+}
+
+
+/////////////////////////////////////////////////////////
+// Utility function to compare pixels with golden image,
+// returning number of pixels that differ
+size_t compare_with_golden(
+    const std::vector<uint32_t> &pixels,
+    const std::vector<uint32_t> &golden_pixels
+)
+{
+    if( pixels.size() != golden_pixels.size() )
+    {
+        return pixels.size();
+    }
+
+    size_t num_diffs = 0;
+    for( size_t i = 0; i < pixels.size(); i++ )
+    {
+        // Ignore alpha, as BMP files may not hold it
+        if( ( pixels[ i ] & 0x00FFFFFF )
+                != ( golden_pixels[ i ] & 0x00FFFFFF )
+        )
+        {
+            num_diffs++;
+        }
+    }
+
+    return num_diffs;
+}
+
+
+/////////////////////////////////////////////////////////
+// Utility function to load golden image, returning
+// false if file does not exist
+bool load_golden(
+    const std::string &file_name,
+    std::vector<uint32_t> &golden_pixels
+)
+{
+    SDL_Surface* const LOADED = SDL_LoadBMP( file_name.c_str() );
+    if( LOADED == NULL )
+    {
+        return false;
+    }
+
+    SDL_Surface* const CONVERTED = SDL_ConvertSurfaceFormat(
+        LOADED,
+        SDL_PIXELFORMAT_ARGB8888,
+        0  // Flags (unused)
+    );
+    SDL_FreeSurface( LOADED );
+    if( CONVERTED == NULL )
+    {
+        throw( std::runtime_error(
+            std::string( "Failed to convert golden image, SDL error: " )
+            + SDL_GetError() ) );
+    }
+
+    golden_pixels.clear();
+    for( int y = 0; y < CONVERTED->h; y++ )
+    {
+        const uint32_t* const ROW = reinterpret_cast<const uint32_t*>(
+            static_cast<const uint8_t*>( CONVERTED->pixels )
+                + y * CONVERTED->pitch
+        );
+        golden_pixels.insert( golden_pixels.end(), ROW, ROW + CONVERTED->w );
+    }
+    SDL_FreeSurface( CONVERTED );
+
+    return true;
+}
+
+
+/////////////////////////////////////////////////////////
+// TOP LEVEL ENTRY POINT OF THE TEST APPLICATION
+int main( int argc, char** argv )
+{
+    const std::string GOLDEN_FILE
+        = argc > 1 ? std::string( argv[ 1 ] ) : DEFAULT_GOLDEN_FILE;
+
+    //////////////////////////////////////////////
+    // INITIALIZE SDL & RENDERER (NO WINDOW)
+    MCK::GameEng &game_eng = MCK::GameEng::get_singleton();
+    try
+    {
+        game_eng.init_headless(
+            FRAME_WIDTH_IN_PIXELS,
+            FRAME_HEIGHT_IN_PIXELS
+        );
+    }
+    catch( std::exception &e )
+    {
+        throw( std::runtime_error(
+            std::string( "Failed to initialize SDL, error: ")
+            + e.what() ) );
+    }
+
+    game_eng.set_clearing_color( MCK::COL_DARK_BLUE );
+
+
+    //////////////////////////////////////////////
+    // CREATE TEXTURE
+    // A letter 'F', which looks different
+    // under every rotation and flip
+    // (2 bits per pixel, 8x8 pixels)
+    MCK_TEX_ID_TYPE tex_id;
+    try
+    {
+        const std::vector<uint8_t> PIXEL_DATA =
+        {
+            0x55, 0x50,  // 1 1 1 1 1 1 0 0
+            0x6A, 0x90,  // 1 2 2 2 2 1 0 0
+            0x60, 0x00,  // 1 2 0 0 0 0 0 0
+            0x55, 0x00,  // 1 1 1 1 0 0 0 0
+            0x69, 0x00,  // 1 2 2 1 0 0 0 0
+            0x60, 0x00,  // 1 2 0 0 0 0 0 0
+            0x60, 0x03,  // 1 2 0 0 0 0 0 3
+            0x50, 0x0F   // 1 1 0 0 0 0 3 3
+        };
+        const std::vector<uint8_t> LOCAL_PALETTE =
+        {
+            MCK::COL_TRANSPARENT,
+            MCK::COL_WHITE,
+            MCK::COL_RED,
+            MCK::COL_YELLOW
+        };
+        uint16_t height_in_pixels;
+        game_eng.create_texture(
+            1,  // Image ID
+            1,  // Palette ID
+            2,  // Bits per pixel
+            8,  // Pitch in pixels
+            PIXEL_DATA,
+            LOCAL_PALETTE,
+            tex_id,
+            height_in_pixels
+        );
+    }
+    catch( std::exception &e )
+    {
+        throw( std::runtime_error(
+            std::string( "Failed to create texture, error: ")
+            + e.what() ) );
+    }
+
+
+    //////////////////////////////////////////////
+    // CREATE SCENE
+    // Backdrop in one block, with images in an
+    // offset sub-block, covering every rotation
+    // and flip, plus images partly off screen
+    // and clipped images
+    try
+    {
+        std::shared_ptr<MCK::GameEngRenderBlock> backdrop_block
+            = game_eng.create_empty_render_block(
+                game_eng.get_prime_render_block(),
+                MCK::DEFAULT_Z_VALUE
+            );
+        std::shared_ptr<MCK::GameEngRenderBlock> image_block
+            = game_eng.create_empty_render_block(
+                game_eng.get_prime_render_block(),
+                MCK::DEFAULT_Z_VALUE + 1
+            );
+        image_block->hoz_offset = 16;
+        image_block->vert_offset = 8;
+
+        for( int i = 0; i < 8; i++ )
+        {
+            game_eng.create_blank_tex_render_info(
+                MCK::COL_WHITE + i,
+                backdrop_block,
+                MCK::GameEngRenderInfo::Rect(
+                    i * FRAME_WIDTH_IN_PIXELS / 8,
+                    FRAME_HEIGHT_IN_PIXELS / 2,
+                    FRAME_WIDTH_IN_PIXELS / 8,
+                    FRAME_HEIGHT_IN_PIXELS / 2
+                )
+            );
+        }
+
+        const int SIZE = 8 * IMAGE_SCALE;
+        for( int rotation = 0; rotation < 4; rotation++ )
+        {
+            for( int flip = 0; flip < 4; flip++ )
+            {
+                game_eng.create_render_info(
+                    tex_id,
+                    image_block,
+                    MCK::GameEngRenderInfo::Rect(
+                        flip * ( SIZE + 8 ),
+                        rotation * ( SIZE + 8 ),
+                        SIZE,
+                        SIZE
+                    ),
+                    false,  // No clip
+                    MCK::GameEngRenderInfo::Rect(),
+                    rotation,
+                    flip & 0x01,  // Flip x
+                    flip & 0x02  // Flip y
+                );
+            }
+        }
+
+        // Clipped (bottom right quarter of image)
+        game_eng.create_render_info(
+            tex_id,
+            image_block,
+            MCK::GameEngRenderInfo::Rect( 4 * ( SIZE + 8 ), 0, SIZE, SIZE ),
+            true,  // Clip
+            MCK::GameEngRenderInfo::Rect( 4, 4, 4, 4 )
+        );
+
+        // Partly off screen
+        game_eng.create_render_info(
+            tex_id,
+            game_eng.get_prime_render_block(),
+            MCK::GameEngRenderInfo::Rect(
+                FRAME_WIDTH_IN_PIXELS - SIZE / 2,
+                FRAME_HEIGHT_IN_PIXELS - SIZE / 2,
+                SIZE,
+                SIZE
+            ),
+            false,  // No clip
+            MCK::GameEngRenderInfo::Rect(),
+            0,  // No rotation
+            false,  // No flip x
+            false,  // No flip y
+            MCK::DEFAULT_Z_VALUE + 2
+        );
+    }
+    catch( std::exception &e )
+    {
+        throw( std::runtime_error(
+            std::string( "Failed to create scene, error: ")
+            + e.what() ) );
+    }
+
+
+    //////////////////////////////////////////////
+    // LOAD (OR CREATE) GOLDEN IMAGE
+    std::vector<uint32_t> golden_pixels;
+    std::vector<uint32_t> pixels;
+    if( !load_golden( GOLDEN_FILE, golden_pixels ) )
+    {
+        game_eng.set_compiled_render_list( false );
+        render_frame( game_eng, golden_pixels );
+        if( SDL_SaveBMP(
+                const_cast<SDL_Surface*>( game_eng.get_frame_surface() ),
+                GOLDEN_FILE.c_str()
+            ) != 0
+        )
+        {
+            throw( std::runtime_error(
+                std::string( "Failed to save golden image, SDL error: " )
+                + SDL_GetError() ) );
+        }
+        std::cout << "Golden image " << GOLDEN_FILE
+                  << " created, please check it by eye." << std::endl;
+    }
+
+
+    //////////////////////////////////////////////
+    // RENDER WITH EACH MODE, AND COMPARE
+    struct Mode
+    {
+        const char* name;
+        bool compiled;
+        bool batched;
+        bool retained;
+        bool sub_pixel;
+    };
+    // Note: With no fractions of a pixel in any block
+    //       offset, sub-pixel rendering should make
+    //       no difference
+    const std::vector<Mode> MODES =
+    {
+        { "Recursive", false, false, false, false },
+        { "Compiled", true, false, false, false },
+        { "Batched", true, true, false, false },
+        { "Retained frame", true, true, true, false },
+        { "Sub-pixel", true, false, false, true },
+        { "Sub-pixel batched", true, true, false, true },
+        { "Sub-pixel retained frame", true, true, true, true }
+    };
+
+    // Culling (off by default, so off for golden image)
+    // should make no difference either
+    game_eng.set_culling( true );
+
+    int num_failures = 0;
+    for( const Mode &mode : MODES )
+    {
+        game_eng.set_compiled_render_list( mode.compiled );
+        game_eng.set_batched_render( mode.batched );
+        game_eng.set_retained_frame( mode.retained );
+        game_eng.set_sub_pixel_render( mode.sub_pixel );
+
+        // Render twice, so retained frame is
+        // checked after an idle frame too
+        for( int frame = 0; frame < 2; frame++ )
+        {
+            render_frame( game_eng, pixels );
+            const size_t NUM_DIFFS
+                = compare_with_golden( pixels, golden_pixels );
+            std::cout << mode.name << " render, frame " << frame
+                      << ": " << ( NUM_DIFFS == 0 ? "PASS" : "FAIL" );
+            if( NUM_DIFFS > 0 )
+            {
+                std::cout << " (" << NUM_DIFFS << " pixels differ)";
+                num_failures++;
+            }
+            std::cout << std::endl;
+        }
+
+        // Nothing changed during second frame, so
+        // retained frame should not have been redrawn
+        if( mode.retained )
+        {
+            const size_t NUM_DRAW_CALLS
+                = game_eng.get_render_list().get_num_draw_calls();
+            std::cout << mode.name << " render, idle frame draw calls: "
+                      << ( NUM_DRAW_CALLS == 0 ? "PASS" : "FAIL" );
+            if( NUM_DRAW_CALLS > 0 )
+            {
+                std::cout << " (" << NUM_DRAW_CALLS << " draw calls)";
+                num_failures++;
+            }
+            std::cout << std::endl;
+        }
+    }
+
+
+
+    //////////////////////////////////////////////
+    // TILE MAP
+    // A scrolling tile map (partly off screen, with
+    // empty cells and a tile without texture) should
+    // match the same cells drawn as render infos,
+    // in every mode
+    const int MAP_WIDTH_IN_CELLS = 24;
+    const int MAP_HEIGHT_IN_CELLS = 10;
+    const int CELL_SIZE = 16;
+    std::shared_ptr<MCK::GameEngRenderBlock> tile_map_block;
+    std::shared_ptr<MCK::GameEngRenderBlock> tile_info_block;
+    std::shared_ptr<MCK::GameEngTileMap> tile_map;
+    try
+    {
+        tile_map_block = game_eng.create_empty_render_block(
+            game_eng.get_prime_render_block(),
+            MCK::DEFAULT_Z_VALUE + 3
+        );
+        tile_info_block = game_eng.create_empty_render_block(
+            game_eng.get_prime_render_block(),
+            MCK::DEFAULT_Z_VALUE + 3
+        );
+        tile_map = game_eng.create_tile_map(
+            tile_map_block,
+            8,  // x pos
+            4,  // y pos
+            MAP_WIDTH_IN_CELLS,
+            MAP_HEIGHT_IN_CELLS,
+            CELL_SIZE,
+            CELL_SIZE
+        );
+        game_eng.set_tile_map_tile( tile_map, 0, tex_id );
+        // (Tile 1 is left without a texture)
+
+        for( int row = 0; row < MAP_HEIGHT_IN_CELLS; row++ )
+        {
+            for( int col = 0; col < MAP_WIDTH_IN_CELLS; col++ )
+            {
+                switch( ( col + row * 2 ) % 3 )
+                {
+                    case 0:
+                        tile_map->set_cell( col, row, 0 );
+                        game_eng.create_render_info(
+                            tex_id,
+                            tile_info_block,
+                            MCK::GameEngRenderInfo::Rect(
+                                8 + col * CELL_SIZE,
+                                4 + row * CELL_SIZE,
+                                CELL_SIZE,
+                                CELL_SIZE
+                            )
+                        );
+                        break;
+                    case 1:
+                        tile_map->set_cell( col, row, 1 );
+                        break;
+                    default:
+                        break;  // Left empty
+                }
+            }
+        }
+    }
+    catch( std::exception &e )
+    {
+        throw( std::runtime_error(
+            std::string( "Failed to create tile map, error: ")
+            + e.what() ) );
+    }
+
+    // Render infos give expected pixels for each scroll offset
+    const int NUM_SCROLLS = 4;
+    const int SCROLL_X[ NUM_SCROLLS ] = { -20, 0, 37, 80 };
+    const int SCROLL_Y[ NUM_SCROLLS ] = { -10, 0, 21, 40 };
+    std::vector< std::vector<uint32_t> > expected_pixels( NUM_SCROLLS );
+    game_eng.set_compiled_render_list( false );
+    game_eng.set_batched_render( false );
+    game_eng.set_retained_frame( false );
+    tile_map_block->active = false;
+    for( int i = 0; i < NUM_SCROLLS; i++ )
+    {
+        tile_info_block->hoz_offset = -SCROLL_X[ i ];
+        tile_info_block->vert_offset = -SCROLL_Y[ i ];
+        render_frame( game_eng, expected_pixels[ i ] );
+    }
+    tile_map_block->active = true;
+    tile_info_block->active = false;
+
+    for( const Mode &mode : MODES )
+    {
+        game_eng.set_compiled_render_list( mode.compiled );
+        game_eng.set_batched_render( mode.batched );
+        game_eng.set_retained_frame( mode.retained );
+        game_eng.set_sub_pixel_render( mode.sub_pixel );
+
+        for( int i = 0; i < NUM_SCROLLS; i++ )
+        {
+            tile_map->set_scroll( SCROLL_X[ i ], SCROLL_Y[ i ] );
+            render_frame( game_eng, pixels );
+            const size_t NUM_DIFFS
+                = compare_with_golden( pixels, expected_pixels[ i ] );
+            std::cout << "Tile map, " << mode.name << " render, scroll "
+                      << i << ": " << ( NUM_DIFFS == 0 ? "PASS" : "FAIL" );
+            if( NUM_DIFFS > 0 )
+            {
+                std::cout << " (" << NUM_DIFFS << " pixels differ)";
+                num_failures++;
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    //////////////////////////////////////////////
+    // INTEGER REPOSITIONING AFTER SUB-PIXEL POSITION
+    // Integer setters clear any fraction of a pixel,
+    // whereas 'adj_pos' keeps it
+    {
+        std::shared_ptr<MCK::GameEngRenderBlock> block;
+        try
+        {
+            block = game_eng.create_empty_render_block(
+                game_eng.get_prime_render_block()
+            );
+        }
+        catch( std::exception &e )
+        {
+            throw( std::runtime_error(
+                std::string( "Failed to create render block, error: ")
+                + e.what() ) );
+        }
+
+        block->set_pos_f( 10.5f, 3.25f );
+        block->set_pos( 20, 0 );
+        bool pass = block->get_x_f() == 20.0f && block->get_y_f() == 0.0f;
+
+        block->set_pos_f( 10.5f, 3.25f );
+        block->set_x( 7 );
+        pass = pass && block->get_x_f() == 7.0f && block->get_y_f() == 3.25f;
+        block->set_y( 5 );
+        pass = pass && block->get_x_f() == 7.0f && block->get_y_f() == 5.0f;
+
+        block->set_pos_f( 10.5f, 3.25f );
+        block->adj_pos( 2, -1 );
+        pass = pass && block->get_x_f() == 12.5f && block->get_y_f() == 2.25f;
+
+        std::cout << "Integer repositioning after set_pos_f: "
+                  << ( pass ? "PASS" : "FAIL" ) << std::endl;
+        if( !pass )
+        {
+            num_failures++;
+        }
+
+        MCK::GameEng::remove_render_instance(
+            block,
+            game_eng.get_prime_render_block()
+        );
+    }
+
+    //////////////////////////////////////////////
+    // DESTROYED TOP-LEVEL BLOCK
+    // Compiled render list should be discarded when
+    // the block it was compiled from is destroyed
+    {
+        game_eng.set_compiled_render_list( true );
+        std::shared_ptr<MCK::GameEngRenderBlock> block;
+        try
+        {
+            block = game_eng.create_empty_render_block(
+                std::shared_ptr<MCK::GameEngRenderBlock>()
+            );
+            game_eng.create_empty_render_block( block );
+            game_eng.render_all( block );
+        }
+        catch( std::exception &e )
+        {
+            throw( std::runtime_error(
+                std::string( "Failed to render top-level block, error: ")
+                + e.what() ) );
+        }
+
+        bool pass = game_eng.get_render_list().is_compiled();
+        block.reset();
+        pass = pass && !game_eng.get_render_list().is_compiled();
+
+        std::cout << "Compiled list discarded with top-level block: "
+                  << ( pass ? "PASS" : "FAIL" ) << std::endl;
+        if( !pass )
+        {
+            num_failures++;
+        }
+        game_eng.set_compiled_render_list( false );
+    }
+
+    // Note: SDL is closed down when 'game_eng'
+    // goes out of scope
+    return num_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,311 @@
+///////////////////////////////////////////////
+//  --------------------------------------
+//  ---MUCKY VISION 3 ( BASIC ENGINE ) ---
+//  --------------------------------------
+//
+//  GameEngPixelDecoderBenchmark.cpp
+//
+//  Microbenchmark for GameEngPixelDecoder,
+//  comparing it with the bit-by-bit loop
+//  previously used by GameEng to expand
+//  packed pixel data into 32bit pixels
+//
+//  Both methods must give identical pixels,
+//  otherwise the benchmark fails
+//
+//  Copyright (c) Muckytaters 2023
+//
+//  This program is free software: you can
+//  redistribute it and/or modify it under
+//  the terms of the GNU General Public License
+//  as published by the Free Software Foundation,
+//  either version 3 of the License, or (at your
+//  option) any later version.
+//
+//  This program is distributed in the hope it
+//  will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY
+//  or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU
+//  General Public License along with this
+//  program. If not, see http://www.gnu.org/license
+////////////////////////////////////////////
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "GameEngPixelDecoder.h"
+
+///////////////////////////////////////////
+// BENCHMARK PARAMETERS
+// Made global for convenience,
+// as this is only a short benchmark.
+//
+const int NUM_COLORS = 32;
+const int NUM_REPEATS = 20;
+
+// Colo(u)r components, standing in
+// for GameEng's core palette
+std::vector<uint8_t> reds( NUM_COLORS );
+std::vector<uint8_t> greens( NUM_COLORS );
+std::vector<uint8_t> blues( NUM_COLORS );
+std::vector<uint8_t> alphas( NUM_COLORS );
+
+
+/////////////////////////////////////////////////////////
+// Utility function mimicking GameEng::get_RGBA
+void get_RGBA(
+    uint8_t col_id,
+    uint8_t &r,
+    uint8_t &g,
+    uint8_t &b,
+    uint8_t &a
+)
+{
+    if( col_id >= NUM_COLORS )
+    {
+        throw( std::runtime_error( "Invalid colo(u)r ID" ) );
+    }
+
+    r = reds[ col_id ];
+    g = greens[ col_id ];
+    b = blues[ col_id ];
+    a = alphas[ col_id ];
+}
+
+
+/////////////////////////////////////////////////////////
+// Previous method: bit-by-bit loop, looking up every
+// pixel's colo(u)r individually (as GameEng did before
+// GameEngPixelDecoder was introduced)
+void decode_bit_by_bit(
+    uint8_t bits_per_pixel,
+    const std::vector<uint8_t> &pixel_data,
+    const std::vector<uint8_t> &local_palette,
+    std::vector<uint32_t> &pixels
+)
+{
+    uint32_t* word_pos = pixels.data();
+    const uint32_t* const WORD_MAX = pixels.data() + pixels.size();
+    uint8_t bit_pos_within_byte = 0;
+    size_t data_pos_in_bytes = 0;
+    uint8_t current_byte = pixel_data[0];
+    const size_t NUM_PIXELS = pixel_data.size() * 8 / bits_per_pixel;
+    for( size_t pixel_pos = 0; pixel_pos < NUM_PIXELS; pixel_pos++ )
+    {
+        uint8_t palette_col_id = 0x00;
+        for( uint8_t i = 0; i < bits_per_pixel; i++ )
+        {
+            const uint8_t BIT_MASK = 0x01 << ( 7 - bit_pos_within_byte++ );
+            if( current_byte & BIT_MASK )
+            {
+                palette_col_id |= 0x01 << ( bits_per_pixel - i - 1 );
+            }
+            if( bit_pos_within_byte > 7
+                && pixel_pos < NUM_PIXELS - 1
+            )
+            {
+                bit_pos_within_byte = 0;
+                if( ++data_pos_in_bytes >= pixel_data.size() )
+                {
+                    throw( std::runtime_error( "Data pos exceeds pixel data" ) );
+                }
+                current_byte = pixel_data[ data_pos_in_bytes ];
+            }
+        }
+
+        if( palette_col_id >= local_palette.size() )
+        {
+            throw( std::runtime_error( "palette_col_id exceeds local_palette" ) );
+        }
+
+        uint8_t r, g, b, a;
+        try
+        {
+            get_RGBA( local_palette[ palette_col_id ], r, g, b, a );
+        }
+        catch( std::exception &e )
+        {
+            throw( std::runtime_error(
+                std::string( "Failed to decode colo(u)r ID, error = " )
+                + e.what() ) );
+        }
+
+        const uint32_t COL_32
+            = ( r << 16 ) | ( g << 8 ) | ( b << 0 ) | ( a << 24 );
+
+        if( word_pos < WORD_MAX )
+        {
+            *word_pos++ = COL_32;
+        }
+        else
+        {
+            throw( std::runtime_error( "word_pos exceeds WORD_MAX" ) );
+        }
+    }
+}
+
+
+/////////////////////////////////////////////////////////
+// New method: build lookup table, then use
+// GameEngPixelDecoder
+void decode_with_lut(
+    uint8_t bits_per_pixel,
+    const std::vector<uint8_t> &pixel_data,
+    const std::vector<uint8_t> &local_palette,
+    std::vector<uint32_t> &pixels
+)
+{
+    uint32_t lut[ MCK::GameEngPixelDecoder::MAX_LUT_SIZE ];
+    for( size_t i = 0; i < ( size_t( 0x01 ) << bits_per_pixel ); i++ )
+    {
+        uint8_t r, g, b, a;
+        get_RGBA( local_palette[ i ], r, g, b, a );
+        lut[ i ] = ( uint32_t( r ) << 16 )
+                   | ( uint32_t( g ) << 8 )
+                   | ( uint32_t( b ) << 0 )
+                   | ( uint32_t( a ) << 24 );
+    }
+
+    MCK::GameEngPixelDecoder::decode(
+        bits_per_pixel,
+        pixel_data.data(),
+        pixel_data.size() * 8 / bits_per_pixel,
+        lut,
+        pixels.data()
+    );
+}
+
+
+/////////////////////////////////////////////////////////
+// Utility function to time a decoding method over
+// a set of images, returning nanoseconds per pixel
+template<class DECODE>
+double time_decode(
+    DECODE decode,
+    uint8_t bits_per_pixel,
+    const std::vector< std::vector<uint8_t> > &images,
+    const std::vector<uint8_t> &local_palette,
+    std::vector< std::vector<uint32_t> > &results
+)
+{
+    size_t total_pixels = 0;
+    const auto START = std::chrono::steady_clock::now();
+    for( int repeat = 0; repeat < NUM_REPEATS; repeat++ )
+    {
+        for( size_t i = 0; i < images.size(); i++ )
+        {
+            decode( bits_per_pixel, images[ i ], local_palette, results[ i ] );
+            total_pixels += results[ i ].size();
+        }
+    }
+    const auto END = std::chrono::steady_clock::now();
+
+    return double(
+               std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   END - START
+               ).count()
+           ) / double( total_pixels );
+}
+
+
+/////////////////////////////////////////////////////////
+// TOP LEVEL ENTRY POINT OF THE BENCHMARK APPLICATION
+int main( void )
+{
+    // Use a fixed seed, so results are comparable
+    // between runs.
+    srand( 1 );
+    for( int i = 0; i < NUM_COLORS; i++ )
+    {
+        reds[ i ] = rand() % 256;
+        greens[ i ] = rand() % 256;
+        blues[ i ] = rand() % 256;
+        alphas[ i ] = rand() % 256;
+    }
+
+    // Typical sizes: 8x8 (e.g. ASCII characters)
+    // and 256x256 (e.g. backgrounds)
+    const std::vector<int> IMAGE_SIZES = { 8, 256 };
+    const std::vector<uint8_t> BIT_DEPTHS = { 1, 2, 3, 4, 8 };
+
+    std::cout << std::left << std::setw( 12 ) << "Image size"
+              << std::setw( 8 ) << "Bits"
+              << std::right << std::setw( 16 ) << "Old (ns/pixel)"
+              << std::setw( 16 ) << "New (ns/pixel)"
+              << std::setw( 10 ) << "Speed up"
+              << std::endl;
+
+    int num_failures = 0;
+    for( int size : IMAGE_SIZES )
+    {
+        // Enough images for roughly the same
+        // number of pixels at each size
+        const int NUM_IMAGES = 256 * 256 * 4 / ( size * size );
+
+        for( uint8_t bits_per_pixel : BIT_DEPTHS )
+        {
+            std::vector<uint8_t> local_palette( size_t( 0x01 ) << bits_per_pixel );
+            for( auto &col : local_palette )
+            {
+                col = rand() % NUM_COLORS;
+            }
+
+            std::vector< std::vector<uint8_t> > images( NUM_IMAGES );
+            for( auto &image : images )
+            {
+                image.resize( size * size * bits_per_pixel / 8 );
+                for( auto &byte : image )
+                {
+                    byte = rand() % 256;
+                }
+            }
+
+            std::vector< std::vector<uint32_t> > old_results(
+                NUM_IMAGES,
+                std::vector<uint32_t>( size * size )
+            );
+            std::vector< std::vector<uint32_t> > new_results = old_results;
+
+            const double OLD_NS = time_decode(
+                decode_bit_by_bit,
+                bits_per_pixel,
+                images,
+                local_palette,
+                old_results
+            );
+            const double NEW_NS = time_decode(
+                decode_with_lut,
+                bits_per_pixel,
+                images,
+                local_palette,
+                new_results
+            );
+
+            std::cout << std::left << std::setw( 12 )
+                      << ( std::to_string( size ) + "x" + std::to_string( size ) )
+                      << std::setw( 8 ) << int( bits_per_pixel )
+                      << std::right << std::fixed << std::setprecision( 2 )
+                      << std::setw( 16 ) << OLD_NS
+                      << std::setw( 16 ) << NEW_NS
+                      << std::setw( 9 ) << ( NEW_NS > 0.0 ? OLD_NS / NEW_NS : 0.0 )
+                      << "x";
+
+            if( old_results != new_results )
+            {
+                std::cout << "  FAIL (pixels differ)";
+                num_failures++;
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    return num_failures == 0 ? 0 : 1;
+}
@@ -54,8 +54,9 @@ const int LOGO_Y = WINDOW_HEIGHT_IN_PIXELS / 2 - 4 * LOGO_SCALE;
 
 /////////////////////////////////////////////////////////
 // Utility function to set circle position and size
+// (new 'z' value is added to 'z_changes')
 void set_circle_pos(
-    MCK::GameEng &game_eng,
+    std::vector<MCK::GameEng::ZChange> &z_changes,
     std::shared_ptr<MCK::GameEngRenderInfo> circle,
     float angle,
     float rad_scale = 1.0f
@@ -93,21 +94,12 @@ void set_circle_pos(
     circle->dest_rect.set_w( int( CIRCLE_DIAMETER + 0.5f ) );
     circle->dest_rect.set_h( int( CIRCLE_DIAMETER + 0.5f ) );
 
-    // Change 'z' value
-    try
-    {
-        MCK::GameEng::change_z_rel_to_default(
-            circle,
-            game_eng.get_prime_render_block(),
-            int32_t( Z + 0.5f )
-        );
-    }
-    catch( std::exception &e )
-    {
-        throw( std::runtime_error(
-            std::string( "Failed to change z, error: ")
-            + e.what() ) );
-    }
+    // Record new 'z' value, to be applied to
+    // all circles at once
+    MCK::GameEng::ZChange z_change;
+    z_change.instance = circle;
+    z_change.new_z = MCK::DEFAULT_Z_VALUE + int32_t( Z + 0.5f );
+    z_changes.push_back( z_change );
 }
 
 
@@ -420,6 +412,11 @@ int main( int argc, char** argv )
     std::vector<std::shared_ptr<MCK::GameEngRenderInfo>> inner_circles;
     outer_circles.reserve( NUM_CIRCLES );
     inner_circles.reserve( NUM_CIRCLES );
+
+    // New 'z' values of all circles, updated every frame
+    std::vector<MCK::GameEng::ZChange> z_changes;
+    z_changes.reserve( NUM_CIRCLES * 2 );
+
     for( int i = 0; i < NUM_CIRCLES; i++ )
     {
         // Cycle through circle textures
@@ -590,6 +587,8 @@ int main( int argc, char** argv )
                                     / ANG_VEL_IN_REV_PER_SEC
                                         * MCK_TWO_PI;
 
+        z_changes.clear();
+
         // Outer circles
         {
             size_t count = 0;
@@ -599,7 +598,7 @@ int main( int argc, char** argv )
                 try
                 {
                     set_circle_pos(
-                        game_eng,
+                        z_changes,
                         circ, 
                         PRIME_ANGLE 
                             + ANG_DIFF_IN_REVS
@@ -625,7 +624,7 @@ int main( int argc, char** argv )
                 try
                 {
                     set_circle_pos(
-                        game_eng,
+                        z_changes,
                         circ, 
                         - PRIME_ANGLE  // Note inversion of angle
                             - ANG_DIFF_IN_REVS
@@ -643,6 +642,21 @@ int main( int argc, char** argv )
             }
         }
 
+        // Change 'z' of all circles at once
+        try
+        {
+            MCK::GameEng::change_z_bulk(
+                game_eng.get_prime_render_block(),
+                z_changes
+            );
+        }
+        catch( std::exception &e )
+        {
+            throw( std::runtime_error(
+                std::string( "Failed to change z, error: ")
+                + e.what() ) );
+        }
+
         // Clear, render and present
         {
             try
@@ -30,6 +30,53 @@
 #include "GameEng.h"
 #include "ImageMan.h"
 
+// Loading bar, shown while textures are prewarmed
+struct LoadingBar
+{
+    MCK::GameEng* game_eng;
+    std::shared_ptr<MCK::GameEngRenderInfo> bar;
+    int max_width;
+};
+
+// Progress callback for ImageMan::prewarm
+void show_loading_bar(
+    size_t num_done,
+    size_t num_total,
+    void* user_data
+)
+{
+    LoadingBar* const LOADING_BAR = static_cast<LoadingBar*>( user_data );
+    const int WIDTH
+        = num_total > 0
+            ? int( num_done * LOADING_BAR->max_width / num_total )
+            : LOADING_BAR->max_width;
+
+    // Only render when bar has grown, as 'show'
+    // may wait for the display to refresh
+    if( WIDTH == LOADING_BAR->bar->dest_rect.get_w() )
+    {
+        return;
+    }
+    LOADING_BAR->bar->dest_rect.set_w( WIDTH );
+
+    try
+    {
+        LOADING_BAR->game_eng->clear();
+        LOADING_BAR->game_eng->render_all(
+            LOADING_BAR->game_eng->get_prime_render_block(),
+            0,  // Hoz offset
+            0  // Vert offset
+        );
+        LOADING_BAR->game_eng->show();
+    }
+    catch( std::exception &e )
+    {
+        throw( std::runtime_error(
+            std::string( "Loading bar render failed, error: ")
+            + e.what() ) );
+    }
+}
+
 // Calculate vertical pos of text
 int calc_vert_offset(
     uint32_t ticks,
@@ -238,6 +285,74 @@ int main( int argc, char** argv )
     }
 
 
+    ///////////////////////////////////////////
+    // CHECK DUPLICATE PALETTE DETECTION
+    // Palettes sharing only their first colo(u)r must
+    // get different IDs, identical palettes the same ID
+    {
+        std::vector<MCK_PAL_ID_TYPE> batch_palette_ids;
+        MCK_PAL_ID_TYPE duplicate_palette_id;
+        try
+        {
+            duplicate_palette_id = image_man.create_local_palette(
+                std::make_shared<std::vector<uint8_t>>(
+                    std::vector<uint8_t>{
+                        MCK::COL_BLACK,
+                        MCK::COL_YELLOW
+                    }
+                )
+            );
+            batch_palette_ids = image_man.create_local_palettes(
+                std::vector<std::shared_ptr<std::vector<uint8_t>>>{
+                    std::make_shared<std::vector<uint8_t>>(
+                        std::vector<uint8_t>{
+                            MCK::COL_BLACK,
+                            MCK::COL_RED
+                        }
+                    ),
+                    std::make_shared<std::vector<uint8_t>>(
+                        std::vector<uint8_t>{
+                            MCK::COL_BLACK,
+                            MCK::COL_BLUE
+                        }
+                    ),
+                    std::make_shared<std::vector<uint8_t>>(
+                        std::vector<uint8_t>{
+                            MCK::COL_BLACK,
+                            MCK::COL_BLUE
+                        }
+                    )
+                }
+            );
+        }
+        catch( std::exception &e )
+        {
+            throw( std::runtime_error(
+                std::string( "Failed to create duplicate palettes, error: ")
+                + e.what() ) );
+        }
+
+        const bool PASS
+            = black_yellow_palette_id != black_red_palette_id
+              && black_yellow_palette_id != black_green_palette_id
+              && black_red_palette_id != black_green_palette_id
+              && duplicate_palette_id == black_yellow_palette_id
+              && batch_palette_ids.size() == 3
+              && batch_palette_ids[ 0 ] == black_red_palette_id
+              && batch_palette_ids[ 1 ] != black_yellow_palette_id
+              && batch_palette_ids[ 1 ] != black_red_palette_id
+              && batch_palette_ids[ 1 ] != black_green_palette_id
+              && batch_palette_ids[ 2 ] == batch_palette_ids[ 1 ];
+        std::cout << "Duplicate palette detection: "
+                  << ( PASS ? "PASS" : "FAIL" ) << std::endl;
+        if( !PASS )
+        {
+            throw( std::runtime_error(
+                "Duplicate palette detection failed." ) );
+        }
+    }
+
+
 
     ///////////////////////////////////////////
     // CREATE ALTERNATIVE ASCII SET
@@ -278,6 +393,150 @@ int main( int argc, char** argv )
     }
     
 
+    ///////////////////////////////////////////
+    // PREWARM TEXTURES
+    // Images are decoded by worker threads, while
+    // a loading bar shows progress
+
+    // Palette used for each row of ASCII chars
+    const std::vector<MCK_PAL_ID_TYPE> ROW_PALETTE_IDS =
+    {
+        black_yellow_palette_id,
+        black_red_palette_id,
+        black_green_palette_id,
+        black_red_palette_id
+    };
+
+    {
+        std::vector<MCK::ImageMan::ImagePalettePair> images_and_palettes;
+        for( int row = 0; row < NUM_ROWS; row++ )
+        {
+            for( int c = 0; c < NUM_COLS; c++ )
+            {
+                images_and_palettes.push_back(
+                    MCK::ImageMan::ImagePalettePair(
+                        image_man.get_ascii_image_id(
+                            row * 32 + c,
+                            alt_ascii_set_id
+                        ),
+                        ROW_PALETTE_IDS[ row % 4 ]
+                    )
+                );
+            }
+        }
+
+        LoadingBar loading_bar;
+        loading_bar.game_eng = &game_eng;
+        loading_bar.max_width = WINDOW_WIDTH_IN_PIXELS / 2;
+        try
+        {
+            loading_bar.bar = game_eng.create_blank_tex_render_info(
+                MCK::COL_WHITE,
+                game_eng.get_prime_render_block(),
+                MCK::GameEngRenderInfo::Rect(
+                    WINDOW_WIDTH_IN_PIXELS / 4,
+                    WINDOW_HEIGHT_IN_PIXELS / 2 - 4,
+                    0,  // Width set by 'show_loading_bar'
+                    8
+                )
+            );
+        }
+        catch( std::exception &e )
+        {
+            throw( std::runtime_error(
+                std::string( "Failed to create loading bar, error: ")
+                + e.what() ) );
+        }
+
+        const uint32_t PREWARM_START_TICKS = game_eng.get_ticks();
+        try
+        {
+            image_man.prewarm(
+                images_and_palettes,
+                show_loading_bar,
+                &loading_bar
+            );
+        }
+        catch( std::exception &e )
+        {
+            throw( std::runtime_error(
+                std::string( "Failed to prewarm textures, error: ")
+                + e.what() ) );
+        }
+        std::cout << "Prewarmed " << images_and_palettes.size()
+                  << " textures in "
+                  << game_eng.get_ticks() - PREWARM_START_TICKS
+                  << " ms" << std::endl;
+
+        MCK::GameEng::remove_render_instance(
+            loading_bar.bar,
+            game_eng.get_prime_render_block()
+        );
+    }
+
+
+    ///////////////////////////////////////////
+    // CHECK PREWARM FAILURE
+    // An image using a colo(u)r missing from its local
+    // palette decodes to the expected height, but must
+    // still fail (even with no error message, as when
+    // MCK_STD_OUT is not defined)
+    {
+        MCK_IMG_ID_TYPE bad_image_id;
+        MCK_PAL_ID_TYPE short_palette_id;
+        try
+        {
+            bad_image_id = image_man.create_custom_image(
+                std::make_shared<const std::vector<uint8_t>>(
+                    16,  // 8x8 pixels at 2 bits per pixel
+                    0xFF  // Every pixel uses colo(u)r 3
+                ),
+                2,  // bits_per_pixel,
+                8,  // width_in_pixels,
+                8  // height_in_pixels
+            );
+            short_palette_id = image_man.create_local_palette(
+                std::make_shared<std::vector<uint8_t>>(
+                    std::vector<uint8_t>{
+                        MCK::COL_BLACK,
+                        MCK::COL_WHITE
+                    }
+                )
+            );
+        }
+        catch( std::exception &e )
+        {
+            throw( std::runtime_error(
+                std::string( "Failed to create bad image, error: ")
+                + e.what() ) );
+        }
+
+        bool failed = false;
+        try
+        {
+            image_man.prewarm(
+                std::vector<MCK::ImageMan::ImagePalettePair>{
+                    MCK::ImageMan::ImagePalettePair(
+                        bad_image_id,
+                        short_palette_id
+                    )
+                }
+            );
+        }
+        catch( std::exception &e )
+        {
+            failed = true;
+        }
+        std::cout << "Prewarm decode failure detected: "
+                  << ( failed ? "PASS" : "FAIL" ) << std::endl;
+        if( !failed )
+        {
+            throw( std::runtime_error(
+                "Prewarm decode failure not detected." ) );
+        }
+    }
+
+
     ///////////////////////////////////////////
     // CREATE RENDER INFO
 
@@ -301,25 +560,7 @@ int main( int argc, char** argv )
             const int X_POS = 36 + 18 * c;
             const int Y_POS = 20 + row * VERT_RANGE * 8;
 
-            MCK_PAL_ID_TYPE palette_id;
-            switch( row % 4 )
-            {
-                case 0:
-                    palette_id = black_yellow_palette_id;
-                    break;
-
-                case 1:
-                    palette_id = black_red_palette_id;
-                    break;
-
-                case 2:
-                    palette_id = black_green_palette_id;
-                    break;
-
-                case 3:
-                    palette_id = black_red_palette_id;
-                    break;
-            }
+            const MCK_PAL_ID_TYPE palette_id = ROW_PALETTE_IDS[ row % 4 ];
 
             // Create image
             try
@@ -345,6 +586,84 @@ int main( int argc, char** argv )
     }
 
 
+    ///////////////////////////////////////////
+    // CREATE PALETTE-INDEXED TEXT
+    // Each character's texture is created once,
+    // however many palettes are used with it,
+    // so the text can flash without creating
+    // new textures
+    const std::string FLASH_TEXT = "PALETTE SWAP";
+    std::vector<std::shared_ptr<MCK::GameEngRenderBlock>> flash_blocks;
+    for( size_t i = 0; i < FLASH_TEXT.size(); i++ )
+    {
+        try
+        {
+            flash_blocks.push_back(
+                image_man.create_indexed_render_block(
+                    image_man.get_ascii_image_id( FLASH_TEXT[ i ] ),
+                    black_yellow_palette_id,
+                    36 + 18 * i,
+                    WINDOW_HEIGHT_IN_PIXELS - TEXT_HEIGHT - 8,
+                    TEXT_WIDTH,
+                    TEXT_HEIGHT,
+                    logo_block
+                )
+            );
+        }
+        catch( std::exception &e )
+        {
+            throw( std::runtime_error(
+                std::string( "Failed to create palette-indexed text, error: ")
+                + e.what() ) );
+        }
+    }
+
+
+    ///////////////////////////////////////////
+    // CREATE PALETTE-CYCLING TEXT
+    // Foreground colo(u)r cycles through red,
+    // yellow and green, updating one texture
+    // per character in place
+    const std::string CYCLE_TEXT = "PALETTE CYCLE";
+    try
+    {
+        const MCK_PAL_ID_TYPE CYCLING_PALETTE_ID
+            = image_man.create_cycling_palette(
+                std::vector<uint8_t>{
+                    MCK::COL_BLACK,
+                    MCK::COL_RED,
+                    MCK::COL_YELLOW,
+                    MCK::COL_GREEN
+                }
+            );
+        image_man.add_palette_cycle(
+            CYCLING_PALETTE_ID,
+            1,  // First index
+            3,  // Number of indices
+            200  // Ticks per step
+        );
+
+        for( size_t i = 0; i < CYCLE_TEXT.size(); i++ )
+        {
+            image_man.create_render_info(
+                image_man.get_ascii_image_id( CYCLE_TEXT[ i ] ),
+                CYCLING_PALETTE_ID,
+                WINDOW_WIDTH_IN_PIXELS - 36 - 18 * ( CYCLE_TEXT.size() - i ),
+                WINDOW_HEIGHT_IN_PIXELS - TEXT_HEIGHT - 8,
+                TEXT_WIDTH,
+                TEXT_HEIGHT,
+                logo_block
+            );
+        }
+    }
+    catch( std::exception &e )
+    {
+        throw( std::runtime_error(
+            std::string( "Failed to create palette-cycling text, error: ")
+            + e.what() ) );
+    }
+
+
     /////////////////////////////////////////////
     // MAIN LOOP STARTS HERE
     /////////////////////////////////////////////
@@ -422,6 +741,30 @@ int main( int argc, char** argv )
                 );
         }
 
+        // Flash palette-indexed text, swapping
+        // palette of each character in turn
+        for( size_t i = 0; i < flash_blocks.size(); i++ )
+        {
+            image_man.change_indexed_render_block_palette(
+                flash_blocks[ i ],
+                ( current_ticks / 50 + flash_blocks.size() - i ) % 10 < 5
+                    ? black_yellow_palette_id
+                    : black_green_palette_id
+            );
+        }
+
+        // Advance palette cycles
+        try
+        {
+            image_man.update_palette_cycles( current_ticks );
+        }
+        catch( std::exception &e )
+        {
+            throw( std::runtime_error(
+                std::string( "Failed to update palette cycles, error: ")
+                + e.what() ) );
+        }
+
         ///////////////////////////////////////////
         // Clear, render and present
         {
@@ -1030,6 +1030,8 @@ int main( int argc, char** argv )
     uint32_t end_ticks = START_TICKS + 250000;
     uint32_t ticks_at_last_animation = START_TICKS;
     uint32_t next_beep_ticks = START_TICKS + BEEP_INTERVAL;
+    const uint32_t WARM_UP_FRAMES = 1000;
+    size_t slabs_after_warm_up = 0;
     do
     {
         ////////////////////////////////////////
@@ -1053,6 +1055,14 @@ int main( int argc, char** argv )
             frame_num++;
         }
 
+        // Record pool usage once scene is established, so
+        // that steady state heap allocations can be checked
+        if( frame_num == WARM_UP_FRAMES )
+        {
+            slabs_after_warm_up
+                = MCK::GameEngPoolStats::get_num_slab_allocations();
+        }
+
         ////////////////////////////////////////
         // BEEP
         if( CURRENT_TICKS > next_beep_ticks )
@@ -1537,4 +1547,26 @@ int main( int argc, char** argv )
         }
     }
     while( game_eng.get_ticks() < end_ticks );
+
+    // Check heap allocations made by render instance
+    // pools after warm up (must be zero, as bullets and
+    // aliens re-use the memory of those destroyed)
+    if( frame_num > WARM_UP_FRAMES )
+    {
+        const size_t NUM_SLABS
+            = MCK::GameEngPoolStats::get_num_slab_allocations()
+                  - slabs_after_warm_up;
+        std::cout << "Render instance pool slabs allocated after "
+                  << WARM_UP_FRAMES << " frames: "
+                  << NUM_SLABS
+                  << " (over " << frame_num - WARM_UP_FRAMES
+                  << " frames): "
+                  << ( NUM_SLABS == 0 ? "PASS" : "FAIL" ) << std::endl;
+        if( NUM_SLABS > 0 )
+        {
+            return 1;
+        }
+    }
+
+    return 0;
 }
@@ -0,0 +1,492 @@
+///////////////////////////////////////////////
+//  --------------------------------------
+//  ---MUCKY VISION 3 ( BASIC ENGINE ) ---
+//  --------------------------------------
+//
+//  SpriteAnimBenchmark.cpp
+//
+//  Benchmark of sprite animation, timing
+//  Sprite::process for 10,000 sprites that
+//  each change frame (i.e. texture) on every
+//  frame, with a few thousand textures in
+//  existence
+//
+//  With '--threaded', sprites are processed on
+//  a separate thread, which hands each frame
+//  to the main thread for rendering via
+//  GameEng::publish_render_snapshot
+//
+//  Usage: SpriteAnimBenchmark [--headless] [--threaded]
+//
+//  Copyright (c) Muckytaters 2023
+//
+//  This program is free software: you can
+//  redistribute it and/or modify it under
+//  the terms of the GNU General Public License
+//  as published by the Free Software Foundation,
+//  either version 3 of the License, or (at your
+//  option) any later version.
+//
+//  This program is distributed in the hope it
+//  will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY
+//  or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU
+//  General Public License along with this
+//  program. If not, see http://www.gnu.org/license
+////////////////////////////////////////////
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include "GameEng.h"
+#include "ImageMan.h"
+#include "SpriteMotionConstVel.h"
+#include "SpriteAnimTime.h"
+#include "SpriteCollisionRect.h"
+#include "SpriteFrame.h"
+#include "Sprite.h"
+
+///////////////////////////////////////////
+// BENCHMARK PARAMETERS
+// Made global for convenience,
+// as this is only a short benchmark.
+//
+const int WINDOW_WIDTH_IN_PIXELS = 640;
+const int WINDOW_HEIGHT_IN_PIXELS = 480;
+const int NUM_SPRITES = 10000;
+const int NUM_ANIM_FRAMES = 8;
+const int NUM_PALETTES = 256;  // Textures = frames x palettes
+const int NUM_FRAMES = 120;
+const int FRAME_DURATION_IN_TICKS = 10;
+const int SPRITE_SIZE_IN_PIXELS = 8;
+
+typedef MCK::Sprite<
+    MCK::SpriteMotionConstVel,
+    MCK::SpriteAnimTime,
+    MCK::SpriteCollisionRect
+> AnimSprite;
+
+// Data shared with simulation thread
+struct SimulationData
+{
+    MCK::GameEng* game_eng;
+    std::vector<std::shared_ptr<AnimSprite>>* sprites;
+    uint64_t process_counts;
+    SDL_sem* frame_published;  // Posted by simulation thread
+    SDL_sem* frame_taken;  // Posted by main thread
+    SDL_atomic_t failed;
+};
+
+
+/////////////////////////////////////////////////////////
+// Simulation thread (threaded mode only): processes
+// sprites and publishes a render snapshot of each frame
+// Note: So that every frame is rendered (and the timing
+//       is comparable with single threaded mode), each
+//       frame is only processed once the previous frame
+//       has been taken for rendering. A game would instead
+//       pace itself by ticks, letting frames be repeated
+//       or skipped.
+int simulate( void* data )
+{
+    SimulationData* const SIM = static_cast<SimulationData*>( data );
+    uint32_t ticks = 0;
+    for( int frame = 0; frame <= NUM_FRAMES; frame++ )
+    {
+        // Wait for previous frame to be taken for rendering
+        if( frame > 0 )
+        {
+            SDL_SemWait( SIM->frame_taken );
+            if( SDL_AtomicGet( &SIM->failed ) )
+            {
+                break;
+            }
+        }
+
+        try
+        {
+            ticks += FRAME_DURATION_IN_TICKS;
+            MCK::SpritePos::set_ticks( ticks );
+
+            const uint64_t START_COUNT = SDL_GetPerformanceCounter();
+            for( auto &sprite : *SIM->sprites )
+            {
+                sprite->process();
+            }
+            const uint64_t PROCESSED_COUNT = SDL_GetPerformanceCounter();
+
+            SIM->game_eng->publish_render_snapshot(
+                SIM->game_eng->get_prime_render_block(),
+                0,
+                0
+            );
+
+            // Ignore first frame, as it does
+            // not change every sprite's frame
+            if( frame > 0 )
+            {
+                SIM->process_counts += PROCESSED_COUNT - START_COUNT;
+            }
+        }
+        catch( std::exception &e )
+        {
+            std::cout << "Simulation failed, error: "
+                      << e.what() << std::endl;
+            SDL_AtomicSet( &SIM->failed, 1 );
+            SDL_SemPost( SIM->frame_published );
+            break;
+        }
+        SDL_SemPost( SIM->frame_published );
+    }
+
+    return 0;
+}
+
+
+/////////////////////////////////////////////////////////
+// TOP LEVEL ENTRY POINT OF THE BENCHMARK APPLICATION
+int main( int argc, char** argv )
+{
+    bool headless = false;
+    bool threaded = false;
+    for( int i = 1; i < argc; i++ )
+    {
+        headless |= std::string( argv[ i ] ) == "--headless";
+        threaded |= std::string( argv[ i ] ) == "--threaded";
+    }
+
+    //////////////////////////////////////////////
+    // INITIALIZE SDL, CREATE WINDOW & RENDERER
+    MCK::GameEng &game_eng = MCK::GameEng::get_singleton();
+    try
+    {
+        if( headless )
+        {
+            game_eng.init_headless(
+                WINDOW_WIDTH_IN_PIXELS,
+                WINDOW_HEIGHT_IN_PIXELS
+            );
+        }
+        else
+        {
+            game_eng.init(
+                "SpriteAnimBenchmark",  // Window name
+                0,  // Window x pos
+                0,  // Window y pos
+                WINDOW_WIDTH_IN_PIXELS,
+                WINDOW_HEIGHT_IN_PIXELS
+            );
+        }
+    }
+    catch( std::exception &e )
+    {
+        throw( std::runtime_error(
+            std::string( "Failed to initialize SDL, error: ")
+            + e.what() ) );
+    }
+
+    game_eng.set_clearing_color( MCK::COL_BLACK );
+
+    MCK::ImageMan &image_man = MCK::ImageMan::get_singleton();
+    try
+    {
+        image_man.init( game_eng );
+    }
+    catch( std::exception &e )
+    {
+        throw( std::runtime_error(
+            std::string( "Failed to initialize image manager, error: ")
+            + e.what() ) );
+    }
+
+
+    //////////////////////////////////////////////
+    // CREATE IMAGES, PALETTES AND TEXTURES
+    // Use a fixed seed, so results are comparable
+    // between runs.
+    srand( 1 );
+    std::vector<MCK_IMG_ID_TYPE> image_ids;
+    std::vector<MCK_PAL_ID_TYPE> palette_ids;
+    std::vector<MCK::ImageMan::ImagePalettePair> textures;
+    try
+    {
+        for( int i = 0; i < NUM_ANIM_FRAMES; i++ )
+        {
+            std::shared_ptr<std::vector<uint8_t>> pixel_data
+                = std::make_shared<std::vector<uint8_t>>(
+                    SPRITE_SIZE_IN_PIXELS * SPRITE_SIZE_IN_PIXELS / 4
+                );
+            for( auto &byte : *pixel_data )
+            {
+                byte = rand() % 256;
+            }
+            image_ids.push_back(
+                image_man.create_custom_image(
+                    pixel_data,
+                    2,  // Bits per pixel
+                    SPRITE_SIZE_IN_PIXELS,
+                    SPRITE_SIZE_IN_PIXELS
+                )
+            );
+        }
+
+        // Each palette is a different pair of colo(u)rs,
+        // so none are merged as duplicates
+        for( int i = 0; i < NUM_PALETTES; i++ )
+        {
+            palette_ids.push_back(
+                image_man.create_local_palette(
+                    std::make_shared<std::vector<uint8_t>>(
+                        std::vector<uint8_t>(
+                            {
+                                MCK::COL_TRANSPARENT,
+                                uint8_t( 16 + i % 16 ),
+                                uint8_t( 16 + i / 16 ),
+                                MCK::COL_WHITE
+                            }
+                        )
+                    )
+                )
+            );
+        }
+
+        for( MCK_IMG_ID_TYPE image_id : image_ids )
+        {
+            for( MCK_PAL_ID_TYPE palette_id : palette_ids )
+            {
+                textures.push_back(
+                    MCK::ImageMan::ImagePalettePair( image_id, palette_id )
+                );
+            }
+        }
+        image_man.prewarm( textures );
+    }
+    catch( std::exception &e )
+    {
+        throw( std::runtime_error(
+            std::string( "Failed to create textures, error: ")
+            + e.what() ) );
+    }
+
+
+    //////////////////////////////////////////////
+    // CREATE SPRITES
+    // Each sprite cycles through every frame,
+    // using a randomly chosen palette
+    MCK::SpritePos::set_ptrs( &game_eng, &image_man );
+    MCK::SpritePos::set_ticks( 0, true );
+    std::shared_ptr<MCK::GameEngRenderBlock> sprite_block;
+    std::vector<std::shared_ptr<AnimSprite>> sprites;
+    sprites.reserve( NUM_SPRITES );
+    try
+    {
+        sprite_block = game_eng.create_empty_render_block(
+            game_eng.get_prime_render_block()
+        );
+
+        for( int i = 0; i < NUM_SPRITES; i++ )
+        {
+            const MCK_PAL_ID_TYPE PALETTE_ID
+                = palette_ids[ rand() % NUM_PALETTES ];
+
+            sprites.push_back( std::make_shared<AnimSprite>() );
+            sprites.back()->init(
+                sprite_block,
+                image_ids[ 0 ],
+                PALETTE_ID,
+                rand() % ( WINDOW_WIDTH_IN_PIXELS - SPRITE_SIZE_IN_PIXELS ),
+                rand() % ( WINDOW_HEIGHT_IN_PIXELS - SPRITE_SIZE_IN_PIXELS ),
+                MCK::DEFAULT_Z_VALUE,
+                SPRITE_SIZE_IN_PIXELS,
+                SPRITE_SIZE_IN_PIXELS
+            );
+
+            std::vector<MCK::SpriteFrame> frames;
+            for( MCK_IMG_ID_TYPE image_id : image_ids )
+            {
+                frames.push_back(
+                    MCK::SpriteFrame(
+                        FRAME_DURATION_IN_TICKS,
+                        image_id,
+                        PALETTE_ID
+                    )
+                );
+            }
+            sprites.back()->set_frames( frames, rand() % NUM_ANIM_FRAMES );
+        }
+    }
+    catch( std::exception &e )
+    {
+        throw( std::runtime_error(
+            std::string( "Failed to create sprites, error: ")
+            + e.what() ) );
+    }
+
+
+    //////////////////////////////////////////////
+    // TIME ANIMATION AND RENDERING
+    // Ticks advance by one frame duration per frame,
+    // so (after the first frame) every sprite changes
+    // texture every frame. Only 'process' and
+    // 'render_all' are timed, so that vsync (in 'show')
+    // does not affect the result.
+    // In threaded mode, 'render_snapshot' is timed
+    // in place of 'render_all'.
+    uint64_t process_counts = 0;
+    uint64_t render_counts = 0;
+    int num_frames_rendered = 0;
+    const uint64_t BEGIN_COUNT = SDL_GetPerformanceCounter();
+    if( threaded )
+    {
+        SimulationData sim;
+        sim.game_eng = &game_eng;
+        sim.sprites = &sprites;
+        sim.process_counts = 0;
+        sim.frame_published = SDL_CreateSemaphore( 0 );
+        sim.frame_taken = SDL_CreateSemaphore( 0 );
+        SDL_AtomicSet( &sim.failed, 0 );
+
+        SDL_Thread* const THREAD = SDL_CreateThread(
+            simulate,
+            "SpriteAnimBenchmark simulation",
+            &sim
+        );
+        if( THREAD == NULL )
+        {
+            throw( std::runtime_error(
+                std::string( "Failed to create thread, error: ")
+                + SDL_GetError() ) );
+        }
+
+        for( int frame = 0; frame <= NUM_FRAMES; frame++ )
+        {
+            // Wait for frame to be published
+            SDL_SemWait( sim.frame_published );
+            if( SDL_AtomicGet( &sim.failed ) )
+            {
+                break;
+            }
+
+            try
+            {
+                game_eng.clear();
+                const uint64_t START_COUNT = SDL_GetPerformanceCounter();
+                game_eng.render_snapshot();
+                const uint64_t RENDERED_COUNT = SDL_GetPerformanceCounter();
+                SDL_SemPost( sim.frame_taken );
+
+                game_eng.show();
+
+                // Ignore first frame, as in single threaded mode
+                if( frame > 0 )
+                {
+                    render_counts += RENDERED_COUNT - START_COUNT;
+                    num_frames_rendered++;
+                }
+            }
+            catch( std::exception &e )
+            {
+                SDL_AtomicSet( &sim.failed, 1 );
+                SDL_SemPost( sim.frame_taken );
+                SDL_WaitThread( THREAD, NULL );
+                throw( std::runtime_error(
+                    std::string( "Render sequence failed, error: ")
+                    + e.what() ) );
+            }
+        }
+
+        SDL_WaitThread( THREAD, NULL );
+        SDL_DestroySemaphore( sim.frame_published );
+        SDL_DestroySemaphore( sim.frame_taken );
+        if( SDL_AtomicGet( &sim.failed ) )
+        {
+            return 1;
+        }
+        process_counts = sim.process_counts;
+    }
+    else
+    {
+        uint32_t ticks = 0;
+        for( int frame = 0; frame <= NUM_FRAMES; frame++ )
+        {
+            try
+            {
+                ticks += FRAME_DURATION_IN_TICKS;
+                MCK::SpritePos::set_ticks( ticks );
+
+                const uint64_t START_COUNT = SDL_GetPerformanceCounter();
+                for( auto &sprite : sprites )
+                {
+                    sprite->process();
+                }
+                const uint64_t PROCESSED_COUNT = SDL_GetPerformanceCounter();
+
+                game_eng.clear();
+                game_eng.render_all( game_eng.get_prime_render_block(), 0, 0 );
+                const uint64_t RENDERED_COUNT = SDL_GetPerformanceCounter();
+
+                game_eng.show();
+
+                // Ignore first frame, as it does
+                // not change every sprite's frame
+                if( frame > 0 )
+                {
+                    process_counts += PROCESSED_COUNT - START_COUNT;
+                    render_counts += RENDERED_COUNT - PROCESSED_COUNT;
+                    num_frames_rendered++;
+                }
+            }
+            catch( std::exception &e )
+            {
+                throw( std::runtime_error(
+                    std::string( "Animation sequence failed, error: ")
+                    + e.what() ) );
+            }
+        }
+    }
+    const uint64_t TOTAL_COUNT = SDL_GetPerformanceCounter() - BEGIN_COUNT;
+
+    const double PROCESS_US
+        = double( process_counts ) * 1000000.0
+            / double( SDL_GetPerformanceFrequency() )
+                / double( NUM_FRAMES );
+    const double RENDER_US
+        = num_frames_rendered > 0
+            ? double( render_counts ) * 1000000.0
+                / double( SDL_GetPerformanceFrequency() )
+                    / double( num_frames_rendered )
+            : 0.0;
+    const double TOTAL_US
+        = double( TOTAL_COUNT ) * 1000000.0
+            / double( SDL_GetPerformanceFrequency() )
+                / double( NUM_FRAMES + 1 );
+
+    std::cout << NUM_SPRITES << " sprites, "
+              << textures.size() << " textures" << std::endl;
+    std::cout << std::left << std::setw( 24 ) << "Sprite::process"
+              << std::right << std::fixed << std::setprecision( 1 )
+              << std::setw( 10 ) << PROCESS_US << " us/frame"
+              << std::setw( 10 )
+              << PROCESS_US * 1000.0 / double( NUM_SPRITES )
+              << " ns/frame change" << std::endl;
+    std::cout << std::left << std::setw( 24 )
+              << ( threaded ? "GameEng::render_snapshot" : "GameEng::render_all" )
+              << std::right << std::fixed << std::setprecision( 1 )
+              << std::setw( 10 ) << RENDER_US << " us/frame"
+              << std::setw( 10 )
+              << RENDER_US * 1000.0 / double( NUM_SPRITES )
+              << " ns/sprite" << std::endl;
+    std::cout << std::left << std::setw( 24 ) << "Total (inc. show)"
+              << std::right << std::fixed << std::setprecision( 1 )
+              << std::setw( 10 ) << TOTAL_US << " us/frame"
+              << std::setw( 10 ) << num_frames_rendered
+              << " frames rendered" << std::endl;
+
+    // Note: SDL is closed down when 'game_eng'
+    // goes out of scope
+    return 0;
+}